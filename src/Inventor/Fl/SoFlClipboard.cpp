@@ -30,4 +30,444 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
 
-#include "SoFlClipboard.h"
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlClipboard.h"
+#include "Inventor/Fl/SoFlInternal.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/SoOutput.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/actions/SoWriteAction.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/lists/SoNodeList.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Widget.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+
+// Base64 coding of a copy or a paste, running on a worker thread. The
+// worker only ever touches the text; Coin is only used in the main
+// thread, from the Fl::awake() callback or the clipboard's destructor,
+// which both join the thread.
+struct SoFlClipboard::Job {
+    unsigned long id{0};
+    std::thread thread;
+    std::string text;
+    bool paste{false};
+    unsigned long serial{0}; // the copy being published
+    std::vector<SoFlClipboard::Request> requests; // pastes waiting
+};
+
+// Receives FL_PASTE for the clipboard; it is never shown.
+class SoFlClipboardReceiver : public Fl_Widget {
+public:
+    explicit SoFlClipboardReceiver(SoFlClipboard * owner)
+        : Fl_Widget(0, 0, 0, 0), owner(owner)
+    {
+    }
+
+    int handle(int event) override
+    {
+        if (event != FL_PASTE) return Fl_Widget::handle(event);
+        this->owner->pasteArrived(Fl::event_text(), Fl::event_length());
+        return 1;
+    }
+
+protected:
+    void draw() override {}
+
+private:
+    SoFlClipboard * owner;
+};
+
+namespace {
+
+    // Marks binary Inventor data, which travels base64 encoded since
+    // the system clipboard only carries text.
+    const char BINARY_MARKER[] = "#SoFl binary base64\n";
+    // Name of the group wrapping the copied roots.
+    const char ROOT_NAME[] = "SoFlClipboard";
+
+    // What was last copied in this process, shared by all clipboards.
+    struct {
+        SoGroup * content{nullptr};
+        unsigned long serial{0};
+        // The copy that made it to the system clipboard, and its text
+        // to recognise it when pasted.
+        unsigned long published{0};
+        std::string text;
+    } shared;
+
+    // Clipboards by the id of their running jobs, so that an Fl::awake()
+    // callback arriving after its clipboard is gone finds nothing.
+    struct {
+        std::map<unsigned long, SoFlClipboard *> owners;
+        unsigned long next{0};
+    } workers;
+
+    void *
+    jobId(unsigned long id)
+    {
+        return reinterpret_cast<void *>(static_cast<uintptr_t>(id));
+    }
+
+    const char BASE64[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string
+    encode(const std::string & data)
+    {
+        std::string out;
+        out.reserve((data.size() + 2) / 3 * 4 + data.size() / 57 + 1);
+        size_t i = 0;
+        for (; i + 2 < data.size(); i += 3) {
+            const uint32_t v = static_cast<unsigned char>(data[i]) << 16 |
+                               static_cast<unsigned char>(data[i + 1]) << 8 |
+                               static_cast<unsigned char>(data[i + 2]);
+            out += BASE64[v >> 18 & 63];
+            out += BASE64[v >> 12 & 63];
+            out += BASE64[v >> 6 & 63];
+            out += BASE64[v & 63];
+            // Wrap lines, like other base64 producers do.
+            if ((i / 3 + 1) % 19 == 0) out += '\n';
+        }
+        if (i < data.size()) {
+            uint32_t v = static_cast<unsigned char>(data[i]) << 16;
+            if (i + 1 < data.size()) v |= static_cast<unsigned char>(data[i + 1]) << 8;
+            out += BASE64[v >> 18 & 63];
+            out += BASE64[v >> 12 & 63];
+            out += i + 1 < data.size() ? BASE64[v >> 6 & 63] : '=';
+            out += '=';
+        }
+        out += '\n';
+        return out;
+    }
+
+    std::string
+    decode(const char * text, size_t length)
+    {
+        int values[256];
+        std::fill(values, values + 256, -1);
+        for (int i = 0; i < 64; i++) values[static_cast<unsigned char>(BASE64[i])] = i;
+
+        std::string out;
+        out.reserve(length / 4 * 3);
+        uint32_t v = 0;
+        int bits = 0;
+        for (size_t i = 0; i < length; i++) {
+            const int value = values[static_cast<unsigned char>(text[i])];
+            if (value < 0) continue; // line breaks and padding
+            v = v << 6 | value;
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out += static_cast<char>(v >> bits & 0xff);
+            }
+        }
+        return out;
+    }
+
+    void *
+    growBuffer(void * buffer, size_t size)
+    {
+        return std::realloc(buffer, size);
+    }
+
+    std::string
+    writeGraph(SoNode * root, bool binary)
+    {
+        std::string text;
+        void * buffer = std::malloc(4096);
+        {
+            SoOutput out;
+            out.setBinary(binary);
+            out.setBuffer(buffer, 4096, growBuffer);
+            SoWriteAction wa(&out);
+            wa.apply(root);
+            size_t size = 0;
+            out.getBuffer(buffer, size);
+            text.assign(static_cast<const char *>(buffer), size);
+        }
+        std::free(buffer);
+        return text;
+    }
+
+    SoNode *
+    readGraph(const std::string & text)
+    {
+        SoInput in;
+        in.setBuffer(text.data(), text.size());
+        SoSeparator * root = SoDB::readAll(&in);
+        if (!root) return nullptr;
+        root->ref();
+        // Unwrap the group written by copy(); anything else is pasted
+        // as it was found.
+        if (root->getNumChildren() == 1 &&
+            root->getChild(0)->getTypeId() == SoGroup::getClassTypeId() &&
+            root->getChild(0)->getName() == ROOT_NAME) {
+            SoNode * group = root->getChild(0);
+            group->ref();
+            root->unref();
+            return group;
+        }
+        return root;
+    }
+
+} // namespace
+
+SoFlClipboard::SoFlClipboard()
+{
+    // Keep the receiver out of whatever group is being built.
+    Fl_Group * current = Fl_Group::current();
+    Fl_Group::current(nullptr);
+    this->receiver = new SoFlClipboardReceiver(this);
+    Fl_Group::current(current);
+}
+
+SoFlClipboard::~SoFlClipboard()
+{
+    // A copy still being encoded is published right away; pastes still
+    // being decoded are dropped along with their callbacks.
+    for (Job * job : this->jobs) {
+        job->thread.join();
+        workers.owners.erase(job->id);
+        if (!job->paste) SoFlClipboard::publish(job->text, job->serial);
+        delete job;
+    }
+    delete this->receiver;
+}
+
+void
+SoFlClipboard::copy(SoNode * node)
+{
+    if (!node) return;
+    SoNodeList nodes;
+    nodes.append(node);
+    this->copyNodes(nodes);
+}
+
+void
+SoFlClipboard::copy(SoPathList * pathlist)
+{
+    if (!pathlist) return;
+    SoNodeList nodes;
+    for (int i = 0; i < pathlist->getLength(); i++) {
+        nodes.append((*pathlist)[i]->getTail());
+    }
+    this->copyNodes(nodes);
+}
+
+void
+SoFlClipboard::copyNodes(const SoNodeList & nodes)
+{
+    if (nodes.getLength() == 0) return;
+
+    // The graph is copied once, and that copy is both what is written
+    // to the system clipboard and what pastes in this process share.
+    auto * content = new SoGroup;
+    content->ref();
+    content->setName(ROOT_NAME);
+    for (int i = 0; i < nodes.getLength(); i++) {
+        content->addChild(nodes[i]->copy());
+    }
+    if (shared.content) shared.content->unref();
+    shared.content = content;
+    shared.serial++;
+    shared.text.clear();
+
+    std::string text = writeGraph(content, this->binary);
+    if (!this->binary) {
+        SoFlClipboard::publish(text, shared.serial);
+        return;
+    }
+
+    auto * job = new Job;
+    job->id = ++workers.next;
+    job->text.swap(text);
+    job->serial = shared.serial;
+    workers.owners[job->id] = this;
+    this->jobs.push_back(job);
+
+    enableWorkerThreads();
+    job->thread = std::thread([job]() {
+        job->text = BINARY_MARKER + encode(job->text);
+        Fl::awake(SoFlClipboard::jobDoneCB, jobId(job->id));
+    });
+}
+
+void
+SoFlClipboard::publish(std::string & text, unsigned long serial)
+{
+    // A later copy has taken over already.
+    if (serial != shared.serial) return;
+    Fl::copy(text.data(), static_cast<int>(text.size()), 1, Fl::clipboard_plain_text);
+    shared.published = serial;
+    shared.text.swap(text);
+}
+
+void
+SoFlClipboard::jobDoneCB(void * id)
+{
+    const auto found = workers.owners.find(reinterpret_cast<uintptr_t>(id));
+    if (found == workers.owners.end()) return;
+    SoFlClipboard * owner = found->second;
+    workers.owners.erase(found);
+
+    for (Job * job : owner->jobs) {
+        if (job->id != reinterpret_cast<uintptr_t>(id)) continue;
+        owner->jobs.erase(std::remove(owner->jobs.begin(), owner->jobs.end(), job),
+                          owner->jobs.end());
+        owner->finishJob(job);
+        break;
+    }
+}
+
+void
+SoFlClipboard::finishJob(Job * job)
+{
+    job->thread.join();
+    if (!job->paste) {
+        SoFlClipboard::publish(job->text, job->serial);
+    }
+    else {
+        SoNode * root = readGraph(job->text);
+#if SOFL_DEBUG
+        if (!root) {
+            SoDebugError::postWarning("SoFlClipboard::paste",
+                                      "clipboard contents are not an Inventor scene");
+        }
+#endif
+        SoFlClipboard::deliver(job->requests, root);
+        if (root) root->unref();
+    }
+    delete job;
+}
+
+void
+SoFlClipboard::paste(SoFlClipboardPasteCB * callback, void * userdata, bool independent)
+{
+    if (!callback) return;
+    const Request request = {callback, userdata, independent};
+
+    // The system clipboard is not up to date with our last copy yet,
+    // so that copy is what the user expects to get.
+    if (shared.content && shared.published != shared.serial) {
+        SoFlClipboard::deliver(std::vector<Request>(1, request), shared.content);
+        return;
+    }
+    if (!Fl::clipboard_contains(Fl::clipboard_plain_text)) {
+        SoFlClipboard::deliver(std::vector<Request>(1, request), nullptr);
+        return;
+    }
+    // Pastes requested before the data arrives are served together.
+    this->requests.push_back(request);
+    if (this->requests.size() == 1) {
+        Fl::paste(*this->receiver, 1, Fl::clipboard_plain_text);
+    }
+}
+
+void
+SoFlClipboard::pasteText(const char * text, int length,
+                         SoFlClipboardPasteCB * callback, void * userdata,
+                         bool independent)
+{
+    if (!callback) return;
+    std::vector<Request> waiting(1, Request{callback, userdata, independent});
+    this->received(text, length, waiting);
+}
+
+void
+SoFlClipboard::pasteArrived(const char * text, int length)
+{
+    if (this->requests.empty()) return;
+    std::vector<Request> waiting;
+    waiting.swap(this->requests);
+    this->received(text, length, waiting);
+}
+
+void
+SoFlClipboard::received(const char * text, int length, std::vector<Request> & waiting)
+{
+    const size_t size = text && length > 0 ? static_cast<size_t>(length) : 0;
+    if (shared.content && !shared.text.empty() &&
+        shared.text.compare(0, std::string::npos, text, size) == 0) {
+        SoFlClipboard::deliver(waiting, shared.content);
+        return;
+    }
+
+    const size_t marker = sizeof(BINARY_MARKER) - 1;
+    if (size < marker || std::string(text, marker) != BINARY_MARKER) {
+        SoNode * root = size ? readGraph(std::string(text, size)) : nullptr;
+        SoFlClipboard::deliver(waiting, root);
+        if (root) root->unref();
+        return;
+    }
+
+    auto * job = new Job;
+    job->id = ++workers.next;
+    job->paste = true;
+    job->text.assign(text + marker, size - marker);
+    job->requests.swap(waiting);
+    workers.owners[job->id] = this;
+    this->jobs.push_back(job);
+
+    enableWorkerThreads();
+    job->thread = std::thread([job]() {
+        job->text = decode(job->text.data(), job->text.size());
+        Fl::awake(SoFlClipboard::jobDoneCB, jobId(job->id));
+    });
+}
+
+void
+SoFlClipboard::deliver(const std::vector<Request> & requests, SoNode * root)
+{
+    for (const Request & request : requests) {
+        // Pastes share the graph unless they asked for one of their own.
+        SoNode * graph = root && request.independent ? root->copy() : root;
+        if (graph) graph->ref();
+
+        SoPathList pathlist;
+        SoGroup * group = graph && graph->isOfType(SoGroup::getClassTypeId())
+            ? static_cast<SoGroup *>(graph) : nullptr;
+        for (int c = 0; group && c < group->getNumChildren(); c++) {
+            pathlist.append(new SoPath(group->getChild(c)));
+        }
+        request.callback(request.userdata, &pathlist);
+
+        pathlist.truncate(0);
+        if (graph) graph->unref();
+    }
+}
+
+void
+SoFlClipboard::setBinary(bool on)
+{
+    this->binary = on;
+}
+
+bool
+SoFlClipboard::isBinary() const
+{
+    return this->binary;
+}
+
+bool
+SoFlClipboard::isPasting() const
+{
+    return !this->requests.empty() ||
+        std::any_of(this->jobs.begin(), this->jobs.end(),
+                    [](const Job * job) { return job->paste; });
+}
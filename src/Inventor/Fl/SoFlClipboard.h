@@ -32,10 +32,76 @@
 #ifndef SOFL_SOFLCLIPBOARD_H
 #define SOFL_SOFLCLIPBOARD_H
 
+#include "Inventor/Fl/SoFlBasic.h"
 
-class SoFlClipboard {
+#include <string>
+#include <vector>
 
-};
+class Fl_Widget;
+class SoNode;
+class SoNodeList;
+class SoPathList;
+
+// Receives the pasted data as one single-node path per pasted root.
+// The list is only valid during the callback; ref what is kept.
+typedef void SoFlClipboardPasteCB(void * userdata, SoPathList * pathlist);
+
+// Copies and pastes scene graphs through the system clipboard.
+//
+// Writing and reading Inventor data happen in the main thread, like any
+// other Coin call; only the base64 coding of binary data runs on a
+// worker thread owned by the clipboard, with the result handed back to
+// the FLTK main loop through Fl::awake(). A paste of data copied in this
+// same process skips the round trip altogether: every such paste shares
+// the one graph copied at copy time, unless an independent copy is asked
+// for.
+//
+// Graphs are written as binary Inventor by default, which is both
+// smaller and quicker to read; setBinary(false) selects plain ASCII
+// for pasting into other applications.
+class SOFL_DLL_API SoFlClipboard {
+public:
+    SoFlClipboard();
+    ~SoFlClipboard();
+
+    void copy(SoNode * node);
+    // Copies the tail node of each path.
+    void copy(SoPathList * pathlist);
+    void paste(SoFlClipboardPasteCB * callback, void * userdata = nullptr,
+               bool independent = false);
+    // Pastes text received some other way, such as from a drop.
+    void pasteText(const char * text, int length,
+                   SoFlClipboardPasteCB * callback, void * userdata = nullptr,
+                   bool independent = false);
 
+    void setBinary(bool on);
+    bool isBinary() const;
+
+    // Whether a paste is still waiting for its data. Pastes still
+    // waiting when the clipboard is destroyed are dropped.
+    bool isPasting() const;
+
+private:
+    struct Job;
+    struct Request {
+        SoFlClipboardPasteCB * callback;
+        void * userdata;
+        bool independent;
+    };
+    friend class SoFlClipboardReceiver;
+    void copyNodes(const SoNodeList & nodes);
+    void pasteArrived(const char * text, int length);
+    void received(const char * text, int length, std::vector<Request> & waiting);
+    void finishJob(Job * job);
+    static void publish(std::string & text, unsigned long serial);
+    static void deliver(const std::vector<Request> & requests, SoNode * root);
+    static void jobDoneCB(void * id);
+
+    Fl_Widget * receiver{nullptr};
+    // Pastes waiting for the clipboard contents, and those being parsed.
+    std::vector<Request> requests;
+    std::vector<Job *> jobs;
+    bool binary{true};
+};
 
 #endif //SOFL_SOFLCLIPBOARD_H
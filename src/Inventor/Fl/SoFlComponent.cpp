@@ -36,6 +36,8 @@
 #include "Inventor/Fl/SoFlGLWidget.h"
 #include "Inventor/Fl/SoFlRenderArea.h"
 #include "Inventor/Fl/SoFlCursor.h"
+#include "Inventor/Fl/SoFlGraphEditor.h"
+#include "Inventor/Fl/SoFlMultiViewRenderArea.h"
 
 #include "Inventor/Fl/viewers/SoFlViewer.h"
 #include "Inventor/Fl/viewers/SoFlFullViewer.h"
@@ -99,12 +101,14 @@ void  SoFlComponent::initClasses() {
     SoFlComponent::initClass();
     SoFlGLWidget::initClass();
     SoFlRenderArea::initClass();
+    SoFlMultiViewRenderArea::initClass();
     SoFlViewer::initClass();
     SoFlExaminerViewer::initClass();
     SoFlPlaneViewer::initClass();
     SoFlConstrainedViewer::initClass();
     SoFlFullViewer::initClass();
     SoFlFlyViewer::initClass();
+    SoFlGraphEditor::initClass();
 }
 
 void
@@ -0,0 +1,293 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLAccumulator.h"
+#include "Inventor/Fl/SoFlGLDamage.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLOverlay.h"
+#include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/SoFlRenderArea.h"
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
+
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+#include <Inventor/sensors/SoAlarmSensor.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <GL/gl.h>
+
+#include <cmath>
+
+#include "sofldefs.h"
+
+#define PUBLIC(obj) ((obj)->pub)
+
+namespace {
+
+    // How long, in seconds, a frame must stay on screen unchanged
+    // before it is refined. Animated scenes redraw sooner than this.
+    const double STILL_TIME = 0.1;
+
+    // Radical inverse in the given base; consecutive values of bases 2
+    // and 3 spread subpixel samples evenly whatever the pass count.
+    float halton(int index, int base) {
+        float result = 0.0f;
+        float f = 1.0f / base;
+        for (int i = index; i > 0; i /= base) {
+            result += f * (i % base);
+            f /= base;
+        }
+        return result;
+    }
+
+} // namespace
+
+SoFlGLAccumulator::SoFlGLAccumulator(SoFlGLWidgetP *o)
+    : owner(o),
+      sensor(new SoOneShotSensor(SoFlGLAccumulator::passCB, this)),
+      stillsensor(new SoAlarmSensor(SoFlGLAccumulator::passCB, this)),
+      scenesensor(new SoNodeSensor(SoFlGLAccumulator::changedCB, this)),
+      passes(16),
+      completed(0),
+      supported(true),
+      size(0, 0),
+      // 16 bits per channel keeps the running average from banding.
+      accumbuffer(new SoFlGLFramebuffer(GL_RGBA16)),
+      framecopy(new SoFlGLFramebuffer(GL_RGBA8)) {
+    // Immediate, so a change calls off a pass scheduled before it.
+    this->scenesensor->setPriority(0);
+}
+
+SoFlGLAccumulator::~SoFlGLAccumulator() {
+    delete this->sensor;
+    delete this->stillsensor;
+    delete this->scenesensor;
+    this->owner->releaseFramebuffers({this->accumbuffer, this->framecopy});
+    delete this->accumbuffer;
+    delete this->framecopy;
+}
+
+void
+SoFlGLAccumulator::setPasses(int n) {
+    this->passes = (n > 1) ? n : 1;
+    if (this->completed >= this->passes) this->stop();
+}
+
+int
+SoFlGLAccumulator::getPasses() const {
+    return this->passes;
+}
+
+bool
+SoFlGLAccumulator::isRefining() const {
+    return this->sensor->isScheduled() || this->stillsensor->isScheduled();
+}
+
+int
+SoFlGLAccumulator::getCompletedPasses() const {
+    return this->completed;
+}
+
+void
+SoFlGLAccumulator::stop() {
+    this->sensor->unschedule();
+    this->stillsensor->unschedule();
+}
+
+void
+SoFlGLAccumulator::jitter(int pass, float &dx, float &dy) {
+    // Pass 0 is the regular, unjittered frame.
+    if (pass == 0) {
+        dx = dy = 0.0f;
+        return;
+    }
+    dx = halton(pass, 2) - 0.5f;
+    dy = halton(pass, 3) - 0.5f;
+}
+
+// Nothing is copied here: in an animated scene the next frame is on
+// its way before the frame has been still for long, and a copy would
+// be wasted on every swap.
+void
+SoFlGLAccumulator::restart() {
+    this->stop();
+    this->completed = 0;
+    if (!this->supported || this->passes <= 1) return;
+
+    const SbVec2s glsize = this->owner->glSize;
+    if (glsize[0] <= 0 || glsize[1] <= 0) return;
+    if (!this->initGL(glsize)) return;
+
+    SoFlGLWidget *widget = PUBLIC(this->owner);
+    if (!widget->isOfType(SoFlRenderArea::getClassTypeId())) return;
+    SoNode *root = static_cast<SoFlRenderArea *>(widget)->getSceneManager()->getSceneGraph();
+    if (this->scenesensor->getAttachedNode() != root) {
+        this->scenesensor->detach();
+        if (root) this->scenesensor->attach(root);
+    }
+    this->stillsensor->setTimeFromNow(SbTime(STILL_TIME));
+    this->stillsensor->schedule();
+}
+
+bool
+SoFlGLAccumulator::initGL(const SbVec2s &newsize) {
+    if (!SoFlGLFramebuffer::isSupported()) {
+#if SOFL_DEBUG
+        SoDebugError::postWarning("SoFlGLAccumulator::initGL",
+                                  "framebuffer objects not available, "
+                                  "progressive antialiasing disabled");
+#endif
+        this->supported = false;
+        return false;
+    }
+    this->size = newsize;
+    return this->accumbuffer->setSize(newsize) && this->framecopy->setSize(newsize);
+}
+
+// Blends the current back buffer into the accumulation buffer as pass
+// number 'pass', keeping a running average of all passes so far.
+void
+SoFlGLAccumulator::accumulate(int pass) {
+    this->framecopy->copyFromBackBuffer();
+    SoFlGLFramebuffer::beginScreenPass(this->size);
+    this->accumbuffer->bind();
+    if (pass == 0) this->framecopy->draw();
+    else this->framecopy->drawBlended(1.0f / (pass + 1));
+    SoFlGLFramebuffer::unbind();
+    SoFlGLFramebuffer::endScreenPass();
+    this->completed = pass + 1;
+}
+
+void
+SoFlGLAccumulator::display() {
+    SoFlGLFramebuffer::beginScreenPass(this->size);
+    glDrawBuffer(GL_BACK);
+    this->accumbuffer->draw();
+    SoFlGLFramebuffer::endScreenPass();
+    // The refined image is what partial redraws and overlay-only
+    // updates draw on.
+    if (this->owner->damage) this->owner->damage->endFrame();
+    SoFlGLOverlay *overlay = this->owner->overlaylayer;
+    if (overlay) {
+        overlay->captureScene();
+        overlay->composite();
+    }
+    this->owner->currentglarea->swap_buffers();
+}
+
+// Renders the next pass with the camera nudged by a subpixel offset.
+// The nudge is applied with notification off, so it neither triggers a
+// redraw nor restarts the refinement. Pass 0 is the frame as shown,
+// rendered again once it is known to be still: the back buffer it was
+// drawn into is gone after the swap.
+void
+SoFlGLAccumulator::renderPass() {
+    SoFlGLWidget *widget = PUBLIC(this->owner);
+    if (this->owner->interacting ||
+        !widget->isOfType(SoFlRenderArea::getClassTypeId()) ||
+        this->owner->glSize != this->size) {
+        return;
+    }
+
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(widget);
+    SoCamera *camera = this->owner->findCamera();
+    if (!camera) return;
+
+    const float aspect = float(this->size[0]) / float(this->size[1]);
+    const SbViewVolume volume = camera->getViewVolume(aspect);
+    float dx, dy;
+    SoFlGLAccumulator::jitter(this->completed, dx, dy);
+    // pixels to normalized device coordinates
+    dx *= 2.0f / this->size[0];
+    dy *= 2.0f / this->size[1];
+
+    const SbVec3f position = camera->position.getValue();
+    const SbRotation orientation = camera->orientation.getValue();
+    const SbBool notify = camera->enableNotify(FALSE);
+
+    if (camera->isOfType(SoOrthographicCamera::getClassTypeId())) {
+        SbVec3f right, up;
+        orientation.multVec(SbVec3f(1.0f, 0.0f, 0.0f), right);
+        orientation.multVec(SbVec3f(0.0f, 1.0f, 0.0f), up);
+        camera->position = position
+                           - right * (dx * volume.getWidth() * 0.5f)
+                           - up * (dy * volume.getHeight() * 0.5f);
+    } else if (camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+        // A subpixel turn of the camera is indistinguishable from
+        // shifting the projection by the same amount.
+        const float neardist = volume.getNearDist();
+        const float yaw = std::atan(dx * volume.getWidth() * 0.5f / neardist);
+        const float pitch = std::atan(dy * volume.getHeight() * 0.5f / neardist);
+        camera->orientation = SbRotation(SbVec3f(1.0f, 0.0f, 0.0f), -pitch) *
+                              SbRotation(SbVec3f(0.0f, 1.0f, 0.0f), yaw) *
+                              orientation;
+    } else {
+        camera->enableNotify(notify);
+        return;
+    }
+
+    widget->glLockNormal();
+    area->getSceneManager()->render(area->isClearBeforeRender(),
+                                    area->isClearZBufferBeforeRender());
+    this->accumulate(this->completed);
+    if (this->completed > 1) this->display();
+    widget->glUnlockNormal();
+
+    camera->position = position;
+    camera->orientation = orientation;
+    camera->enableNotify(notify);
+
+    if (this->completed < this->passes) this->sensor->schedule();
+}
+
+void
+SoFlGLAccumulator::passCB(void *closure, SoSensor *) {
+    static_cast<SoFlGLAccumulator *>(closure)->renderPass();
+}
+
+// The redraw that follows a change restarts the refinement.
+void
+SoFlGLAccumulator::changedCB(void *closure, SoSensor *) {
+    static_cast<SoFlGLAccumulator *>(closure)->stop();
+}
+
+#undef PUBLIC
@@ -0,0 +1,100 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGLACCUMULATOR_H
+#define SOFL_SOFLGLACCUMULATOR_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbVec2s.h>
+
+class SoFlGLFramebuffer;
+class SoAlarmSensor;
+class SoFlGLWidgetP;
+class SoNodeSensor;
+class SoOneShotSensor;
+class SoSensor;
+
+// Progressive antialiasing for still frames. Once a render area shows
+// a frame while the view is idle, one subpixel-jittered pass is
+// rendered per idle tick and averaged into an offscreen accumulation
+// buffer, which is displayed after every pass until the configured
+// number of passes is reached. A frame of an animated scene is
+// followed by the next one before it has been still for long, and
+// costs nothing.
+class SoFlGLAccumulator {
+public:
+    explicit SoFlGLAccumulator(SoFlGLWidgetP * owner);
+    ~SoFlGLAccumulator();
+
+    void setPasses(int passes);
+    int getPasses() const;
+
+    // Schedules the refinement of the frame about to be swapped. The
+    // first pass is rendered once the scene has stayed unchanged for a
+    // moment. Must be called with the normal context current, right
+    // before the buffer swap.
+    void restart();
+    void stop();
+
+    bool isRefining() const;
+    int getCompletedPasses() const;
+
+    // Subpixel offset, in pixels within [-0.5, 0.5), of the given pass.
+    static void jitter(int pass, float & dx, float & dy);
+
+private:
+    static void passCB(void * closure, SoSensor * sensor);
+    static void changedCB(void * closure, SoSensor * sensor);
+    void renderPass();
+    bool initGL(const SbVec2s & size);
+    void accumulate(int pass);
+    void display();
+
+    SoFlGLWidgetP * owner;
+    SoOneShotSensor * sensor;
+    // Starts the refinement once a frame has been shown for a while.
+    SoAlarmSensor * stillsensor;
+    // Watches the scene manager's root, camera included.
+    SoNodeSensor * scenesensor;
+    int passes;
+    int completed;
+    bool supported;
+    SbVec2s size;
+    SoFlGLFramebuffer * accumbuffer;
+    SoFlGLFramebuffer * framecopy;
+};
+
+#endif //SOFL_SOFLGLACCUMULATOR_H
@@ -0,0 +1,355 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLDamage.h"
+#include "Inventor/Fl/SoFlGLAccumulator.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLStereo.h"
+#include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/SoFlRenderArea.h"
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/nodes/SoCamera.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/misc/SoNotification.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "sofldefs.h"
+
+#define PUBLIC(obj) ((obj)->pub)
+
+namespace {
+
+    // Damage larger than this part of the viewport is cheaper to render
+    // in full than to restore around.
+    const float MAX_DAMAGE_FRACTION = 0.5f;
+
+    // Antialiased and wide lines reach slightly outside the bounding box.
+    const int DAMAGE_MARGIN = 2;
+
+} // namespace
+
+SoFlGLDamage::SoFlGLDamage(SoFlGLWidgetP *o)
+    : owner(o),
+      action(nullptr),
+      sensor(new SoNodeSensor(SoFlGLDamage::changedCB, this)),
+      framecache(new SoFlGLFramebuffer(GL_RGBA8)),
+      fullredraw(true),
+      partial(false),
+      scissored(false),
+      scissorbox{0, 0, 0, 0} {
+    // Immediate notification, so every change is seen with the path to
+    // what changed rather than just the last one of the frame.
+    this->sensor->setPriority(0);
+    this->sensor->setTriggerPathFlag(TRUE);
+
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this->owner));
+    this->action = area->getGLRenderAction();
+    this->action->addPreRenderCallback(SoFlGLDamage::preRenderCB, this);
+    this->attach();
+}
+
+// The render action belongs to the render area, which is already gone
+// when the GL widget tears down its private data, so the pre-render
+// callback is only removed in release().
+SoFlGLDamage::~SoFlGLDamage() {
+    delete this->sensor;
+    this->owner->releaseFramebuffers({this->framecache});
+    delete this->framecache;
+    this->clearPending();
+    this->clearRects();
+}
+
+void
+SoFlGLDamage::release() {
+    if (this->action) {
+        this->action->removePreRenderCallback(SoFlGLDamage::preRenderCB, this);
+        this->action = nullptr;
+    }
+}
+
+void
+SoFlGLDamage::invalidate() {
+    this->fullredraw = true;
+    this->clearPending();
+}
+
+void
+SoFlGLDamage::clearPending() {
+    for (SoPath *path : this->pending) path->unref();
+    this->pending.clear();
+}
+
+void
+SoFlGLDamage::clearRects() {
+    for (auto &entry : this->lastrects) entry.first->unref();
+    this->lastrects.clear();
+}
+
+void
+SoFlGLDamage::attach() {
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this->owner));
+    SoNode *root = area->getSceneManager()->getSceneGraph();
+    if (this->sensor->getAttachedNode() == root) return;
+
+    this->sensor->detach();
+    if (root) this->sensor->attach(root);
+    this->clearRects();
+    this->invalidate();
+}
+
+void
+SoFlGLDamage::changedCB(void *closure, SoSensor *sensor) {
+    static_cast<SoFlGLDamage *>(closure)->recordChange(static_cast<SoNodeSensor *>(sensor));
+}
+
+void
+SoFlGLDamage::recordChange(SoNodeSensor *s) {
+    // Whatever was being refined is stale now.
+    if (this->owner->accumulator) this->owner->accumulator->stop();
+    if (this->fullredraw) return;
+
+    SoFullPath *path = static_cast<SoFullPath *>(s->getTriggerPath());
+    SoNode *node = s->getTriggerNode();
+    if (!path || !node || node->isOfType(SoCamera::getClassTypeId())) {
+        this->invalidate();
+        return;
+    }
+
+    // Children coming and going may leave separators behind that are
+    // no longer in the graph; their rectangles are dropped rather than
+    // kept alive, at the price of one full frame.
+    switch (s->getTriggerOperationType()) {
+    case SoNotRec::GROUP_ADDCHILD:
+    case SoNotRec::GROUP_INSERTCHILD:
+    case SoNotRec::GROUP_REPLACECHILD:
+    case SoNotRec::GROUP_REMOVECHILD:
+    case SoNotRec::GROUP_REMOVEALLCHILDREN:
+        this->clearRects();
+        this->invalidate();
+        return;
+    default:
+        break;
+    }
+
+    // A node used in more than one place (DEF/USE) shows the change
+    // wherever else it appears, outside the box worked out here.
+    for (int i = 1; i < path->getLength(); ++i) {
+        if (path->getNode(i)->getNumParents() > 1) {
+            this->invalidate();
+            return;
+        }
+    }
+
+    // Only a change below a separator (other than the root) stays
+    // within that separator's bounding box.
+    int separator = -1;
+    for (int i = path->getLength() - 1; i > 0; --i) {
+        if (path->getNode(i)->isOfType(SoSeparator::getClassTypeId())) {
+            separator = i;
+            break;
+        }
+    }
+    if (separator < 0) {
+        this->invalidate();
+        return;
+    }
+
+    SoNode *damaged = path->getNode(separator);
+    for (SoPath *p : this->pending) {
+        if (static_cast<SoFullPath *>(p)->getTail() == damaged) return;
+    }
+    SoPath *copy = path->copy(0, separator + 1);
+    copy->ref();
+    this->pending.push_back(copy);
+}
+
+void
+SoFlGLDamage::preRenderCB(void *closure, SoGLRenderAction *action) {
+    static_cast<SoFlGLDamage *>(closure)->beginFrame(action);
+}
+
+void
+SoFlGLDamage::beginFrame(SoGLRenderAction *renderaction) {
+    if (this->partial) return;
+    this->attach();
+
+    const SbViewportRegion &viewport = renderaction->getViewportRegion();
+    const SbVec2s size = viewport.getViewportSizePixels();
+    const SbVec2s origin = viewport.getViewportOriginPixels();
+    SoCamera *camera = this->owner->findCamera();
+
+    // The eyes are drawn with cameras of their own into parts of the
+    // window the rectangles know nothing about.
+    const bool stereo = this->owner->stereo && this->owner->stereo->getMode() != SoFlGLStereo::NONE;
+    bool usable = !this->fullredraw && !stereo && !this->pending.empty() && camera &&
+                  this->framecache->isValid() &&
+                  this->framecache->getSize() == size &&
+                  origin == SbVec2s(0, 0);
+
+    // The rectangles are worked out even when this frame is drawn in
+    // full, so the old extent is known the next time something moves.
+    SbBox2s damage;
+    if (camera) {
+        const SbViewVolume volume = camera->getViewVolume(viewport.getViewportAspectRatio());
+        for (SoPath *path : this->pending) {
+            const SbBox2s rect = SoFlGLDamage::screenRect(path, volume, viewport);
+            SoNode *separator = static_cast<SoFullPath *>(path)->getTail();
+            auto it = this->lastrects.find(separator);
+            if (it == this->lastrects.end()) {
+                separator->ref();
+                this->lastrects[separator] = rect;
+                usable = false;
+            } else {
+                if (!it->second.isEmpty()) damage.extendBy(it->second);
+                it->second = rect;
+            }
+            if (!rect.isEmpty()) damage.extendBy(rect);
+        }
+    }
+    this->clearPending();
+    this->fullredraw = false;
+    if (!usable) return;
+
+    // Scene changes that ended up off screen leave nothing to redraw.
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    if (!damage.isEmpty()) {
+        SbVec2s mn, mx;
+        damage.getBounds(mn, mx);
+        x0 = mn[0]; y0 = mn[1];
+        x1 = mx[0] + 1; y1 = mx[1] + 1;
+        const float area = float(x1 - x0) * float(y1 - y0);
+        if (area > MAX_DAMAGE_FRACTION * float(size[0]) * float(size[1])) return;
+    }
+
+    // Put the previous frame back around the damage, then confine the
+    // render (and its clear) to the damaged rectangle.
+    this->scissored = glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE;
+    glGetIntegerv(GL_SCISSOR_BOX, this->scissorbox);
+    SoFlGLFramebuffer::beginScreenPass(size);
+    glEnable(GL_SCISSOR_TEST);
+    const int strips[4][4] = {
+        { 0, 0, size[0], y0 },
+        { 0, y1, size[0], size[1] - y1 },
+        { 0, y0, x0, y1 - y0 },
+        { x1, y0, size[0] - x1, y1 - y0 }
+    };
+    for (const auto &strip : strips) {
+        if (strip[2] <= 0 || strip[3] <= 0) continue;
+        glScissor(strip[0], strip[1], strip[2], strip[3]);
+        this->framecache->draw();
+    }
+    SoFlGLFramebuffer::endScreenPass();
+
+    glScissor(x0, y0, x1 - x0, y1 - y0);
+    glEnable(GL_SCISSOR_TEST);
+    this->partial = true;
+}
+
+void
+SoFlGLDamage::endRender() {
+    if (!this->partial) return;
+    glScissor(this->scissorbox[0], this->scissorbox[1],
+              this->scissorbox[2], this->scissorbox[3]);
+    if (!this->scissored) glDisable(GL_SCISSOR_TEST);
+    this->partial = false;
+}
+
+void
+SoFlGLDamage::endFrame() {
+    this->endRender();
+    if (this->framecache->setSize(this->owner->glSize)) {
+        this->framecache->copyFromBackBuffer();
+    }
+}
+
+SbBox2s
+SoFlGLDamage::screenRect(SoPath *path,
+                         const SbViewVolume &volume,
+                         const SbViewportRegion &viewport) {
+    const SbVec2s size = viewport.getViewportSizePixels();
+    const SbVec2s origin = viewport.getViewportOriginPixels();
+    const SbBox2s everything(origin[0], origin[1],
+                             origin[0] + size[0] - 1, origin[1] + size[1] - 1);
+
+    SoGetBoundingBoxAction bbaction(viewport);
+    bbaction.apply(path);
+    const SbBox3f box = bbaction.getBoundingBox();
+    if (box.isEmpty()) return SbBox2s();
+
+    SbVec3f mn, mx;
+    box.getBounds(mn, mx);
+    const SbVec3f eye = volume.getProjectionPoint();
+    const SbVec3f direction = volume.getProjectionDirection();
+    const float neardist = volume.getNearDist();
+
+    int x0 = size[0], y0 = size[1], x1 = -1, y1 = -1;
+    for (int i = 0; i < 8; ++i) {
+        const SbVec3f corner((i & 1) ? mx[0] : mn[0],
+                             (i & 2) ? mx[1] : mn[1],
+                             (i & 4) ? mx[2] : mn[2]);
+        // Points behind the near plane do not project sensibly.
+        if ((corner - eye).dot(direction) < neardist) return everything;
+        SbVec3f screen;
+        volume.projectToScreen(corner, screen);
+        const int px = static_cast<int>(std::floor(screen[0] * size[0]));
+        const int py = static_cast<int>(std::floor(screen[1] * size[1]));
+        x0 = std::min(x0, px); y0 = std::min(y0, py);
+        x1 = std::max(x1, px); y1 = std::max(y1, py);
+    }
+
+    x0 = std::max(x0 - DAMAGE_MARGIN, 0);
+    y0 = std::max(y0 - DAMAGE_MARGIN, 0);
+    x1 = std::min(x1 + DAMAGE_MARGIN, size[0] - 1);
+    y1 = std::min(y1 + DAMAGE_MARGIN, size[1] - 1);
+    if (x0 > x1 || y0 > y1) return SbBox2s();
+
+    return SbBox2s(origin[0] + x0, origin[1] + y0, origin[0] + x1, origin[1] + y1);
+}
+
+#undef PUBLIC
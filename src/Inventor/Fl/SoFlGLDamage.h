@@ -0,0 +1,109 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGLDAMAGE_H
+#define SOFL_SOFLGLDAMAGE_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbBox2s.h>
+
+#include <map>
+#include <vector>
+
+class SbViewVolume;
+class SbViewportRegion;
+class SoFlGLFramebuffer;
+class SoFlGLWidgetP;
+class SoGLRenderAction;
+class SoNode;
+class SoNodeSensor;
+class SoPath;
+class SoSensor;
+
+// Partial redraws for render areas where little changes per frame.
+// Scene graph changes are recorded as they happen; when a change is
+// contained in a separator, the next frame restores the previous frame
+// from a cached copy and re-renders only inside the screen rectangle
+// covering the separator's old and new bounding boxes.
+class SoFlGLDamage {
+public:
+    explicit SoFlGLDamage(SoFlGLWidgetP * owner);
+    ~SoFlGLDamage();
+
+    // Detaches from the render area's GL render action.
+    void release();
+
+    // Forces the next frame to be rendered in full.
+    void invalidate();
+
+    // Called once a frame is rendered, swapped or not: ends a partial
+    // redraw, putting the scissor state back the way it was found.
+    void endRender();
+
+    // Called right before a frame is swapped: ends a partial redraw and
+    // caches the frame for the next one.
+    void endFrame();
+
+    // Screen rectangle, in pixels, covering the bounding box of what
+    // 'path' leads to. Empty if the path has no extent; the whole
+    // viewport if part of it is behind the camera.
+    static SbBox2s screenRect(SoPath * path,
+                              const SbViewVolume & volume,
+                              const SbViewportRegion & viewport);
+
+private:
+    static void changedCB(void * closure, SoSensor * sensor);
+    static void preRenderCB(void * closure, SoGLRenderAction * action);
+    void recordChange(SoNodeSensor * sensor);
+    void beginFrame(SoGLRenderAction * action);
+    void attach();
+    void clearPending();
+    void clearRects();
+
+    SoFlGLWidgetP * owner;
+    SoGLRenderAction * action;
+    SoNodeSensor * sensor;
+    SoFlGLFramebuffer * framecache;
+    std::vector<SoPath *> pending;
+    std::map<SoNode *, SbBox2s> lastrects;
+    bool fullredraw;
+    bool partial;
+    // Scissor state from before a partial redraw.
+    bool scissored;
+    int scissorbox[4];
+};
+
+#endif //SOFL_SOFLGLDAMAGE_H
@@ -0,0 +1,282 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+
+#include <Inventor/errors/SoDebugError.h>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#ifdef HAVE_GLX
+#include <GL/glx.h>
+#endif
+
+#include "sofldefs.h"
+
+namespace {
+
+    // Framebuffer objects and glBlendColor are past what libGL exports
+    // on every platform, so resolve them at runtime.
+    struct GLFunctions {
+        bool resolved{false};
+        PFNGLGENFRAMEBUFFERSPROC genFramebuffers{};
+        PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers{};
+        PFNGLBINDFRAMEBUFFERPROC bindFramebuffer{};
+        PFNGLFRAMEBUFFERTEXTURE2DPROC framebufferTexture2D{};
+        PFNGLCHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus{};
+        PFNGLGENRENDERBUFFERSPROC genRenderbuffers{};
+        PFNGLDELETERENDERBUFFERSPROC deleteRenderbuffers{};
+        PFNGLBINDRENDERBUFFERPROC bindRenderbuffer{};
+        PFNGLRENDERBUFFERSTORAGEPROC renderbufferStorage{};
+        PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer{};
+        PFNGLBLENDCOLORPROC blendColor{};
+
+        bool available() {
+            if (!resolved) {
+                resolved = true;
+#ifdef HAVE_GLX
+                genFramebuffers = lookup<PFNGLGENFRAMEBUFFERSPROC>("glGenFramebuffers");
+                deleteFramebuffers = lookup<PFNGLDELETEFRAMEBUFFERSPROC>("glDeleteFramebuffers");
+                bindFramebuffer = lookup<PFNGLBINDFRAMEBUFFERPROC>("glBindFramebuffer");
+                framebufferTexture2D = lookup<PFNGLFRAMEBUFFERTEXTURE2DPROC>("glFramebufferTexture2D");
+                checkFramebufferStatus = lookup<PFNGLCHECKFRAMEBUFFERSTATUSPROC>("glCheckFramebufferStatus");
+                genRenderbuffers = lookup<PFNGLGENRENDERBUFFERSPROC>("glGenRenderbuffers");
+                deleteRenderbuffers = lookup<PFNGLDELETERENDERBUFFERSPROC>("glDeleteRenderbuffers");
+                bindRenderbuffer = lookup<PFNGLBINDRENDERBUFFERPROC>("glBindRenderbuffer");
+                renderbufferStorage = lookup<PFNGLRENDERBUFFERSTORAGEPROC>("glRenderbufferStorage");
+                framebufferRenderbuffer = lookup<PFNGLFRAMEBUFFERRENDERBUFFERPROC>("glFramebufferRenderbuffer");
+                blendColor = lookup<PFNGLBLENDCOLORPROC>("glBlendColor");
+#endif // HAVE_GLX
+            }
+            return genFramebuffers && deleteFramebuffers && bindFramebuffer &&
+                   framebufferTexture2D && checkFramebufferStatus &&
+                   genRenderbuffers && deleteRenderbuffers && bindRenderbuffer &&
+                   renderbufferStorage && framebufferRenderbuffer && blendColor;
+        }
+
+#ifdef HAVE_GLX
+        template<typename T>
+        static T lookup(const char *name) {
+            return reinterpret_cast<T>(glXGetProcAddressARB(reinterpret_cast<const GLubyte *>(name)));
+        }
+#endif // HAVE_GLX
+    };
+
+    GLFunctions gl;
+
+    void drawTexturedQuad(GLuint texture) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+        glTexCoord2f(1.0f, 0.0f); glVertex2f(1.0f, -1.0f);
+        glTexCoord2f(1.0f, 1.0f); glVertex2f(1.0f, 1.0f);
+        glTexCoord2f(0.0f, 1.0f); glVertex2f(-1.0f, 1.0f);
+        glEnd();
+    }
+
+} // namespace
+
+SoFlGLFramebuffer::SoFlGLFramebuffer(int format, bool withdepth)
+    : internalformat(format),
+      depth(withdepth),
+      size(0, 0),
+      valid(false),
+      fbo(0),
+      texture(0),
+      depthbuffer(0) {
+}
+
+SoFlGLFramebuffer::~SoFlGLFramebuffer() {
+    this->release();
+}
+
+void
+SoFlGLFramebuffer::release() {
+    // Objects only exist if the functions were resolved.
+    if (this->fbo) gl.deleteFramebuffers(1, &this->fbo);
+    if (this->depthbuffer) gl.deleteRenderbuffers(1, &this->depthbuffer);
+    if (this->texture) glDeleteTextures(1, &this->texture);
+    this->abandon();
+}
+
+void
+SoFlGLFramebuffer::abandon() {
+    this->fbo = this->texture = this->depthbuffer = 0;
+    this->size = SbVec2s(0, 0);
+    this->valid = false;
+}
+
+bool
+SoFlGLFramebuffer::isSupported() {
+    return gl.available();
+}
+
+bool
+SoFlGLFramebuffer::setSize(const SbVec2s &newsize) {
+    if (newsize == this->size && this->fbo) return this->valid;
+    this->size = newsize;
+    this->valid = false;
+    if (!gl.available() || newsize[0] <= 0 || newsize[1] <= 0) return false;
+
+    if (!this->fbo) gl.genFramebuffers(1, &this->fbo);
+    if (this->texture) glDeleteTextures(1, &this->texture);
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glGenTextures(1, &this->texture);
+    glBindTexture(GL_TEXTURE_2D, this->texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, this->internalformat, newsize[0], newsize[1], 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPopAttrib();
+
+    gl.bindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+    gl.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_TEXTURE_2D, this->texture, 0);
+    if (this->depth) {
+        if (!this->depthbuffer) gl.genRenderbuffers(1, &this->depthbuffer);
+        gl.bindRenderbuffer(GL_RENDERBUFFER, this->depthbuffer);
+        gl.renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, newsize[0], newsize[1]);
+        gl.bindRenderbuffer(GL_RENDERBUFFER, 0);
+        gl.framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                   GL_RENDERBUFFER, this->depthbuffer);
+    }
+    this->valid = gl.checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    gl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+#if SOFL_DEBUG
+    if (!this->valid) {
+        SoDebugError::postWarning("SoFlGLFramebuffer::setSize",
+                                  "incomplete framebuffer (%d x %d)",
+                                  newsize[0], newsize[1]);
+    }
+#endif
+    return this->valid;
+}
+
+const SbVec2s &
+SoFlGLFramebuffer::getSize() const {
+    return this->size;
+}
+
+bool
+SoFlGLFramebuffer::isValid() const {
+    return this->valid;
+}
+
+void
+SoFlGLFramebuffer::bind() {
+    gl.bindFramebuffer(GL_FRAMEBUFFER, this->fbo);
+    glViewport(0, 0, this->size[0], this->size[1]);
+}
+
+void
+SoFlGLFramebuffer::unbind() {
+    if (gl.available()) gl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+unsigned int
+SoFlGLFramebuffer::getTexture() const {
+    return this->texture;
+}
+
+void
+SoFlGLFramebuffer::copyFromBackBuffer() {
+    glPushAttrib(GL_TEXTURE_BIT | GL_PIXEL_MODE_BIT);
+    glReadBuffer(GL_BACK);
+    glBindTexture(GL_TEXTURE_2D, this->texture);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, this->size[0], this->size[1]);
+    glPopAttrib();
+}
+
+// Coin tracks GL state lazily, so everything touched here is put back
+// the way it was found.
+void
+SoFlGLFramebuffer::beginScreenPass(const SbVec2s &size) {
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glViewport(0, 0, size[0], size[1]);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+}
+
+void
+SoFlGLFramebuffer::endScreenPass() {
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glPopAttrib();
+}
+
+// Replaces the target with this buffer's contents.
+void
+SoFlGLFramebuffer::draw() const {
+    glDisable(GL_BLEND);
+    drawTexturedQuad(this->texture);
+}
+
+// Mixes this buffer into the target with the given weight, for
+// running averages.
+void
+SoFlGLFramebuffer::drawBlended(float weight) const {
+    glEnable(GL_BLEND);
+    gl.blendColor(0.0f, 0.0f, 0.0f, weight);
+    glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+    drawTexturedQuad(this->texture);
+    glDisable(GL_BLEND);
+}
+
+// Draws this buffer over the target using its alpha channel.
+void
+SoFlGLFramebuffer::drawOver() const {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    drawTexturedQuad(this->texture);
+    glDisable(GL_BLEND);
+}
@@ -0,0 +1,100 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGLFRAMEBUFFER_H
+#define SOFL_SOFLGLFRAMEBUFFER_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbVec2s.h>
+
+// An offscreen colour buffer (a framebuffer object with a texture
+// attached) in the current GL context, plus the helpers to copy the
+// window's back buffer into it and to draw it back as a screen-sized
+// quad. All members must be called with the owning context current.
+// Owners release() the GL objects before deleting the buffer, or
+// abandon() them if the context is gone already.
+class SoFlGLFramebuffer {
+public:
+    // With 'depth' set, a depth buffer is attached as well, for
+    // rendering into the buffer rather than just copying into it.
+    explicit SoFlGLFramebuffer(int internalformat, bool depth = false);
+    // Releases what is left, so owners must have done it already if
+    // the context is not current.
+    ~SoFlGLFramebuffer();
+
+    // Deletes the GL objects; the buffer can be set up again.
+    void release();
+    // Forgets the GL objects without deleting them, for when their
+    // context has been destroyed together with them.
+    void abandon();
+
+    // True if framebuffer objects can be used in the current context.
+    static bool isSupported();
+
+    // (Re)creates the buffer for the given size. Returns false if the
+    // framebuffer is not usable.
+    bool setSize(const SbVec2s & size);
+    const SbVec2s & getSize() const;
+    bool isValid() const;
+
+    void bind();
+    static void unbind();
+
+    unsigned int getTexture() const;
+    void copyFromBackBuffer();
+
+    // Screen-space drawing: beginScreenPass() saves the GL state Coin
+    // expects to find again and sets up an identity projection.
+    static void beginScreenPass(const SbVec2s & size);
+    static void endScreenPass();
+    void draw() const;
+    void drawBlended(float weight) const;
+    void drawOver() const;
+
+private:
+    SoFlGLFramebuffer(const SoFlGLFramebuffer &) = delete;
+    SoFlGLFramebuffer & operator=(const SoFlGLFramebuffer &) = delete;
+
+    int internalformat;
+    bool depth;
+    SbVec2s size;
+    bool valid;
+    unsigned int fbo;
+    unsigned int texture;
+    unsigned int depthbuffer;
+};
+
+#endif //SOFL_SOFLGLFRAMEBUFFER_H
@@ -0,0 +1,113 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLOverlay.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
+
+#include <GL/gl.h>
+
+#include "sofldefs.h"
+
+SoFlGLOverlay::SoFlGLOverlay(SoFlGLWidgetP *o)
+    : owner(o),
+      scenecache(new SoFlGLFramebuffer(GL_RGBA8)),
+      overlaybuffer(new SoFlGLFramebuffer(GL_RGBA8)),
+      lockdepth(0),
+      scenecached(false),
+      hascontent(false) {
+}
+
+SoFlGLOverlay::~SoFlGLOverlay() {
+    this->owner->releaseFramebuffers({this->scenecache, this->overlaybuffer});
+    delete this->scenecache;
+    delete this->overlaybuffer;
+}
+
+bool
+SoFlGLOverlay::hasContent() const {
+    return this->hascontent;
+}
+
+bool
+SoFlGLOverlay::begin() {
+    if (this->lockdepth++ > 0) return this->overlaybuffer->isValid();
+    if (!this->overlaybuffer->setSize(this->owner->glSize)) return false;
+
+    this->overlaybuffer->bind();
+    // Whatever the overlay scene does not cover has to stay see-through.
+    glPushAttrib(GL_COLOR_BUFFER_BIT);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glPopAttrib();
+    return true;
+}
+
+void
+SoFlGLOverlay::end() {
+    if (this->lockdepth == 0 || --this->lockdepth > 0) return;
+    SoFlGLFramebuffer::unbind();
+    if (!this->overlaybuffer->isValid()) return;
+    this->hascontent = true;
+
+    // Until the main scene has been drawn once there is nothing to put
+    // the overlay on; it is picked up with the next regular frame.
+    if (!this->scenecached || this->scenecache->getSize() != this->overlaybuffer->getSize()) return;
+
+    SoFlGLFramebuffer::beginScreenPass(this->scenecache->getSize());
+    glDrawBuffer(GL_BACK);
+    this->scenecache->draw();
+    this->overlaybuffer->drawOver();
+    SoFlGLFramebuffer::endScreenPass();
+    this->owner->currentglarea->swap_buffers();
+}
+
+void
+SoFlGLOverlay::captureScene() {
+    if (!this->scenecache->setSize(this->owner->glSize)) return;
+    this->scenecache->copyFromBackBuffer();
+    this->scenecached = true;
+}
+
+void
+SoFlGLOverlay::composite() {
+    if (!this->hascontent || this->overlaybuffer->getSize() != this->owner->glSize) return;
+    SoFlGLFramebuffer::beginScreenPass(this->overlaybuffer->getSize());
+    this->overlaybuffer->drawOver();
+    SoFlGLFramebuffer::endScreenPass();
+}
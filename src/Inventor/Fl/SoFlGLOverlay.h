@@ -0,0 +1,75 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGLOVERLAY_H
+#define SOFL_SOFLGLOVERLAY_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+class SoFlGLFramebuffer;
+class SoFlGLWidgetP;
+
+// Overlay planes emulated with offscreen buffers. The overlay scene is
+// rendered into its own transparent buffer, and the last main-scene
+// frame is kept in a texture, so an overlay-only change is presented
+// by drawing the cached scene and the overlay on top of it instead of
+// re-rendering the main scene.
+class SoFlGLOverlay {
+public:
+    explicit SoFlGLOverlay(SoFlGLWidgetP * owner);
+    ~SoFlGLOverlay();
+
+    // Bracket overlay rendering; the outermost end() presents the
+    // composited frame. Must be called with the normal context current.
+    bool begin();
+    void end();
+
+    // Called on every main-scene frame before it is swapped: caches the
+    // back buffer and draws the overlay over it.
+    void captureScene();
+    void composite();
+
+    bool hasContent() const;
+
+private:
+    SoFlGLWidgetP * owner;
+    SoFlGLFramebuffer * scenecache;
+    SoFlGLFramebuffer * overlaybuffer;
+    int lockdepth;
+    bool scenecached;
+    bool hascontent;
+};
+
+#endif //SOFL_SOFLGLOVERLAY_H
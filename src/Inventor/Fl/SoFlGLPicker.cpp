@@ -0,0 +1,416 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLPicker.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/SoFlRenderArea.h"
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
+
+#include <Inventor/SbColor.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoSubAction.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/elements/SoGLCacheContextElement.h>
+#include <Inventor/elements/SoLazyElement.h>
+#include <Inventor/elements/SoLightModelElement.h>
+#include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoMultiTextureEnabledElement.h>
+#include <Inventor/elements/SoOverrideElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/misc/SoContextHandler.h>
+#include <Inventor/misc/SoState.h>
+#include <Inventor/nodes/SoShape.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <climits>
+
+#include "sofldefs.h"
+
+#define PUBLIC(obj) ((obj)->pub)
+
+namespace {
+
+    // How far around a point pick to look for a shape, in pixels, so
+    // that lines and points do not have to be hit exactly.
+    const int PICK_RADIUS = 3;
+
+    // IDs are stored in the 24 bits of an RGB8 pixel; 0 is background.
+    const size_t MAX_SHAPES = 0xffffff;
+
+    bool
+    sameVolume(const SbViewVolume &a, const SbViewVolume &b) {
+        return a.getProjectionType() == b.getProjectionType() &&
+               a.getNearDist() == b.getNearDist() &&
+               a.getDepth() == b.getDepth() &&
+               a.getMatrix() == b.getMatrix();
+    }
+
+    // Renders every shape in a flat colour that encodes its index in
+    // 'shapes', one more than the index so the cleared background reads
+    // as no shape. Lighting, textures, transparency and per-vertex
+    // colours are overridden for the shape only, so the scene's own
+    // state is traversed unchanged.
+    class SoFlIDRenderAction : public SoGLRenderAction {
+        SO_ACTION_HEADER(SoFlIDRenderAction);
+
+    public:
+        static void initClass();
+        SoFlIDRenderAction(const SbViewportRegion & viewport,
+                           SoFlGLPicker::Shapes & shapes);
+
+    private:
+        static void shapeCB(SoAction * action, SoNode * node);
+
+        SoFlGLPicker::Shapes & shapes;
+        SoColorPacker packer;
+    };
+
+    SO_ACTION_SOURCE(SoFlIDRenderAction);
+
+    void
+    SoFlIDRenderAction::initClass() {
+        SO_ACTION_INIT_CLASS(SoFlIDRenderAction, SoGLRenderAction);
+        SO_ACTION_ADD_METHOD(SoShape, SoFlIDRenderAction::shapeCB);
+    }
+
+    SoFlIDRenderAction::SoFlIDRenderAction(const SbViewportRegion &viewport,
+                                           SoFlGLPicker::Shapes &s)
+        : SoGLRenderAction(viewport),
+          shapes(s) {
+        SO_ACTION_CONSTRUCTOR(SoFlIDRenderAction);
+    }
+
+    void
+    SoFlIDRenderAction::shapeCB(SoAction *action, SoNode *node) {
+        SoFlIDRenderAction *thisp = static_cast<SoFlIDRenderAction *>(action);
+        SoState *state = action->getState();
+
+        // A render cache would replay the shape without it being
+        // recorded here, so none may be built from this pass.
+        SoCacheElement::invalidate(state);
+        SoFlGLPicker::Shapes &shapes = thisp->shapes;
+        if (shapes.size() >= MAX_SHAPES) return;
+
+        // Shapes can be seen through cameras of their own, e.g. in
+        // overlays; consecutive shapes mostly share one.
+        const SbViewVolume &volume = SoViewVolumeElement::get(state);
+        if (shapes.volumes.empty() || !sameVolume(shapes.volumes.back(), volume)) {
+            shapes.volumes.push_back(volume);
+        }
+        shapes.volume.push_back(static_cast<unsigned int>(shapes.volumes.size() - 1));
+
+        const SoFullPath *path = static_cast<const SoFullPath *>(action->getCurPath());
+        shapes.first.push_back(shapes.indices.size());
+        for (int i = 1; i < path->getLength(); i++) shapes.indices.push_back(path->getIndex(i));
+
+        const uint32_t id = static_cast<uint32_t>(shapes.size());
+        const SbColor color(((id >> 16) & 0xff) / 255.0f,
+                            ((id >> 8) & 0xff) / 255.0f,
+                            (id & 0xff) / 255.0f);
+        const float opaque = 0.0f;
+
+        state->push();
+        SoLightModelElement::set(state, node, SoLightModelElement::BASE_COLOR);
+        SoOverrideElement::setLightModelOverride(state, node, TRUE);
+        SoLazyElement::setDiffuse(state, node, 1, &color, &thisp->packer);
+        SoOverrideElement::setDiffuseColorOverride(state, node, TRUE);
+        SoLazyElement::setTransparency(state, node, 1, &opaque, &thisp->packer);
+        SoOverrideElement::setTransparencyOverride(state, node, TRUE);
+        SoMaterialBindingElement::set(state, node, SoMaterialBindingElement::OVERALL);
+        SoOverrideElement::setMaterialBindingOverride(state, node, TRUE);
+        SoMultiTextureEnabledElement::disableAll(state);
+        SoNode::GLRenderS(action, node);
+        state->pop();
+    }
+
+    uint32_t decode(const unsigned char *pixel) {
+        return (uint32_t(pixel[0]) << 16) | (uint32_t(pixel[1]) << 8) | pixel[2];
+    }
+
+    // The point in the scene that a pixel and its depth buffer value
+    // came from. Goes through the eye distance rather than inverting
+    // the projection matrix, which loses too much precision in floats.
+    SbVec3f unproject(const SbViewVolume &volume, const SbViewportRegion &viewport,
+                      int x, int y, float depth) {
+        const SbVec2s origin = viewport.getViewportOriginPixels();
+        const SbVec2s size = viewport.getViewportSizePixels();
+        const SbVec2f normalized((x + 0.5f - origin[0]) / size[0],
+                                 (y + 0.5f - origin[1]) / size[1]);
+        const float nearplane = volume.getNearDist();
+        const float farplane = nearplane + volume.getDepth();
+        float distance;
+        if (volume.getProjectionType() == SbViewVolume::PERSPECTIVE) {
+            distance = nearplane * farplane / (farplane - depth * (farplane - nearplane));
+        } else {
+            distance = nearplane + depth * (farplane - nearplane);
+        }
+        return volume.getPlanePoint(distance, normalized);
+    }
+
+} // namespace
+
+SoFlGLPicker::SoFlGLPicker(SoFlGLWidgetP *o)
+    : owner(o),
+      sensor(new SoNodeSensor(SoFlGLPicker::changedCB, this)),
+      buffer(new SoFlGLFramebuffer(GL_RGBA8, true)),
+      cachecontext(SoGLCacheContextElement::getUniqueCacheContext()),
+      valid(false) {
+    if (SoFlIDRenderAction::getClassTypeId() == SoType::badType()) {
+        SoFlIDRenderAction::initClass();
+    }
+    // Immediate, so a pick right after a change in the same event
+    // already sees it.
+    this->sensor->setPriority(0);
+}
+
+// The GL area is still around when the GL widget deletes its private
+// data. Once it is hidden its GL context, and everything cached for
+// the picker in it, is gone already.
+SoFlGLPicker::~SoFlGLPicker() {
+    SoFlGLArea *glarea = this->owner->currentglarea;
+    if (glarea && glarea->shown()) {
+        PUBLIC(this->owner)->glLockNormal();
+        SoContextHandler::destructingContext(this->cachecontext);
+        this->buffer->release();
+        PUBLIC(this->owner)->glUnlockNormal();
+    }
+    else {
+        this->buffer->abandon();
+    }
+    delete this->sensor;
+    delete this->buffer;
+    this->clearPaths();
+}
+
+void
+SoFlGLPicker::Shapes::clear() {
+    this->indices.clear();
+    this->first.clear();
+    this->volume.clear();
+    this->volumes.clear();
+}
+
+void
+SoFlGLPicker::invalidate() {
+    this->valid = false;
+}
+
+void
+SoFlGLPicker::clearPaths() {
+    for (SoPath *path : this->paths) {
+        if (path) path->unref();
+    }
+    this->paths.clear();
+    this->shapes.clear();
+}
+
+// The path of shape 'id', built from its child indices the first time
+// it is picked.
+SoPath *
+SoFlGLPicker::getPath(uint32_t id) {
+    SoPath *&path = this->paths[id - 1];
+    if (path) return path;
+
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this->owner));
+    path = new SoPath(area->getSceneManager()->getSceneGraph());
+    path->ref();
+    const size_t end = id < this->shapes.size() ? this->shapes.first[id] : this->shapes.indices.size();
+    for (size_t i = this->shapes.first[id - 1]; i < end; i++) path->append(this->shapes.indices[i]);
+    return path;
+}
+
+void
+SoFlGLPicker::changedCB(void *closure, SoSensor *) {
+    static_cast<SoFlGLPicker *>(closure)->invalidate();
+}
+
+// The scene manager's root holds the camera too, so this catches
+// camera moves as well as scene changes.
+void
+SoFlGLPicker::attach() {
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this->owner));
+    SoNode *root = area->getSceneManager()->getSceneGraph();
+    if (this->sensor->getAttachedNode() == root) return;
+
+    this->sensor->detach();
+    if (root) this->sensor->attach(root);
+    this->invalidate();
+}
+
+// Makes the context current and brings the ID buffer up to date.
+// Returns false, with the context released again, if there is nothing
+// to pick from.
+bool
+SoFlGLPicker::update() {
+    SoFlGLArea *glarea = this->owner->currentglarea;
+    if (!glarea || !glarea->shown()) return false;
+
+    PUBLIC(this->owner)->glLockNormal();
+    this->attach();
+    if (this->buffer->getSize() != this->owner->glSize) this->invalidate();
+    if (!this->buffer->setSize(this->owner->glSize)) {
+        PUBLIC(this->owner)->glUnlockNormal();
+        return false;
+    }
+    if (!this->valid) this->render();
+    return true;
+}
+
+void
+SoFlGLPicker::render() {
+    this->clearPaths();
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this->owner));
+    SoNode *root = area->getSceneManager()->getSceneGraph();
+    this->viewport = area->getViewportRegion();
+
+    this->buffer->bind();
+    // Coin tracks GL state lazily; leave it the way it was found.
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    glDisable(GL_DITHER);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (root) {
+        SoFlIDRenderAction action(this->viewport, this->shapes);
+        // A context of its own, so the render caches built by the normal
+        // frames, colours and all, are not replayed here.
+        action.setCacheContext(this->cachecontext);
+        action.setTransparencyType(SoGLRenderAction::NONE);
+        action.apply(root);
+    }
+    glPopAttrib();
+    SoFlGLFramebuffer::unbind();
+    this->paths.assign(this->shapes.size(), nullptr);
+    this->valid = true;
+
+#if SOFL_DEBUG
+    SoDebugError::postInfo("SoFlGLPicker::render",
+                           "%d shapes", static_cast<int>(this->shapes.size()));
+#endif
+}
+
+SoPath *
+SoFlGLPicker::pick(const SbVec2s &pos, SbVec3f *point) {
+    if (!this->update()) return nullptr;
+
+    const SbVec2s &size = this->buffer->getSize();
+    const int x0 = std::max(pos[0] - PICK_RADIUS, 0);
+    const int y0 = std::max(pos[1] - PICK_RADIUS, 0);
+    const int x1 = std::min(pos[0] + PICK_RADIUS, size[0] - 1);
+    const int y1 = std::min(pos[1] + PICK_RADIUS, size[1] - 1);
+    if (x1 < x0 || y1 < y0) {
+        PUBLIC(this->owner)->glUnlockNormal();
+        return nullptr;
+    }
+
+    const int width = x1 - x0 + 1;
+    const int height = y1 - y0 + 1;
+    std::vector<unsigned char> pixels(width * height * 4);
+    this->buffer->bind();
+    glReadPixels(x0, y0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    // The shape closest to the point wins.
+    uint32_t id = 0;
+    int bestx = 0, besty = 0, bestdistance = INT_MAX;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint32_t candidate = decode(&pixels[(y * width + x) * 4]);
+            if (!candidate || candidate > this->paths.size()) continue;
+            const int dx = x0 + x - pos[0];
+            const int dy = y0 + y - pos[1];
+            if (dx * dx + dy * dy < bestdistance) {
+                bestdistance = dx * dx + dy * dy;
+                id = candidate;
+                bestx = x0 + x;
+                besty = y0 + y;
+            }
+        }
+    }
+    if (id && point) {
+        float depth = 1.0f;
+        glReadPixels(bestx, besty, 1, 1, GL_DEPTH_COMPONENT, GL_FLOAT, &depth);
+        const SbViewVolume &volume = this->shapes.volumes[this->shapes.volume[id - 1]];
+        *point = unproject(volume, this->viewport, bestx, besty, depth);
+    }
+    SoFlGLFramebuffer::unbind();
+    PUBLIC(this->owner)->glUnlockNormal();
+    return id ? this->getPath(id) : nullptr;
+}
+
+int
+SoFlGLPicker::pick(const SbBox2s &rect, SoPathList &found) {
+    if (rect.isEmpty() || !this->update()) return 0;
+
+    const SbVec2s &size = this->buffer->getSize();
+    const int x0 = std::max<int>(rect.getMin()[0], 0);
+    const int y0 = std::max<int>(rect.getMin()[1], 0);
+    const int x1 = std::min<int>(rect.getMax()[0], size[0] - 1);
+    const int y1 = std::min<int>(rect.getMax()[1], size[1] - 1);
+    if (x1 < x0 || y1 < y0) {
+        PUBLIC(this->owner)->glUnlockNormal();
+        return 0;
+    }
+
+    const int width = x1 - x0 + 1;
+    const int height = y1 - y0 + 1;
+    std::vector<unsigned char> pixels(width * height * 4);
+    this->buffer->bind();
+    glReadPixels(x0, y0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    SoFlGLFramebuffer::unbind();
+    PUBLIC(this->owner)->glUnlockNormal();
+
+    std::vector<bool> seen(this->paths.size() + 1, false);
+    int count = 0;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        const uint32_t id = decode(&pixels[i]);
+        if (!id || id > this->paths.size() || seen[id]) continue;
+        seen[id] = true;
+        found.append(this->getPath(id));
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,111 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLGLPICKER_H
+#define SOFL_SOFLGLPICKER_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbBox2s.h>
+#include <Inventor/SbVec2s.h>
+#include <Inventor/SbVec3f.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SbViewportRegion.h>
+
+#include <vector>
+
+class SoFlGLFramebuffer;
+class SoFlGLWidgetP;
+class SoNodeSensor;
+class SoPath;
+class SoPathList;
+class SoSensor;
+
+// Picking by reading back an ID buffer instead of intersecting rays
+// with the scene. The scene is rendered offscreen with every shape in
+// a flat colour encoding its index, together with depth; the buffer is
+// kept until the scene, the camera or the viewport changes, so picks
+// against an unchanged view only read back a few pixels. Paths are only
+// built for the shapes that are picked.
+class SoFlGLPicker {
+public:
+    // What the ID buffer was rendered from. For every shape: where the
+    // child indices of its path from the root start in 'indices', and
+    // which of 'volumes' it was rendered with.
+    struct Shapes {
+        std::vector<int> indices;
+        std::vector<size_t> first;
+        std::vector<unsigned int> volume;
+        std::vector<SbViewVolume> volumes;
+
+        size_t size() const { return this->first.size(); }
+        void clear();
+    };
+
+    explicit SoFlGLPicker(SoFlGLWidgetP * owner);
+    ~SoFlGLPicker();
+
+    // Forces the ID buffer to be rendered again on the next pick.
+    void invalidate();
+
+    // The shape nearest to 'pos', in pixels from the lower left corner
+    // of the viewport, within a few pixels. Writes the picked point to
+    // 'point' if given. The path belongs to the picker: it is valid
+    // until the next scene or camera change, ref() it to keep it.
+    SoPath * pick(const SbVec2s & pos, SbVec3f * point);
+
+    // Appends the paths of all shapes visible in 'rect' to 'paths', and
+    // returns how many were found.
+    int pick(const SbBox2s & rect, SoPathList & paths);
+
+private:
+    static void changedCB(void * closure, SoSensor * sensor);
+    bool update();
+    void render();
+    void attach();
+    void clearPaths();
+    SoPath * getPath(uint32_t id);
+
+    SoFlGLWidgetP * owner;
+    SoNodeSensor * sensor;
+    SoFlGLFramebuffer * buffer;
+    uint32_t cachecontext;
+    Shapes shapes;
+    // Paths built so far, by shape.
+    std::vector<SoPath *> paths;
+    SbViewportRegion viewport;
+    bool valid;
+};
+
+#endif //SOFL_SOFLGLPICKER_H
@@ -0,0 +1,275 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGLStereo.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/viewers/SoFlViewer.h"
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/nodes/SoCamera.h>
+
+#include <GL/gl.h>
+
+#include <chrono>
+
+#include "sofldefs.h"
+
+#define PUBLIC(obj) ((obj)->pub)
+
+namespace {
+
+    float
+    millisecondsSince(const std::chrono::steady_clock::time_point &start) {
+        return std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+SoFlGLStereo::SoFlGLStereo(SoFlGLWidgetP *o)
+    : owner(o),
+      action(nullptr),
+      prevabortcb(nullptr),
+      prevabortdata(nullptr),
+      eyeaction(nullptr),
+      firsteye(new SoFlGLFramebuffer(GL_RGBA8)),
+      mode(NONE),
+      pending(false),
+      rowparity(-1),
+      firsteyetime(0.0f),
+      secondeyetime(0.0f) {
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this->owner));
+    this->eyeaction = new SoGLRenderAction(viewer->getGLRenderAction()->getViewportRegion());
+    this->attach(viewer->getGLRenderAction());
+}
+
+// As with partial redraws, the viewer's render action is already gone
+// when the GL widget tears down its private data, so the callbacks are
+// only removed in release().
+SoFlGLStereo::~SoFlGLStereo() {
+    delete this->eyeaction;
+    this->owner->releaseFramebuffers({this->firsteye});
+    delete this->firsteye;
+}
+
+void
+SoFlGLStereo::attach(SoGLRenderAction *a) {
+    this->action = a;
+    this->action->getAbortCallback(this->prevabortcb, this->prevabortdata);
+    this->action->addPreRenderCallback(SoFlGLStereo::preRenderCB, this);
+    this->action->setAbortCallback(SoFlGLStereo::abortCB, this);
+    // The application's callback gets to abort the eyes as well.
+    this->eyeaction->setAbortCallback(this->prevabortcb, this->prevabortdata);
+}
+
+void
+SoFlGLStereo::release() {
+    if (!this->action) return;
+    this->action->removePreRenderCallback(SoFlGLStereo::preRenderCB, this);
+    this->action->setAbortCallback(this->prevabortcb, this->prevabortdata);
+    this->action = nullptr;
+    this->prevabortcb = nullptr;
+    this->prevabortdata = nullptr;
+}
+
+// The scene manager deletes the render action it is replacing if it
+// owned it, so the old pointer is dropped without being touched.
+void
+SoFlGLStereo::updateAction() {
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this->owner));
+    SoGLRenderAction *current = viewer->getGLRenderAction();
+    if (!this->action || current == this->action) return;
+    this->pending = false;
+    this->attach(current);
+}
+
+void
+SoFlGLStereo::setMode(Mode m) {
+    this->mode = m;
+    this->firsteyetime = this->secondeyetime = 0.0f;
+}
+
+SoFlGLStereo::Mode
+SoFlGLStereo::getMode() const {
+    return this->mode;
+}
+
+float
+SoFlGLStereo::getFirstEyeTime() const {
+    return this->firsteyetime;
+}
+
+float
+SoFlGLStereo::getSecondEyeTime() const {
+    return this->secondeyetime;
+}
+
+void
+SoFlGLStereo::preRenderCB(void *closure, SoGLRenderAction *) {
+    static_cast<SoFlGLStereo *>(closure)->pending = true;
+}
+
+// Called for every node the viewer's render action is about to
+// traverse; the first one of a frame is the root. The action is also
+// applied to superimpositions, which are left to render as they are.
+SoGLRenderAction::AbortCode
+SoFlGLStereo::abortCB(void *closure) {
+    SoFlGLStereo *thisp = static_cast<SoFlGLStereo *>(closure);
+    const SoGLRenderAction::AbortCode code =
+        thisp->prevabortcb ? thisp->prevabortcb(thisp->prevabortdata) : SoGLRenderAction::CONTINUE;
+    if (!thisp->pending || code != SoGLRenderAction::CONTINUE) {
+        thisp->pending = false;
+        return code;
+    }
+    thisp->pending = false;
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(thisp->owner));
+    const SoPath *path = thisp->action->getCurPath();
+    if (!path || path->getLength() == 0 ||
+        path->getHead() != viewer->getSceneManager()->getSceneGraph()) {
+        return code;
+    }
+    return thisp->renderEyes() ? SoGLRenderAction::ABORT : SoGLRenderAction::CONTINUE;
+}
+
+bool
+SoFlGLStereo::renderEyes() {
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this->owner));
+    SoCamera *camera = viewer->getCamera();
+    if (this->mode == NONE || !camera || viewer->isStereoViewing()) return false;
+
+    const SbViewportRegion &full = this->action->getViewportRegion();
+    const SbVec2s origin = full.getViewportOriginPixels();
+    const SbVec2s size = full.getViewportSizePixels();
+    if (size[0] < 2 || size[1] < 2) return false;
+
+    if (this->mode == INTERLACED &&
+        (!SoFlGLFramebuffer::isSupported() || !this->firsteye->setSize(full.getWindowSize()))) {
+#if SOFL_DEBUG
+        SoDebugError::postWarning("SoFlGLStereo::renderEyes",
+                                  "framebuffer objects not available, "
+                                  "interlaced stereo disabled");
+#endif
+        this->mode = NONE;
+        return false;
+    }
+
+    // The eyes share the viewer's caches and render settings.
+    this->eyeaction->setCacheContext(this->action->getCacheContext());
+    this->eyeaction->setTransparencyType(this->action->getTransparencyType());
+    this->eyeaction->setSmoothing(this->action->isSmoothing());
+    this->eyeaction->setNumPasses(this->action->getNumPasses());
+
+    camera->setStereoAdjustment(viewer->getStereoOffset());
+
+    SbViewportRegion eyes[2] = { full, full };
+    const short halfwidth = size[0] / 2;
+    const short halfheight = size[1] / 2;
+    if (this->mode == SIDE_BY_SIDE) {
+        eyes[0].setViewportPixels(origin[0], origin[1], halfwidth, size[1]);
+        eyes[1].setViewportPixels(origin[0] + halfwidth, origin[1],
+                                  size[0] - halfwidth, size[1]);
+    } else if (this->mode == TOP_BOTTOM) {
+        eyes[0].setViewportPixels(origin[0], origin[1] + halfheight,
+                                  size[0], size[1] - halfheight);
+        eyes[1].setViewportPixels(origin[0], origin[1], size[0], halfheight);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    this->renderEye(0, eyes[0]);
+    this->firsteyetime = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    this->renderEye(1, eyes[1]);
+    this->secondeyetime = millisecondsSince(start);
+
+    if (this->mode == INTERLACED) this->interlace(full.getWindowSize());
+
+    camera->setStereoMode(SoCamera::MONOSCOPIC);
+    return true;
+}
+
+void
+SoFlGLStereo::renderEye(int eye, const SbViewportRegion &region) {
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this->owner));
+    viewer->getCamera()->setStereoMode(eye == 0 ? SoCamera::LEFT_VIEW : SoCamera::RIGHT_VIEW);
+
+    if (this->mode == ANAGLYPH) {
+        if (eye == 0) glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
+        else glColorMask(GL_FALSE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+    // The viewer has cleared the window for the first eye. In the full
+    // window modes the second eye needs a depth buffer of its own, and
+    // when interlacing, with the first eye copied away, a clear image.
+    if (eye == 1 && (this->mode == ANAGLYPH || this->mode == INTERLACED)) {
+        glClear(this->mode == ANAGLYPH ? GL_DEPTH_BUFFER_BIT
+                                       : GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    this->eyeaction->setViewportRegion(region);
+    this->eyeaction->apply(viewer->getSceneManager()->getSceneGraph());
+
+    if (this->mode == ANAGLYPH) glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    if (this->mode == INTERLACED && eye == 0) this->firsteye->copyFromBackBuffer();
+}
+
+// Puts the first eye back on every other row in one pass, masked by a
+// polygon stipple. The left eye goes on the even rows of the screen,
+// not of the window, so the parity follows the window's position.
+void
+SoFlGLStereo::interlace(const SbVec2s &window) {
+    const SoFlGLArea *area = this->owner->currentglarea;
+    const int top = area ? area->y_root() + area->h() - 1 : window[1] - 1;
+    const int parity = top & 1;
+    if (parity != this->rowparity) {
+        // The stipple is aligned to window coordinates, counted from
+        // the bottom row.
+        for (int row = 0; row < 32; ++row) {
+            const unsigned char bits = (row & 1) == parity ? 0xff : 0x00;
+            for (int byte = 0; byte < 4; ++byte) this->rowmask[row * 4 + byte] = bits;
+        }
+        this->rowparity = parity;
+    }
+
+    SoFlGLFramebuffer::beginScreenPass(window);
+    glPolygonStipple(this->rowmask);
+    glEnable(GL_POLYGON_STIPPLE);
+    this->firsteye->draw();
+    SoFlGLFramebuffer::endScreenPass();
+}
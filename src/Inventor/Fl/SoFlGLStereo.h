@@ -0,0 +1,109 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLGLSTEREO_H
+#define SOFL_SOFLGLSTEREO_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/actions/SoGLRenderAction.h>
+
+class SbVec2s;
+class SbViewportRegion;
+class SoFlGLFramebuffer;
+class SoFlGLWidgetP;
+
+// Stereo in an ordinary double buffered visual: both eyes of a viewer
+// are rendered into the back buffer of one frame, side by side, one
+// above the other, as a red/cyan anaglyph or in alternating rows.
+//
+// The viewer renders a frame the way it always does. Its GL render
+// action's abort callback takes over at the root of that traversal,
+// renders the two eyes and aborts the monoscopic pass, so the scene is
+// traversed once per eye and not once more. Both eyes are rendered
+// with one render action in the viewer's cache context, so the second
+// eye replays the render caches and reuses the bounding box caches the
+// first eye has just validated. An abort callback the application had
+// set is chained, and is put back when stereo is turned off.
+class SoFlGLStereo {
+public:
+    enum Mode {
+        NONE,
+        SIDE_BY_SIDE,
+        TOP_BOTTOM,
+        ANAGLYPH,
+        INTERLACED
+    };
+
+    explicit SoFlGLStereo(SoFlGLWidgetP * owner);
+    ~SoFlGLStereo();
+
+    // Detaches from the viewer's GL render action.
+    void release();
+    // Moves the callbacks over if the viewer has been given another GL
+    // render action. Called before every redraw.
+    void updateAction();
+
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    // Wall clock time, in milliseconds, the last frame spent issuing
+    // each eye's traversal. The interlacing composite is not included.
+    float getFirstEyeTime() const;
+    float getSecondEyeTime() const;
+
+private:
+    static void preRenderCB(void * closure, SoGLRenderAction * action);
+    static SoGLRenderAction::AbortCode abortCB(void * closure);
+    void attach(SoGLRenderAction * action);
+    bool renderEyes();
+    void renderEye(int eye, const SbViewportRegion & region);
+    void interlace(const SbVec2s & window);
+
+    SoFlGLWidgetP * owner;
+    SoGLRenderAction * action;
+    SoGLRenderAbortCB * prevabortcb;
+    void * prevabortdata;
+    SoGLRenderAction * eyeaction;
+    SoFlGLFramebuffer * firsteye;
+    Mode mode;
+    bool pending;
+    // Polygon stipple covering the rows the first eye goes on.
+    unsigned char rowmask[128];
+    int rowparity;
+    float firsteyetime;
+    float secondeyetime;
+};
+
+#endif //SOFL_SOFLGLSTEREO_H
@@ -35,6 +35,10 @@
 #include <GL/gl.h>
 
 #include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/SoFlGLAccumulator.h"
+#include "Inventor/Fl/SoFlGLDamage.h"
+#include "Inventor/Fl/SoFlGLOverlay.h"
+#include "Inventor/Fl/SoFlMultiViewRenderArea.h"
 #include "Inventor/Fl/widgets/SoFlGLArea.h"
 #include "sofldefs.h"
 #include "Inventor/Fl/SoAny.h"
@@ -152,6 +156,7 @@ SoFlGLWidget::glLockNormal()
 {
     assert(PRIVATE(this)->currentglarea != nullptr);
     PRIVATE(this)->currentglarea->makeCurrent();
+    PRIVATE(this)->applyMultisampleState();
 }
 
 void
@@ -163,18 +168,37 @@ SoFlGLWidget::glUnlockNormal()
 void
 SoFlGLWidget::glLockOverlay()
 {
-    SOFL_STUB();
+    if (!PRIVATE(this)->overlay) return;
+    this->glLockNormal();
+    if (!PRIVATE(this)->overlaylayer) {
+        PRIVATE(this)->overlaylayer = new SoFlGLOverlay(PRIVATE(this));
+        PRIVATE(this)->overlaylayer->begin();
+        this->initOverlayGraphic();
+        return;
+    }
+    PRIVATE(this)->overlaylayer->begin();
 }
 
 void
 SoFlGLWidget::glUnlockOverlay()
 {
-    SOFL_STUB();
+    if (!PRIVATE(this)->overlaylayer) return;
+    PRIVATE(this)->overlaylayer->end();
 }
 
 void
 SoFlGLWidget::glSwapBuffers()
 {
+    if (PRIVATE(this)->damage) PRIVATE(this)->damage->endFrame();
+    SoFlGLOverlay *overlay = PRIVATE(this)->overlaylayer;
+    if (overlay) overlay->captureScene();
+    // A still frame is the first pass of the progressive refinement.
+    if (PRIVATE(this)->accumulator) {
+        if (PRIVATE(this)->interacting) PRIVATE(this)->accumulator->stop();
+        else PRIVATE(this)->accumulator->restart();
+    }
+    if (overlay) overlay->composite();
+    PRIVATE(this)->paceFrame();
     PRIVATE(this)->currentglarea->swap_buffers();
 }
 
@@ -237,14 +261,23 @@ SoFlGLWidget::isDrawToFrontBufferEnable() const
 void
 SoFlGLWidget::setAccumulationBuffer(const SbBool enable)
 {
-    SOFL_STUB();
+    // Accumulation is done in a framebuffer object rather than in an
+    // accumulation buffer visual, so no GL widget rebuild is needed.
+    if (enable && !PRIVATE(this)->accumulator) {
+        // Passes are rendered through the scene manager, which knows
+        // nothing of the views of a multi-view render area.
+        if (this->isOfType(SoFlMultiViewRenderArea::getClassTypeId())) return;
+        PRIVATE(this)->accumulator = new SoFlGLAccumulator(PRIVATE(this));
+    } else if (!enable && PRIVATE(this)->accumulator) {
+        delete PRIVATE(this)->accumulator;
+        PRIVATE(this)->accumulator = nullptr;
+    }
 }
 
 SbBool
 SoFlGLWidget::getAccumulationBuffer() const
 {
-    SOFL_STUB();
-    return (FALSE);
+    return (PRIVATE(this)->accumulator != nullptr);
 }
 
 void
@@ -289,14 +322,27 @@ SoFlGLWidget::isOverlayRender() const
 void
 SoFlGLWidget::setSampleBuffers(const int numsamples)
 {
-    SOFL_STUB();
+    const int samples = (numsamples > 1) ? numsamples : 0;
+    if (samples == PRIVATE(this)->numsamples) return;
+
+    PRIVATE(this)->numsamples = samples;
+    int modes = PRIVATE(this)->gl_attributes & ~FL_MULTISAMPLE;
+    if (samples) modes |= FL_MULTISAMPLE;
+    PRIVATE(this)->gl_attributes = static_cast<Fl_Mode>(modes);
+
+    // The sample count is a property of the visual, so switching it
+    // at runtime means a new GL widget.
+    if (PRIVATE(this)->currentglwidget) {
+        PRIVATE(this)->buildGLWidget();
+    }
 }
 
 int
 SoFlGLWidget::getSampleBuffers() const
 {
-    SOFL_STUB();
-    return (0);
+    const SoFlGLArea *area = PRIVATE(this)->currentglarea;
+    if (area && area->context()) return (area->getGrantedSamples());
+    return (PRIVATE(this)->numsamples);
 }
 
 Fl_Window *
@@ -315,15 +361,15 @@ SoFlGLWidget::getNormalWidget() const
 Fl_Window *
 SoFlGLWidget::getOverlayWidget() const
 {
-    SOFL_STUB();
-    return (nullptr);
+    // Overlays are drawn in the normal GL widget.
+    if (!PRIVATE(this)->overlay) return (nullptr);
+    return (PRIVATE(this)->currentglwidget);
 }
 
 SbBool
 SoFlGLWidget::hasOverlayGLArea() const
 {
-    SOFL_STUB();
-    return (false);
+    return (PRIVATE(this)->overlay && PRIVATE(this)->currentglwidget != nullptr);
 }
 
 SbBool
@@ -337,7 +383,7 @@ SoFlGLWidget::hasNormalGLArea() const
 unsigned long
 SoFlGLWidget::getOverlayTransparentPixel()
 {
-    SOFL_STUB();
+    // The overlay buffer is cleared to zero, alpha included.
     return (0);
 }
 
@@ -367,7 +413,7 @@ SoFlGLWidget::buildWidget(Fl_Window *parent)
 void
 SoFlGLWidget::redrawOverlay()
 {
-    SOFL_STUB();
+    // Overridden by subclasses that render an overlay scene.
 }
 
 void
@@ -390,7 +436,8 @@ SoFlGLWidget::initGraphic()
 void
 SoFlGLWidget::initOverlayGraphic()
 {
-    SOFL_STUB();
+    // Overridden by subclasses; called with the overlay locked the first
+    // time it is drawn to.
 }
 
 void
@@ -32,10 +32,34 @@
 
 #include "Inventor/Fl/SoFlGLWidgetP.h"
 #include "Inventor/Fl/SoFlGLWidget.h"
+#include "Inventor/Fl/SoFlGLAccumulator.h"
+#include "Inventor/Fl/SoFlGLDamage.h"
+#include "Inventor/Fl/SoFlGLFramebuffer.h"
+#include "Inventor/Fl/SoFlGLOverlay.h"
+#include "Inventor/Fl/SoFlGLPicker.h"
+#include "Inventor/Fl/SoFlGLStereo.h"
+#include "Inventor/Fl/SoFlPickCache.h"
 #include "Inventor/Fl/widgets/SoFlGLArea.h"
 #include "Inventor/Fl/SoAny.h"
+#include "Inventor/Fl/SoFlMultiViewRenderArea.h"
+#include "Inventor/Fl/SoFlRenderArea.h"
+#include "Inventor/Fl/viewers/SoFlAnimationClock.h"
+#include "Inventor/Fl/viewers/SoFlBoundingBoxCache.h"
+#include "Inventor/Fl/viewers/SoFlViewer.h"
 
+#include <Inventor/C/tidbits.h>
 #include <Inventor/SbTime.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoPickedPoint.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/actions/SoSearchAction.h>
+#include <Inventor/nodes/SoCamera.h>
+
+#include <FL/Fl.H>
+
+#include <cstdlib>
+#include <thread>
 
 #include <GL/glx.h>
 #include "sofldefs.h"
@@ -47,9 +71,32 @@ SoFlGLWidgetP::SoFlGLWidgetP(SoFlGLWidget *o)
     : SoGuiGLWidgetP(o) {
     this->borderthickness = 0;
     this->oldcontext = nullptr;
+    const char * env = coin_getenv("SOFL_INVERT_WHEEL");
+    this->wheelinverted = env && std::atoi(env) > 0;
 }
 
 SoFlGLWidgetP::~SoFlGLWidgetP() {
+    delete this->accumulator;
+    delete this->overlaylayer;
+    delete this->damage;
+    delete this->picker;
+    delete this->pickcache;
+    delete this->bboxcache;
+    delete this->animationclock;
+    delete this->stereo;
+}
+
+void
+SoFlGLWidgetP::releaseFramebuffers(std::initializer_list<SoFlGLFramebuffer *> buffers) {
+    SoFlGLArea *glarea = this->currentglarea;
+    if (glarea && glarea->shown()) {
+        PUBLIC(this)->glLockNormal();
+        for (SoFlGLFramebuffer *buffer : buffers) buffer->release();
+        PUBLIC(this)->glUnlockNormal();
+    }
+    else {
+        for (SoFlGLFramebuffer *buffer : buffers) buffer->abandon();
+    }
 }
 
 void
@@ -58,9 +105,246 @@ SoFlGLWidgetP::initGL() {
     SoDebugError::postInfo("SoFlGLWidgetP::initGL", "invoked");
 #endif
 
+    // Viewers report interaction start/finish, which is what drives
+    // dropping multisampling while the camera is moving.
+    if (!this->interactioncallbacks &&
+        PUBLIC(this)->isOfType(SoFlViewer::getClassTypeId())) {
+        SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this));
+        viewer->addStartCallback(SoFlGLWidgetP::interactionStartCB, this);
+        viewer->addFinishCallback(SoFlGLWidgetP::interactionFinishCB, this);
+        this->interactioncallbacks = true;
+    }
+
     PUBLIC(this)->initGraphic();
 }
 
+void
+SoFlGLWidgetP::interactionStartCB(void *closure, SoFlViewer *) {
+    SoFlGLWidgetP *thisp = static_cast<SoFlGLWidgetP *>(closure);
+    thisp->interacting = true;
+    if (thisp->accumulator) thisp->accumulator->stop();
+}
+
+void
+SoFlGLWidgetP::interactionFinishCB(void *closure, SoFlViewer *viewer) {
+    SoFlGLWidgetP *thisp = static_cast<SoFlGLWidgetP *>(closure);
+    thisp->interacting = false;
+    // The last interactive frame was rendered without multisampling or
+    // accumulation, so render a clean one now that the camera has
+    // stopped.
+    if ((!thisp->interactivemultisample && thisp->grantedSamples() > 1) ||
+        thisp->accumulator) {
+        viewer->scheduleRedraw();
+    }
+}
+
+// Partial redraws hook into the render area's GL render action, so
+// they are only available for render areas.
+bool
+SoFlGLWidgetP::setPartialRedraw(bool enable) {
+    if (enable && !this->damage) {
+        // The damage is worked out for one camera and viewport.
+        if (!PUBLIC(this)->isOfType(SoFlRenderArea::getClassTypeId()) ||
+            PUBLIC(this)->isOfType(SoFlMultiViewRenderArea::getClassTypeId())) return false;
+        this->damage = new SoFlGLDamage(this);
+    } else if (!enable && this->damage) {
+        this->damage->release();
+        delete this->damage;
+        this->damage = nullptr;
+    }
+    return this->damage != nullptr;
+}
+
+bool
+SoFlGLWidgetP::setIDBufferPicking(bool enable) {
+    if (enable && !this->picker) {
+        if (!PUBLIC(this)->isOfType(SoFlRenderArea::getClassTypeId())) return false;
+        this->picker = new SoFlGLPicker(this);
+    } else if (!enable && this->picker) {
+        delete this->picker;
+        this->picker = nullptr;
+    }
+    return this->picker != nullptr;
+}
+
+bool
+SoFlGLWidgetP::setPickCache(bool enable) {
+    if (enable && !this->pickcache) {
+        if (!PUBLIC(this)->isOfType(SoFlRenderArea::getClassTypeId())) return false;
+        this->pickcache = new SoFlPickCache;
+        this->updatePickCache();
+    } else if (!enable && this->pickcache) {
+        delete this->pickcache;
+        this->pickcache = nullptr;
+    }
+    return this->pickcache != nullptr;
+}
+
+// The cache follows the scene manager's root, which a render area
+// replaces when it is given a new scene graph.
+void
+SoFlGLWidgetP::updatePickCache() {
+    if (!this->pickcache) return;
+    SoFlRenderArea *area = static_cast<SoFlRenderArea *>(PUBLIC(this));
+    this->pickcache->setSceneGraph(area->getSceneManager()->getSceneGraph());
+}
+
+// The cache takes over the viewer's automatic clipping, so it is only
+// available for viewers.
+bool
+SoFlGLWidgetP::setBoundingBoxCache(bool enable) {
+    if (enable && !this->bboxcache) {
+        if (!PUBLIC(this)->isOfType(SoFlViewer::getClassTypeId())) return false;
+        SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this));
+        this->bboxcache = new SoFlBoundingBoxCache(viewer);
+        this->bboxcache->setClippingStrategy(this->clipstrategy, this->clipvalue,
+                                             this->clipcb, this->clipcbdata);
+        viewer->scheduleRedraw();
+    } else if (!enable && this->bboxcache) {
+        this->bboxcache->release();
+        delete this->bboxcache;
+        this->bboxcache = nullptr;
+    }
+    return this->bboxcache != nullptr;
+}
+
+bool
+SoFlGLWidgetP::setAutoClippingStrategy(int strategy, float value,
+                                       SoFlAutoClippingCB *cb, void *userdata) {
+    if (!PUBLIC(this)->isOfType(SoFlViewer::getClassTypeId())) return false;
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(PUBLIC(this));
+    viewer->setAutoClippingStrategy(static_cast<SoFlViewer::AutoClippingStrategy>(strategy),
+                                    value, cb, userdata);
+    this->clipstrategy = strategy;
+    this->clipvalue = value;
+    this->clipcb = cb;
+    this->clipcbdata = userdata;
+    if (this->bboxcache) this->bboxcache->setClippingStrategy(strategy, value, cb, userdata);
+    return true;
+}
+
+// The clock takes over an examiner viewer's spinning, so it is only
+// available for viewers. A rate of 0 hands the animations back.
+bool
+SoFlGLWidgetP::setAnimationRate(float rate) {
+    if (rate > 0.0f && !this->animationclock) {
+        if (!PUBLIC(this)->isOfType(SoFlViewer::getClassTypeId())) return false;
+        this->animationclock = new SoFlAnimationClock(static_cast<SoFlViewer *>(PUBLIC(this)));
+    } else if (rate <= 0.0f && this->animationclock) {
+        this->animationclock->release();
+        delete this->animationclock;
+        this->animationclock = nullptr;
+    }
+    if (this->animationclock) this->animationclock->setRate(rate);
+    return this->animationclock != nullptr;
+}
+
+// Stereo hooks into the viewer's GL render action and uses its camera,
+// so it is only available for viewers.
+bool
+SoFlGLWidgetP::setStereoMode(int mode) {
+    const int previous = this->stereo ? this->stereo->getMode() : SoFlGLStereo::NONE;
+    if (mode != SoFlGLStereo::NONE && !this->stereo) {
+        if (!PUBLIC(this)->isOfType(SoFlViewer::getClassTypeId())) return false;
+        this->stereo = new SoFlGLStereo(this);
+    } else if (mode == SoFlGLStereo::NONE && this->stereo) {
+        this->stereo->release();
+        delete this->stereo;
+        this->stereo = nullptr;
+    }
+    if (this->stereo) {
+        this->stereo->setMode(static_cast<SoFlGLStereo::Mode>(mode));
+        static_cast<SoFlViewer *>(PUBLIC(this))->scheduleRedraw();
+    }
+    // The cached frame is laid out for the previous mode.
+    if (mode != previous && this->damage) this->damage->invalidate();
+    return true;
+}
+
+// A click in seek mode is answered from the ID buffer or the pick
+// cache instead of the viewer's ray pick, and animated on the
+// animation clock if there is one. The scene is picked once: a miss
+// ends seek mode here, as the viewer would. Only clicks while the
+// cache is being built are handed to the viewer.
+bool
+SoFlGLWidgetP::seekWithPicker() {
+    SoFlGLWidget *widget = PUBLIC(this);
+    if (Fl::event_button() != FL_LEFT_MOUSE ||
+        !widget->isOfType(SoFlViewer::getClassTypeId())) return false;
+    SoFlViewer *viewer = static_cast<SoFlViewer *>(widget);
+    if (!viewer->isViewing() || !viewer->isSeekMode()) return false;
+
+    // FLTK reports positions in screen units, the ID buffer is in pixels.
+    const float scale = this->currentglarea->pixels_per_unit();
+    const SbVec2s pos(static_cast<short>(Fl::event_x() * scale),
+                      static_cast<short>(this->glSize[1] - 1 - Fl::event_y() * scale));
+    SbVec3f point;
+    SoPath *hit = nullptr;
+    // Owns the path it picks, so it has to outlive the hit.
+    SoRayPickAction rpaction(viewer->getViewportRegion());
+    if (this->picker) {
+        hit = this->picker->pick(pos, &point);
+    } else if (this->pickcache) {
+        this->updatePickCache();
+        if (!this->pickcache->isReady()) return false;
+        hit = this->pickcache->pick(viewer->getViewportRegion(), pos, &point);
+    } else {
+        rpaction.setPoint(pos);
+        rpaction.apply(viewer->getSceneManager()->getSceneGraph());
+        SoPickedPoint *picked = rpaction.getPickedPoint();
+        if (picked) {
+            point = picked->getPoint();
+            hit = picked->getPath();
+        }
+    }
+    if (!hit) {
+        viewer->setSeekMode(FALSE);
+        return true;
+    }
+    point = SoFlAnimationClock::seekTarget(point, hit, viewer->isDetailSeek() ? true : false,
+                                           viewer->getViewportRegion());
+    if (this->animationclock) this->animationclock->seekTo(point);
+    else viewer->seekToPoint(point);
+    return true;
+}
+
+SoCamera *
+SoFlGLWidgetP::findCamera() const {
+    SoFlGLWidget *widget = PUBLIC(this);
+    if (widget->isOfType(SoFlViewer::getClassTypeId())) {
+        return static_cast<SoFlViewer *>(widget)->getCamera();
+    }
+    if (!widget->isOfType(SoFlRenderArea::getClassTypeId())) return nullptr;
+    SoNode *root = static_cast<SoFlRenderArea *>(widget)->getSceneGraph();
+    if (!root) return nullptr;
+    SoSearchAction search;
+    search.setType(SoCamera::getClassTypeId());
+    search.setInterest(SoSearchAction::FIRST);
+    search.apply(root);
+    SoFullPath *path = static_cast<SoFullPath *>(search.getPath());
+    return path ? static_cast<SoCamera *>(path->getTail()) : nullptr;
+}
+
+// Of the GL area in use, since areas swapped in for a new visual may
+// well have been granted different sample counts.
+int
+SoFlGLWidgetP::grantedSamples() const {
+    return this->currentglarea ? this->currentglarea->getGrantedSamples() : 0;
+}
+
+// Must be called with the normal context current.
+void
+SoFlGLWidgetP::applyMultisampleState() {
+#ifdef GL_MULTISAMPLE
+    if (this->grantedSamples() <= 1) return;
+    if (this->interacting && !this->interactivemultisample) {
+        glDisable(GL_MULTISAMPLE);
+    } else {
+        glEnable(GL_MULTISAMPLE);
+    }
+#endif
+}
+
 void
 SoFlGLWidgetP::reshape() {
     SOFL_STUB();
@@ -98,7 +382,9 @@ SoFlGLWidgetP::concreteRedraw() {
     }
 
     if (!PUBLIC(this)->glScheduleRedraw()) {
+        if (this->bboxcache) this->bboxcache->beginRedraw();
         PUBLIC(this)->redraw();
+        if (this->bboxcache) this->bboxcache->endRedraw();
     }
 }
 
@@ -200,13 +486,12 @@ SoFlGLWidgetP::buildGLWidget() {
             this->previousglarea = wascurrentarea;
         }
 
-        if (wasprevious
-            // TODO: && QGLFormat_eq(*this->glformat, waspreviousarea->format())
-        ) {
+        if (wasprevious && this->matchesFormat(waspreviousarea)) {
             // Reenable the previous widget.
             if (this->currentglwidget) SoAny::si()->unregisterGLContext((void *) PUBLIC(this));
             this->currentglwidget = wasprevious;
             this->currentglarea = waspreviousarea;
+            this->swapInGLArea(wascurrentarea, this->currentglarea);
             SoAny::si()->registerGLContext(PUBLIC(this), display, screen);
 #if SOFL_DEBUG
             SoDebugError::postInfo("SoFlGLWidgetP::buildGLWidget",
@@ -218,6 +503,7 @@ SoFlGLWidgetP::buildGLWidget() {
 
             this->currentglarea = new SoFlGLArea(glparent, this, gl_attributes);
             this->currentglwidget = this->currentglarea;
+            this->swapInGLArea(wascurrentarea, this->currentglarea);
             SoAny::si()->registerGLContext(PUBLIC(this), display, screen);
             // Send this one to the final hunting grounds.
             delete wasprevious;
@@ -295,6 +581,31 @@ SoFlGLWidgetP::buildGLWidget() {
     return (this->currentglarea);
 }
 
+// A previously used GL widget can only be swapped back in if it was
+// built with the visual we want now.
+bool
+SoFlGLWidgetP::matchesFormat(const SoFlGLArea *area) const {
+    return area &&
+           area->getGLFormat() == this->gl_attributes &&
+           area->getRequestedSamples() == this->numsamples;
+}
+
+// Puts a rebuilt GL widget in the place of the one it replaces, so a
+// visual change at runtime is picked up without rebuilding the
+// component.
+void
+SoFlGLWidgetP::swapInGLArea(SoFlGLArea *from, SoFlGLArea *to) {
+    if (!from || from == to) return;
+    Fl_Group *group = from->parent();
+    if (group) {
+        to->resize(from->x(), from->y(), from->w(), from->h());
+        group->insert(*to, from);
+    }
+    const bool visible = from->shown() && from->visible();
+    from->hide();
+    if (visible) to->show();
+}
+
 // Returns the normal GL context.
 const GLContext
 SoFlGLWidgetP::getNormalContext() {
@@ -307,9 +618,10 @@ SoFlGLWidgetP::getNormalContext() {
 // Returns the overlay GL context.
 const GLContext
 SoFlGLWidgetP::getOverlayContext() {
-    SOFL_STUB();
+    // The overlay is emulated in the normal context.
+    if (!this->overlay) return nullptr;
     SoFlGLArea *w = this->currentglarea;
-    // TODO: if (w) { return QGLWidget_overlayContext(w); }
+    if (w) return w->context();
     return nullptr;
 }
 
@@ -337,6 +649,12 @@ void SoFlGLWidgetP::initGLModes(GLModes glModes) {
     if (glModes & SO_GL_STEREO) {
         modes |= FL_STEREO;
     }
+    if (this->numsamples > 1) {
+        modes |= FL_MULTISAMPLE;
+    }
+    // There is no overlay visual to ask for; overlays are composited
+    // from offscreen buffers by SoFlGLOverlay.
+    this->overlay = (glModes & SO_GL_OVERLAY) != 0;
     gl_attributes = static_cast<Fl_Mode>(modes);
 }
 
@@ -358,7 +676,27 @@ SoFlGLWidgetP::onMouse(int event) {
     SoDebugError::postInfo("SoFlGLWidgetP::onMouse",
                            "mouse event");
 #endif
+    if (event == FL_PUSH && this->animationclock) this->animationclock->mousePressed();
+    if (event == FL_PUSH && (this->picker || this->pickcache || this->animationclock) &&
+        this->seekWithPicker()) return;
+    if (this->animationclock) this->animationclock->beginMouseEvent();
+    // The mouse device reads the wheel straight from FLTK.
+    const bool invert = event == FL_MOUSEWHEEL && this->wheelinverted;
+    if (invert) {
+        Fl::e_dx = -Fl::e_dx;
+        Fl::e_dy = -Fl::e_dy;
+    }
     PUBLIC(this)->processEvent(event);
+    if (invert) {
+        Fl::e_dx = -Fl::e_dx;
+        Fl::e_dy = -Fl::e_dy;
+    }
+    if (this->animationclock) this->animationclock->endMouseEvent();
+    // The clock measures spins from the camera the viewer has just moved.
+    if (this->animationclock) {
+        if (event == FL_DRAG) this->animationclock->mouseDragged();
+        else if (event == FL_RELEASE) this->animationclock->mouseReleased();
+    }
 }
 
 void
@@ -402,10 +740,30 @@ SoFlGLWidgetP::hasZBuffer() const {
     return (z_buffer);
 }
 
+// Sleeps until one frame period has passed since the previous swap.
+// The next deadline is advanced from the previous one rather than from
+// "now" so the frame rate does not drift; if a frame ran late the
+// schedule is restarted instead of trying to catch up.
+void
+SoFlGLWidgetP::paceFrame() {
+    if (this->maxframerate <= 0.0f) return;
+
+    typedef std::chrono::steady_clock clock;
+    const clock::duration period =
+        std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / this->maxframerate));
+    const clock::time_point now = clock::now();
+    const clock::time_point next = this->lastswap + period;
+    if (now < next) {
+        std::this_thread::sleep_until(next);
+        this->lastswap = next;
+    } else {
+        this->lastswap = now;
+    }
+}
+
 bool
 SoFlGLWidgetP::hasOverlay() const {
-    SOFL_STUB();
-    return (false);
+    return (this->overlay);
 }
 
 #undef PRIVATE
@@ -34,15 +34,28 @@
 
 #include "Inventor/Fl/SoGuiGLWidgetP.h"
 #include "Inventor/Fl/SoFlGLWidget.h"
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
 
 #include <Inventor/SbVec2s.h>
 
 #include <FL/Fl_Window.H>
 
+#include <chrono>
+#include <initializer_list>
 #include <set>
 #include <vector>
 
-class SoFlGLArea;
+class SoFlAnimationClock;
+class SoFlBoundingBoxCache;
+class SoFlGLAccumulator;
+class SoFlGLDamage;
+class SoFlGLFramebuffer;
+class SoFlGLOverlay;
+class SoFlGLPicker;
+class SoFlGLStereo;
+class SoFlPickCache;
+class SoFlViewer;
+class SoCamera;
 
 class SoFlGLWidgetP :  public SoGuiGLWidgetP
 {
@@ -71,11 +84,87 @@ public:
 
     const GLContext * oldcontext;
 
+    // Swap control, applied by SoFlGLArea when its context is created.
+    int swapinterval{1};
+    int appliedswapinterval{1};
+    bool swapcontrol{false};
+
+    // Software frame pacing for drivers without swap control.
+    float maxframerate{0.0f};
+    std::chrono::steady_clock::time_point lastswap;
+    void paceFrame();
+
+    // Multisampling: the requested sample count, and whether to keep it
+    // on while a viewer is being interacted with. What the driver
+    // actually granted belongs to each GL area.
+    int numsamples{0};
+    int grantedSamples() const;
+    bool interactivemultisample{true};
+    bool interacting{false};
+    bool interactioncallbacks{false};
+    void applyMultisampleState();
+    bool matchesFormat(const SoFlGLArea *) const;
+    void swapInGLArea(SoFlGLArea * from, SoFlGLArea * to);
+    static void interactionStartCB(void * closure, SoFlViewer * viewer);
+    static void interactionFinishCB(void * closure, SoFlViewer * viewer);
+
+    // Frees offscreen buffers in the normal context before their owner
+    // deletes them. Once the GL area is hidden its context, and all in
+    // it, is gone, and they are only abandoned.
+    void releaseFramebuffers(std::initializer_list<SoFlGLFramebuffer *> buffers);
+
+    // The camera of a viewer, or the first one in a render area's scene.
+    SoCamera * findCamera() const;
+
+    // Progressive antialiasing of still frames, set up on demand.
+    SoFlGLAccumulator * accumulator{};
+
+    // Emulated overlay planes, set up the first time the overlay is
+    // drawn to.
+    bool overlay{false};
+    SoFlGLOverlay * overlaylayer{};
+
+    // Partial redraws of render areas, off unless asked for.
+    SoFlGLDamage * damage{};
+    bool setPartialRedraw(bool enable);
+
+    // ID buffer picking for render areas, off unless asked for.
+    SoFlGLPicker * picker{};
+    bool setIDBufferPicking(bool enable);
+
+    // Ray picking through a bounding volume hierarchy, likewise.
+    SoFlPickCache * pickcache{};
+    bool setPickCache(bool enable);
+    void updatePickCache();
+
+    // Cached scene bounds for view all and clipping, viewers only.
+    SoFlBoundingBoxCache * bboxcache{};
+    bool setBoundingBoxCache(bool enable);
+    // The viewer's clipping strategy, which it does not report.
+    int clipstrategy{0};
+    float clipvalue{0.6f};
+    SoFlAutoClippingCB * clipcb{};
+    void * clipcbdata{};
+    bool setAutoClippingStrategy(int strategy, float value,
+                                 SoFlAutoClippingCB * cb, void * userdata);
+
+    // Spin and seek animations on real time, viewers only.
+    SoFlAnimationClock * animationclock{};
+    bool setAnimationRate(float rate);
+
+    // Stereo rendered into one buffer, viewers only.
+    SoFlGLStereo * stereo{};
+    bool setStereoMode(int mode);
+
+    bool seekWithPicker();
+
     void initGL();
     void reshape();
     void concreteRedraw();
     void onMouse(int);
     void onKey(int);
+    // Reverses the wheel; starts out as SOFL_INVERT_WHEEL says.
+    bool wheelinverted{false};
 
     static bool isAPanel(Fl_Window*);
     void addSizer();
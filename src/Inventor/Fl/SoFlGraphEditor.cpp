@@ -29,12 +29,10 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
-#if 0
 
-#if HAVE_CONFIG_H
+#ifdef HAVE_CONFIG_H
 #include <config.h>
-#endif
-
+#endif // HAVE_CONFIG_H
 
 #include <Inventor/SoOutput.h>
 #include <Inventor/errors/SoDebugError.h>
@@ -43,10 +41,29 @@
 #include <Inventor/fields/SoField.h>
 #include <Inventor/nodes/SoNode.h>
 #include <Inventor/actions/SoWriteAction.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Input.H>
+#include <FL/Fl_Menu_Bar.H>
+#include <FL/Fl_Window.H>
 
 #include <sofldefs.h>
 
 #include <Inventor/Fl/SoFlGraphEditor.h>
+#include "Inventor/Fl/SoFlGraphEditorIndex.h"
+#include "Inventor/Fl/SoFlGraphEditorModel.h"
+#include "Inventor/Fl/widgets/SoFlGraphView.h"
+
+namespace {
+
+  // Height of the menu bar and the status bar.
+  const int BAR_HEIGHT = 30;
+
+  // Cap on the number of hits a search collects to step through.
+  const int MAX_MATCHES = 1000;
+
+} // namespace
 
 // *************************************************************************
 
@@ -57,6 +74,19 @@
   \ingroup editors
 
   This component is not implemented so far that editing is possible.
+
+  The tree is built lazily: a node's fields and children are only
+  looked at when the node is expanded, and rows are painted directly
+  from the tree model instead of being widgets of their own, so opening
+  the editor on a scene graph of any size is immediate. A node which is
+  referenced from several places is listed in full only once; its other
+  occurrences are marked as shared.
+
+  The editor stays in sync with the scene graph while it is edited:
+  added, removed and replaced children are patched into the parts of
+  the tree already built, and the view is refreshed once per round of
+  sensor processing however many changes came in. Field value changes
+  do not touch the tree, so an animated scene costs nothing.
 */
 
 /*!
@@ -79,6 +109,11 @@
   FIXME: write doc
 */
 
+/*!
+  \var SoFlGraphEditor::BuildFlag SoFlGraphEditor::SEARCHBAR
+  The search field above the tree. See search().
+*/
+
 /*!
   \var SoFlGraphEditor::BuildFlag SoFlGraphEditor::EVERYTHING
   FIXME: write doc
@@ -129,18 +164,21 @@ SoFlGraphEditor::constructor(
   const int parts)
 {
   this->scenegraph = (SoNode *) NULL;
+  this->model = new SoFlGraphEditorModel;
+  this->model->setChangeCallback(SoFlGraphEditor::modelChangedCB, this);
+  this->updatesensor = new SoOneShotSensor(SoFlGraphEditor::updateCB, this);
+  this->index = new SoFlGraphEditorIndex;
+  this->currentmatch = 0;
 
   this->buildflags = parts & EVERYTHING;
 
   this->editorbase = (Fl_Window *) NULL;
-  this->menubar = (Fl_Window *) NULL;
-  this->grapheditor = (Fl_Window *) NULL;
-  this->graphroot = (Fl_Window *) NULL;
-  this->statusbar = (Fl_Window *) NULL;
-  this->statusmessage = (Fl_Window *) NULL;
-
-  this->horizontal = (WxAdjustment *) NULL;
-  this->vertical = (WxAdjustment *) NULL;
+  this->menubar = (Fl_Widget *) NULL;
+  this->grapheditor = (Fl_Widget *) NULL;
+  this->graphview = (SoFlGraphView *) NULL;
+  this->statusbar = (Fl_Widget *) NULL;
+  this->statusmessage = (Fl_Box *) NULL;
+  this->searchinput = (Fl_Input *) NULL;
 
   this->setClassName("SoFlGraphEditor");
 
@@ -158,6 +196,12 @@ SoFlGraphEditor::constructor(
 SoFlGraphEditor::~SoFlGraphEditor(
   void)
 {
+  if (this->graphview) this->graphview->setModel(NULL);
+  delete this->updatesensor;
+  this->matches.truncate(0);
+  delete this->index;
+  delete this->model;
+  if (this->scenegraph) this->scenegraph->unref();
 } // ~SoFlGraphEditor()
 
 // *************************************************************************
@@ -192,66 +236,6 @@ SoFlGraphEditor::getSceneGraph(
   return this->scenegraph;
 } // getSceneGraph;
 
-/*
-  FIXME: write doc
-*/
-
-Fl_Window *
-SoFlGraphEditor::buildSubGraph(
-  Fl_Window * parent,
-  SoNode * node)
-{
-  assert(node != NULL);
-  const char * classname = node->getTypeId().getName().getString();
-  SbName nodename = node->getName();
-  Fl_Window * root;
-  if (! nodename) {
-    root = WX_WIDGET(ww_tree_item_new_with_label((gchar*)classname));
-  } else {
-    const char * name = nodename.getString();
-    char buf[128];
-    sprintf(buf, "%s \"%s\"", classname, name);
-    root = WX_WIDGET(ww_tree_item_new_with_label(buf));
-  }
-  ww_object_set_data(WX_OBJECT(root), "SoNode", (gpointer) node);
-  ww_widget_show(root);
-  ww_tree_append(WX_TREE(parent), root);
-  ww_signal_connect(WX_OBJECT(root), "select",
-    WX_SIGNAL_FUNC(SoFlGraphEditor::selectionCB), (gpointer) this);
-
-  Fl_Window * substuff = WX_WIDGET(ww_tree_new());
-  ww_tree_item_set_subtree(WX_TREE_ITEM(root), substuff);
-
-  SoFieldList fields;
-  if (node->getFields(fields) > 0) {
-    Fl_Window * fieldsitem = WX_WIDGET(ww_tree_item_new_with_label("[fields]"));
-    ww_widget_show(fieldsitem);
-    ww_tree_append(WX_TREE(substuff), fieldsitem);
-    Fl_Window * fieldstree = WX_WIDGET(ww_tree_new());
-    ww_tree_item_set_subtree(WX_TREE_ITEM(fieldsitem), fieldstree);
-    for (int i = 0; i < fields.getLength(); i++) {
-      SoField * field = fields[i];
-      SbName fieldname;
-      node->getFieldName(field, fieldname);
-      const char * fieldnamestr = fieldname.getString();
-      Fl_Window * fieldwidget = WX_WIDGET(ww_tree_item_new_with_label((gchar*)fieldnamestr));
-      ww_object_set_data(WX_OBJECT(fieldwidget), "SoNode", (gpointer) node);
-      ww_object_set_data(WX_OBJECT(fieldwidget), "SoField", (gpointer) field);
-      ww_widget_show(fieldwidget);
-      ww_tree_append(WX_TREE(fieldstree), fieldwidget);
-      ww_signal_connect(WX_OBJECT(fieldwidget), "select",
-        WX_SIGNAL_FUNC(SoFlGraphEditor::selectionCB), (gpointer) this);
-    }
-  }
-
-  SoChildList * children = node->getChildren();
-  if (children != NULL && children->getLength() > 0) {
-    for (int i = 0; i < children->getLength(); i++)
-      Fl_Window * kid = SoFlGraphEditor::buildSubGraph(substuff, (SoNode *) children->get(i));
-  }
-  return root;
-}
-
 /*!
   FIXME: write doc
 */
@@ -260,8 +244,13 @@ void
 SoFlGraphEditor::buildSceneGraphTree(// virtual, protected
   void)
 {
-  Fl_Window * graph = this->buildSubGraph(this->graphroot, this->scenegraph);
-  ww_tree_item_expand(WX_TREE_ITEM(graph));
+  // Only the root and its immediate contents are materialized here;
+  // the rest follows as the user expands the tree.
+  this->model->setRoot(this->scenegraph);
+  if (this->model->getNumItems() > 0) this->model->expand(0);
+  // Indexed on the first search.
+  this->index->setRoot(this->scenegraph);
+  if (this->graphview) this->graphview->rowsChanged();
 } // buildSceneGraphTree()
 
 /*!
@@ -272,8 +261,14 @@ void
 SoFlGraphEditor::clearSceneGraphTree(// virtual, protected
   void)
 {
-  SoDebugError::postInfo("SoFlGraphEditor::clearSceneGraphTree",
-    _("[not implemented]"));
+  this->model->clear();
+  this->index->clear();
+  this->matches.truncate(0);
+  this->lastsearch = "";
+  if (this->graphview) {
+    this->graphview->select(-1);
+    this->graphview->rowsChanged();
+  }
 } // clearSceneGraphTree()
 
 /*!
@@ -285,21 +280,78 @@ SoFlGraphEditor::saveSceneGraph(// virtual, protected
   void)
 {
   if (! this->scenegraph) {
-    this->setStatusMessage(_("No scene to save."));
+    this->setStatusMessage("No scene to save.");
     return;
   }
   SoOutput * output = new SoOutput;
   if (! output->openFile("scene.iv")) {
-    this->setStatusMessage(_("Error opening 'scene.iv' for writing."));
+    this->setStatusMessage("Error opening 'scene.iv' for writing.");
     delete output;
     return;
   }
   SoWriteAction writer(output);
   writer.apply(this->scenegraph);
   delete output;
-  this->setStatusMessage(_("Scene saved in 'scene.iv'."));
+  this->setStatusMessage("Scene saved in 'scene.iv'.");
 } // saveSceneGraph()
 
+/*!
+  Looks up nodes in the scene graph and shows the first match in the
+  tree, expanding it as needed. Repeating the same search steps through
+  the matches.
+
+  The search text is a list of terms separated by spaces, all of which
+  must match: a node type name, which matches derived types too, a
+  \c field=value pair compared against the field's string value (quote
+  values containing spaces), or else a node name prefix.
+
+  Searches run on an index of the scene graph, which is built on the
+  first search and kept up to date as the graph changes.
+*/
+
+void
+SoFlGraphEditor::search(// virtual, protected
+  const char * text)
+{
+  if (! this->scenegraph) return;
+
+  if (this->lastsearch != text || this->matches.getLength() == 0) {
+    this->lastsearch = text;
+    this->matches.truncate(0);
+    this->currentmatch = 0;
+    const SoFlGraphEditorIndex::Query query = SoFlGraphEditorIndex::Query::parse(text);
+    if (query.isEmpty()) {
+      this->setStatusMessage("");
+      return;
+    }
+    std::vector<SoNode *> found;
+    this->index->find(query, found, MAX_MATCHES);
+    for (SoNode * node : found) this->matches.append(node);
+  }
+  else {
+    this->currentmatch = (this->currentmatch + 1) % this->matches.getLength();
+  }
+
+  if (this->matches.getLength() == 0) {
+    this->setStatusMessage("No matches.");
+    return;
+  }
+
+  SoNode * node = this->matches[this->currentmatch];
+  const int item = this->model->expandPath(this->index->getPath(node));
+  if (item >= 0 && this->graphview) {
+    this->graphview->rowsChanged();
+    this->graphview->select(item);
+  }
+
+  SbString message;
+  message.sprintf("Match %d of %d%s: %s", this->currentmatch + 1,
+                  this->matches.getLength(),
+                  this->matches.getLength() == MAX_MATCHES ? "+" : "",
+                  node->getTypeId().getName().getString());
+  this->setStatusMessage(message.getString());
+} // search()
+
 // *************************************************************************
 
 /*!
@@ -310,24 +362,39 @@ Fl_Window *
 SoFlGraphEditor::buildWidget(// virtual, protected
   Fl_Window * parent)
 {
-  this->editorbase = WX_WIDGET(ww_vbox_new(FALSE, 0));
+  const SbVec2s size = this->getSize();
+  if (parent) parent->begin();
+  else Fl_Group::current(NULL);
+  this->editorbase = parent ?
+    new Fl_Window(0, 0, parent->w(), parent->h()) :
+    new Fl_Window(size[0], size[1]);
+
+  int top = 0;
+  const int bottom = (this->buildflags & STATUSBAR) ? BAR_HEIGHT : 0;
   if (this->buildflags & MENUBAR) {
     this->menubar = this->buildMenuBarWidget(this->editorbase);
-    ww_widget_set_usize(WX_WIDGET(this->menubar), 0, 30);
-    ww_widget_show(this->menubar);
-    ww_box_pack_start(WX_BOX(this->editorbase), WX_WIDGET(this->menubar), FALSE, TRUE, 0);
+    this->menubar->resize(0, top, this->editorbase->w(), BAR_HEIGHT);
+    top += BAR_HEIGHT;
+  }
+  if (this->buildflags & SEARCHBAR) {
+    Fl_Widget * searchbar = this->buildSearchBarWidget(this->editorbase);
+    searchbar->resize(0, top, this->editorbase->w(), BAR_HEIGHT);
+    top += BAR_HEIGHT;
   }
   if (this->buildflags & GRAPHEDITOR) {
     this->grapheditor = this->buildGraphEditorWidget(this->editorbase);
-    ww_widget_show(this->grapheditor);
-    ww_box_pack_start(WX_BOX(this->editorbase), WX_WIDGET(this->grapheditor), TRUE, TRUE, 0);
+    this->grapheditor->resize(0, top, this->editorbase->w(),
+                              this->editorbase->h() - top - bottom);
+    this->editorbase->resizable(this->grapheditor);
   }
   if (this->buildflags & STATUSBAR) {
     this->statusbar = this->buildStatusBarWidget(this->editorbase);
-    ww_widget_set_usize(WX_WIDGET(this->statusbar), 0, 30);
-    ww_widget_show(this->statusbar);
-    ww_box_pack_end(WX_BOX(this->editorbase), WX_WIDGET(this->statusbar), FALSE, TRUE, 0);
+    this->statusbar->resize(0, this->editorbase->h() - bottom,
+                            this->editorbase->w(), bottom);
   }
+
+  this->editorbase->end();
+  if (parent) parent->end();
   return this->editorbase;
 } // buildWidget()
 
@@ -335,79 +402,60 @@ SoFlGraphEditor::buildWidget(// virtual, protected
   This function builds and returns the graph editor menu bar.
 */
 
-Fl_Window *
+Fl_Widget *
 SoFlGraphEditor::buildMenuBarWidget(// virtual, protected
   Fl_Window * parent)
 {
-  Fl_Window * menubar = WX_WIDGET(ww_menu_bar_new());
-  Fl_Window * filemenuitem = ww_menu_item_new_with_label(_("File"));
-  ww_widget_show(filemenuitem);
-  ww_menu_bar_append(WX_MENU_BAR(menubar), WX_WIDGET(filemenuitem));
-  Fl_Window * filemenu = WX_WIDGET(ww_menu_new());
-  ww_widget_show(filemenu);
-  Fl_Window * saveitem = ww_menu_item_new_with_label(_("Save"));
-  ww_widget_show(saveitem);
-  ww_menu_append(WX_MENU(filemenu), WX_WIDGET(saveitem));
-  ww_signal_connect(WX_OBJECT(saveitem), "activate",
-    WX_SIGNAL_FUNC(SoFlGraphEditor::saveCB), (gpointer) this);
-  Fl_Window * closeitem = ww_menu_item_new_with_label(_("Close"));
-  ww_widget_show(closeitem);
-  ww_menu_append(WX_MENU(filemenu), WX_WIDGET(closeitem));
-  ww_signal_connect(WX_OBJECT(closeitem), "activate",
-    WX_SIGNAL_FUNC(SoFlGraphEditor::closeCB), (gpointer) this);
-  ww_menu_item_set_submenu(WX_MENU_ITEM(filemenuitem), WX_WIDGET(filemenu));
-  return menubar;
+  Fl_Menu_Bar * bar = new Fl_Menu_Bar(0, 0, parent->w(), BAR_HEIGHT);
+  bar->add("File/Save", 0, &SoFlGraphEditor::saveCB, this);
+  bar->add("File/Close", 0, &SoFlGraphEditor::closeCB, this);
+  return bar;
 } // buildMenuBarWidget()
 
 /*!
   This function builds and returns the actual graph editor widget.
 */
 
-Fl_Window *
+Fl_Widget *
 SoFlGraphEditor::buildGraphEditorWidget(// virtual, protected
   Fl_Window * parent)
 {
-  /* value, lower, upper, step_increment, page_increment, page_size */
-  this->vertical = WX_ADJUSTMENT(ww_adjustment_new(0, 0, 1000, 10, 100, 100));
-  this->horizontal = WX_ADJUSTMENT(ww_adjustment_new(0, 0, 1000, 10, 100, 1000));
-
-  Fl_Window * editor = WX_WIDGET(ww_scrolled_window_new(horizontal, vertical));
-  ww_scrolled_window_set_policy(
-    WX_SCROLLED_WINDOW(editor), WX_POLICY_NEVER, WX_POLICY_ALWAYS);
-
-  this->graphroot = WX_WIDGET(ww_tree_new());
-  ww_widget_show(this->graphroot);
-  ww_scrolled_window_add_with_viewport(WX_SCROLLED_WINDOW(editor), this->graphroot);
-
-  return editor;
+  this->graphview = new SoFlGraphView(0, 0, parent->w(), parent->h());
+  this->graphview->callback(&SoFlGraphEditor::selectionCB, this);
+  this->graphview->setModel(this->model);
+  return this->graphview;
 } // buildGraphEditorWidget()
 
 /*!
   This function builds and returns the graph editor status bar.
 */
 
-Fl_Window *
+Fl_Widget *
 SoFlGraphEditor::buildStatusBarWidget(// virtual, protected
   Fl_Window * parent)
 {
-  Fl_Window * statusframe = WX_WIDGET(ww_frame_new((gchar *) NULL));
-  ww_widget_set_usize(statusframe, 0, 30);
-  ww_frame_set_shadow_type(WX_FRAME(statusframe), WX_SHADOW_ETCHED_IN);
-  ww_container_set_border_width(WX_CONTAINER(statusframe), 3);
-  
-  Fl_Window * statuswidgets = ww_hbox_new(FALSE, 0);
-  ww_widget_set_usize(statusframe, 0, 30);
-  ww_container_add(WX_CONTAINER(statusframe), statuswidgets);
-  ww_widget_show(statuswidgets);
-
-  this->statusmessage = WX_WIDGET(ww_label_new((gchar *) NULL));
-  ww_label_set_justify(WX_LABEL(this->statusmessage), WX_JUSTIFY_LEFT);
-  ww_widget_show(this->statusmessage);
-  ww_box_pack_start(WX_BOX(statuswidgets), this->statusmessage, FALSE, TRUE, 3);
-
-  return statusframe;
+  this->statusmessage = new Fl_Box(0, 0, parent->w(), BAR_HEIGHT);
+  this->statusmessage->box(FL_THIN_DOWN_BOX);
+  this->statusmessage->align(FL_ALIGN_LEFT | FL_ALIGN_INSIDE | FL_ALIGN_CLIP);
+  return this->statusmessage;
 } // buildStatusBarWidget()
 
+/*!
+  This function builds and returns the search field.
+*/
+
+Fl_Widget *
+SoFlGraphEditor::buildSearchBarWidget(// virtual, protected
+  Fl_Window * parent)
+{
+  this->searchinput = new Fl_Input(0, 0, parent->w(), BAR_HEIGHT);
+  this->searchinput->tooltip("Node type, name prefix or field=value; "
+                             "Enter steps through the matches");
+  this->searchinput->when(FL_WHEN_ENTER_KEY_ALWAYS);
+  this->searchinput->callback(&SoFlGraphEditor::searchCB, this);
+  return this->searchinput;
+} // buildSearchBarWidget()
+
 // *************************************************************************
 
 /*!
@@ -416,7 +464,7 @@ SoFlGraphEditor::buildStatusBarWidget(// virtual, protected
 
 void
 SoFlGraphEditor::nodeSelection(// virtual, protected
-  Fl_Window * treeitem,
+  int item,
   SoNode * node)
 {
   this->setStatusMessage(node->getTypeId().getName().getString());
@@ -428,7 +476,7 @@ SoFlGraphEditor::nodeSelection(// virtual, protected
 
 void
 SoFlGraphEditor::fieldSelection(// virtual, protected
-  Fl_Window * treeitem,
+  int item,
   SoNode * node,
   SoField * field)
 {
@@ -452,8 +500,8 @@ SoFlGraphEditor::sizeChanged(const SbVec2s & size)
 
 void
 SoFlGraphEditor::saveCB(// static, private
-  WxObject * obj,
-  gpointer closure)
+  Fl_Widget * obj,
+  void * closure)
 {
   assert(closure != NULL);
   SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
@@ -466,8 +514,8 @@ SoFlGraphEditor::saveCB(// static, private
 
 void
 SoFlGraphEditor::closeCB(// static, private
-  WxObject * obj,
-  gpointer closure)
+  Fl_Widget * obj,
+  void * closure)
 {
   assert(closure != NULL);
   SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
@@ -484,7 +532,7 @@ void
 SoFlGraphEditor::setStatusMessage(// virtual, protected
   const char * message)
 {
-  ww_label_set_text(WX_LABEL(this->statusmessage), message);
+  if (this->statusmessage) this->statusmessage->copy_label(message);
 } // setStatusMessage()
 
 // *************************************************************************
@@ -494,22 +542,72 @@ SoFlGraphEditor::setStatusMessage(// virtual, protected
 */
 
 void
-SoFlGraphEditor::selectionCB(
-  WxObject * object,
-  gpointer closure)
+SoFlGraphEditor::selectionCB(// static, private
+  Fl_Widget * object,
+  void * closure)
 {
   assert(closure != NULL);
   SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
-  SoNode * node = (SoNode *) ww_object_get_data(WX_OBJECT(object), "SoNode");
-  SoField * field = (SoField *) ww_object_get_data(WX_OBJECT(object), "SoField");
-  if (node && ! field)
-    editor->nodeSelection(WX_WIDGET(object), node);
-  else if (node && field)
-    editor->fieldSelection(WX_WIDGET(object), node, field);
-  else
-    SoDebugError::postInfo("SoFlGraphEditor::selectionCB", "[invalid selection data]");
+  const int item = editor->graphview->getSelectedItem();
+  if (item < 0) return;
+  const SoFlGraphEditorModel::Item & i = editor->model->getItem(item);
+  switch (i.kind) {
+  case SoFlGraphEditorModel::NODE:
+  case SoFlGraphEditorModel::REFERENCE:
+    editor->nodeSelection(item, i.node);
+    break;
+  case SoFlGraphEditorModel::FIELD:
+    editor->fieldSelection(item, i.node, i.field);
+    break;
+  default:
+    break;
+  }
 } // selectionCB()
 
+/*!
+  \internal
+*/
+
+void
+SoFlGraphEditor::searchCB(// static, private
+  Fl_Widget * obj,
+  void * closure)
+{
+  assert(closure != NULL);
+  SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
+  editor->search(static_cast<Fl_Input *>(obj)->value());
+} // searchCB()
+
+/*!
+  \internal
+
+  Called by the tree model each time it was patched for a scene graph
+  change. The view is updated from a one-shot sensor, so that a burst
+  of changes ends up as a single refresh.
+*/
+
+void
+SoFlGraphEditor::modelChangedCB(// static, private
+  void * closure)
+{
+  SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
+  if (! editor->updatesensor->isScheduled())
+    editor->updatesensor->schedule();
+} // modelChangedCB()
+
+/*!
+  \internal
+*/
+
+void
+SoFlGraphEditor::updateCB(// static, private
+  void * closure,
+  SoSensor *)
+{
+  SoFlGraphEditor * editor = (SoFlGraphEditor *) closure;
+  if (editor->graphview) editor->graphview->rowsChanged();
+} // updateCB()
+
 // *************************************************************************
 
 /*!
@@ -532,8 +630,8 @@ const char *
 SoFlGraphEditor::getDefaultTitle(// virtual, protected
   void) const
 {
-  static const char defaultTitle[] = N_("Graph Editor");
-  return _(defaultTitle);
+  static const char defaultTitle[] = "Graph Editor";
+  return defaultTitle;
 } // getDefaultTitle()
 
 /*!
@@ -544,9 +642,8 @@ const char *
 SoFlGraphEditor::getDefaultIconTitle(// virtual, protected
   void) const
 {
-  static const char defaultIconTitle[] = N_("Graph Editor");
-  return _(defaultIconTitle);
+  static const char defaultIconTitle[] = "Graph Editor";
+  return defaultIconTitle;
 } // getDefaultIconTitle()
 
 // *************************************************************************
-#endif
\ No newline at end of file
@@ -30,14 +30,23 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
 
-#if 0
 #ifndef SOFL_GRAPHEDITOR_H
 #define SOFL_GRAPHEDITOR_H
 
 #include <Inventor/Fl/SoFlComponent.h>
+#include <Inventor/SbString.h>
+#include <Inventor/lists/SoNodeList.h>
 
+class Fl_Box;
+class Fl_Input;
+class Fl_Widget;
 class SoNode;
 class SoField;
+class SoFlGraphEditorIndex;
+class SoFlGraphEditorModel;
+class SoFlGraphView;
+class SoOneShotSensor;
+class SoSensor;
 
 // *************************************************************************
 
@@ -49,7 +58,8 @@ public:
     MENUBAR =       0x01,
     GRAPHEDITOR =   0x02,
     STATUSBAR =     0x04,
-    EVERYTHING =    0x07
+    SEARCHBAR =     0x08,
+    EVERYTHING =    0x0f
   };
 
   SoFlGraphEditor(Fl_Window * const parent = (Fl_Window *) NULL,
@@ -66,9 +76,10 @@ protected:
                    const SbBool embed, const int parts, const SbBool build);
 
   Fl_Window * buildWidget(Fl_Window * parent);
-  virtual Fl_Window * buildMenuBarWidget(Fl_Window * parent);
-  virtual Fl_Window * buildGraphEditorWidget(Fl_Window * parent);
-  virtual Fl_Window * buildStatusBarWidget(Fl_Window * parent);
+  virtual Fl_Widget * buildMenuBarWidget(Fl_Window * parent);
+  virtual Fl_Widget * buildGraphEditorWidget(Fl_Window * parent);
+  virtual Fl_Widget * buildStatusBarWidget(Fl_Window * parent);
+  virtual Fl_Widget * buildSearchBarWidget(Fl_Window * parent);
 
   virtual void sizeChanged(const SbVec2s & size);
 
@@ -77,10 +88,12 @@ protected:
 
   virtual void saveSceneGraph(void);
 
+  virtual void search(const char * text);
+
   virtual void setStatusMessage(const char * message);
 
-  virtual void nodeSelection(Fl_Window * item, SoNode * node);
-  virtual void fieldSelection(Fl_Window * item, SoNode * node, SoField * field);
+  virtual void nodeSelection(int item, SoNode * node);
+  virtual void fieldSelection(int item, SoNode * node, SoField * field);
 
   virtual const char * getDefaultWidgetName(void) const;
   virtual const char * getDefaultTitle(void) const;
@@ -89,28 +102,32 @@ protected:
 private:
   void constructor(const SbBool build, const int parts);
 
-  static void saveCB(Fl_Window * obj, void* closure);
-  static void closeCB(Fl_Window * obj, void* closure);
-  static void selectionCB(Fl_Window * obj, void* closure);
-
-  Fl_Window * buildSubGraph(Fl_Window * parent, SoNode * node);
+  static void saveCB(Fl_Widget * obj, void * closure);
+  static void closeCB(Fl_Widget * obj, void * closure);
+  static void selectionCB(Fl_Widget * obj, void * closure);
+  static void searchCB(Fl_Widget * obj, void * closure);
+  static void modelChangedCB(void * closure);
+  static void updateCB(void * closure, SoSensor * sensor);
 
   SoNode * scenegraph;
+  SoFlGraphEditorModel * model;
+  SoOneShotSensor * updatesensor;
+  SoFlGraphEditorIndex * index;
+  SoNodeList matches;
+  int currentmatch;
+  SbString lastsearch;
 
   int buildflags;
   Fl_Window * editorbase;
-  Fl_Window * menubar;
-  Fl_Window * grapheditor;
-  Fl_Window * graphroot;
-  Fl_Window * statusbar;
-  Fl_Window * statusmessage;
-
-  WxAdjustment * vertical;
-  WxAdjustment * horizontal;
+  Fl_Widget * menubar;
+  Fl_Widget * grapheditor;
+  SoFlGraphView * graphview;
+  Fl_Widget * statusbar;
+  Fl_Box * statusmessage;
+  Fl_Input * searchinput;
 
 }; // class SoFlGraphEditor
 
 // *************************************************************************
 
-#endif // ! SOFL_H
-#endif
\ No newline at end of file
+#endif // ! SOFL_GRAPHEDITOR_H
@@ -0,0 +1,371 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGraphEditorIndex.h"
+
+#include <Inventor/SbString.h>
+#include <Inventor/fields/SoField.h>
+#include <Inventor/misc/SoChildList.h>
+#include <Inventor/misc/SoNotRec.h>
+#include <Inventor/nodes/SoNode.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+    // Splits on whitespace; double quotes group words, so that
+    // 'translation="1 2 3"' is one term.
+    std::vector<std::string> tokenize(const char * text)
+    {
+        std::vector<std::string> tokens;
+        std::string current;
+        bool quoted = false;
+        for (const char * c = text; c && *c; c++) {
+            if (*c == '"') quoted = !quoted;
+            else if (!quoted && std::isspace(static_cast<unsigned char>(*c))) {
+                if (!current.empty()) tokens.push_back(current);
+                current.clear();
+            }
+            else current += *c;
+        }
+        if (!current.empty()) tokens.push_back(current);
+        return tokens;
+    }
+
+    SoType nodeType(const std::string & name)
+    {
+        SoType type = SoType::fromName(SbName(name.c_str()));
+        // Accept the class name as well as the file format name.
+        if (type.isBad() && name.compare(0, 2, "So") == 0)
+            type = SoType::fromName(SbName(name.c_str() + 2));
+        if (type.isBad() || !type.isDerivedFrom(SoNode::getClassTypeId()))
+            return SoType::badType();
+        return type;
+    }
+
+} // namespace
+
+SoFlGraphEditorIndex::Query
+SoFlGraphEditorIndex::Query::parse(const char * text)
+{
+    Query query;
+    for (const std::string & token : tokenize(text)) {
+        const std::string::size_type eq = token.find('=');
+        if (eq != std::string::npos && eq > 0) {
+            query.fields.emplace_back(token.substr(0, eq), token.substr(eq + 1));
+            continue;
+        }
+        const SoType type = nodeType(token);
+        if (!type.isBad()) query.type = type;
+        else query.nameprefix = token;
+    }
+    return query;
+}
+
+bool
+SoFlGraphEditorIndex::Query::isEmpty() const
+{
+    return this->type.isBad() && this->nameprefix.empty() && this->fields.empty();
+}
+
+SoFlGraphEditorIndex::SoFlGraphEditorIndex()
+    : root(nullptr), built(false)
+{
+    // Immediate, for the trigger information.
+    this->sensor = new SoNodeSensor(SoFlGraphEditorIndex::sensorCB, this);
+    this->sensor->setPriority(0);
+}
+
+SoFlGraphEditorIndex::~SoFlGraphEditorIndex()
+{
+    this->clear();
+    delete this->sensor;
+}
+
+void
+SoFlGraphEditorIndex::setRoot(SoNode * node)
+{
+    if (node) node->ref();
+    this->clear();
+    this->root = node;
+}
+
+void
+SoFlGraphEditorIndex::clear()
+{
+    this->sensor->detach();
+    this->entries.clear();
+    this->bytype.clear();
+    this->byname.clear();
+    this->built = false;
+    if (this->root) this->root->unref();
+    this->root = nullptr;
+}
+
+bool
+SoFlGraphEditorIndex::isBuilt() const
+{
+    return this->built;
+}
+
+int
+SoFlGraphEditorIndex::getNumNodes() const
+{
+    return static_cast<int>(this->entries.size());
+}
+
+void
+SoFlGraphEditorIndex::build()
+{
+    if (this->built || !this->root) return;
+    this->built = true;
+    this->addOccurrence(nullptr, this->root);
+    this->sensor->attach(this->root);
+}
+
+int
+SoFlGraphEditorIndex::find(const Query & query, std::vector<SoNode *> & result, int max)
+{
+    this->build();
+    if (!this->built || query.isEmpty()) return 0;
+
+    // Start from the narrowest candidate set the index has for the
+    // query, and filter on the rest.
+    int found = 0;
+    if (!query.nameprefix.empty()) {
+        const std::string & prefix = query.nameprefix;
+        for (auto it = this->byname.lower_bound(prefix);
+             it != this->byname.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+             ++it) {
+            for (SoNode * node : it->second) {
+                if (found == max) return found;
+                if (!this->matches(node, query)) continue;
+                result.push_back(node);
+                found++;
+            }
+        }
+        return found;
+    }
+
+    if (!query.type.isBad()) {
+        for (const auto & bucket : this->bytype) {
+            if (!SoType::fromKey(bucket.first).isDerivedFrom(query.type)) continue;
+            for (SoNode * node : bucket.second) {
+                if (found == max) return found;
+                if (!this->matches(node, query)) continue;
+                result.push_back(node);
+                found++;
+            }
+        }
+        return found;
+    }
+
+    for (const auto & entry : this->entries) {
+        if (found == max) break;
+        if (!this->matches(entry.first, query)) continue;
+        result.push_back(entry.first);
+        found++;
+    }
+    return found;
+}
+
+std::vector<SoNode *>
+SoFlGraphEditorIndex::getPath(SoNode * node) const
+{
+    std::vector<SoNode *> path;
+    auto it = this->entries.find(node);
+    while (it != this->entries.end()) {
+        path.push_back(it->first);
+        if (it->second.parents.empty()) break;
+        it = this->entries.find(it->second.parents.front());
+    }
+    if (path.empty() || path.back() != this->root) return std::vector<SoNode *>();
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void
+SoFlGraphEditorIndex::addOccurrence(SoNode * parent, SoNode * child)
+{
+    auto it = this->entries.find(child);
+    if (it != this->entries.end()) {
+        it->second.parents.push_back(parent);
+        return;
+    }
+
+    // References into the map stay valid while it grows.
+    Entry & entry = this->entries[child];
+    entry.type = child->getTypeId();
+    entry.name = child->getName();
+    if (parent) entry.parents.push_back(parent);
+    this->bytype[entry.type.getKey()].insert(child);
+    if (entry.name.getLength() > 0) this->addName(child, entry.name);
+
+    const SoChildList * children = child->getChildren();
+    if (!children) return;
+    for (int i = 0; i < children->getLength(); i++)
+        entry.children.push_back((*children)[i]);
+    for (SoNode * grandchild : entry.children)
+        this->addOccurrence(child, grandchild);
+}
+
+// Only the index's own records are used here; 'child' may already
+// have been destroyed.
+void
+SoFlGraphEditorIndex::removeOccurrence(SoNode * parent, SoNode * child)
+{
+    auto it = this->entries.find(child);
+    if (it == this->entries.end()) return;
+
+    std::vector<SoNode *> & parents = it->second.parents;
+    auto p = std::find(parents.begin(), parents.end(), parent);
+    if (p != parents.end()) parents.erase(p);
+    if (!parents.empty() || child == this->root) return;
+
+    auto bucket = this->bytype.find(it->second.type.getKey());
+    if (bucket != this->bytype.end()) bucket->second.erase(child);
+    if (it->second.name.getLength() > 0) this->removeName(child, it->second.name);
+
+    const std::vector<SoNode *> children = std::move(it->second.children);
+    this->entries.erase(it);
+    for (SoNode * grandchild : children)
+        this->removeOccurrence(child, grandchild);
+}
+
+void
+SoFlGraphEditorIndex::addName(SoNode * node, const SbName & name)
+{
+    this->byname[name.getString()].push_back(node);
+}
+
+void
+SoFlGraphEditorIndex::removeName(SoNode * node, const SbName & name)
+{
+    auto named = this->byname.find(name.getString());
+    if (named == this->byname.end()) return;
+    std::vector<SoNode *> & nodes = named->second;
+    auto it = std::find(nodes.begin(), nodes.end(), node);
+    if (it != nodes.end()) {
+        *it = nodes.back();
+        nodes.pop_back();
+    }
+    if (nodes.empty()) this->byname.erase(named);
+}
+
+bool
+SoFlGraphEditorIndex::matches(SoNode * node, const Query & query) const
+{
+    if (!query.type.isBad() &&
+        !this->entries.at(node).type.isDerivedFrom(query.type))
+        return false;
+
+    for (const auto & constraint : query.fields) {
+        SoField * field = node->getField(SbName(constraint.first.c_str()));
+        if (!field) return false;
+        SbString value;
+        field->get(value);
+        if (constraint.second != value.getString()) return false;
+    }
+    return true;
+}
+
+void
+SoFlGraphEditorIndex::sensorCB(void * closure, SoSensor * s)
+{
+    auto * index = static_cast<SoFlGraphEditorIndex *>(closure);
+    auto * sensor = static_cast<SoNodeSensor *>(s);
+
+    const SoNotRec::OperationType op = sensor->getTriggerOperationType();
+    if (op == SoNotRec::UNSPECIFIED || op == SoNotRec::FIELD_UPDATE) return;
+
+    SoNode * group = sensor->getTriggerNode();
+    auto it = index->entries.find(group);
+    if (it == index->entries.end()) return;
+
+    const SoChildList * children = group->getChildren();
+    const int count = children ? children->getLength() : 0;
+    const int i = sensor->getTriggerIndex();
+    std::vector<SoNode *> & known = it->second.children;
+    std::vector<SoNode *> removed;
+
+    const bool inrange = i >= 0 && i < count;
+    switch (op) {
+    case SoNotRec::GROUP_ADDCHILD:
+        if (count == 0) break;
+        known.push_back((*children)[count - 1]);
+        index->addOccurrence(group, known.back());
+        break;
+    case SoNotRec::GROUP_INSERTCHILD:
+        if (!inrange || i > static_cast<int>(known.size())) break;
+        known.insert(known.begin() + i, (*children)[i]);
+        index->addOccurrence(group, known[i]);
+        break;
+    case SoNotRec::GROUP_REMOVECHILD:
+        if (i < 0 || i >= static_cast<int>(known.size())) break;
+        removed.push_back(known[i]);
+        known.erase(known.begin() + i);
+        break;
+    case SoNotRec::GROUP_REPLACECHILD:
+        if (!inrange || i >= static_cast<int>(known.size())) break;
+        removed.push_back(known[i]);
+        known[i] = (*children)[i];
+        index->addOccurrence(group, known[i]);
+        break;
+    case SoNotRec::GROUP_REMOVEALLCHILDREN:
+        removed.swap(known);
+        break;
+    default:
+        break;
+    }
+
+    // Should our copy of the child list have gone out of step, start
+    // over for this group.
+    if (static_cast<int>(known.size()) != count) {
+        removed.insert(removed.end(), known.begin(), known.end());
+        known.clear();
+        for (int c = 0; c < count; c++) {
+            known.push_back((*children)[c]);
+            index->addOccurrence(group, known.back());
+        }
+    }
+
+    for (SoNode * node : removed)
+        index->removeOccurrence(group, node);
+}
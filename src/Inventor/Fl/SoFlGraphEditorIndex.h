@@ -0,0 +1,120 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGRAPHEDITORINDEX_H
+#define SOFL_SOFLGRAPHEDITORINDEX_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbName.h>
+#include <Inventor/SoType.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class SoNode;
+class SoNodeSensor;
+class SoSensor;
+
+// Search index over a scene graph, for the graph editor: nodes by type,
+// node names in sorted order for prefix lookups, and each node's
+// parents so that a path from the root can be produced for any hit.
+//
+// The index is kept up to date from scene graph notifications. It
+// keeps its own copy of each group's child list, so removed subtrees
+// can be dropped without touching nodes that may already be gone.
+// Coin does not notify about name changes; a renamed node is found
+// under its old name until it is re-added to the graph.
+class SoFlGraphEditorIndex {
+public:
+    // Space separated terms, all of which must match: a node type name
+    // (matching derived types too), "field=value", or a name prefix.
+    struct Query {
+        SoType type;
+        std::string nameprefix;
+        std::vector<std::pair<std::string, std::string>> fields;
+
+        static Query parse(const char * text);
+        bool isEmpty() const;
+    };
+
+    SoFlGraphEditorIndex();
+    ~SoFlGraphEditorIndex();
+
+    void setRoot(SoNode * root);
+    void clear();
+
+    // The index is built the first time it is queried.
+    bool isBuilt() const;
+    int getNumNodes() const;
+
+    // Appends up to 'max' matching nodes to 'result', in no particular
+    // order, and returns the number appended.
+    int find(const Query & query, std::vector<SoNode *> & result, int max);
+
+    // A path of nodes from the root down to 'node', or empty if the
+    // node is not in the graph.
+    std::vector<SoNode *> getPath(SoNode * node) const;
+
+private:
+    struct Entry {
+        SoType type;
+        SbName name;
+        std::vector<SoNode *> parents;    // one per occurrence
+        std::vector<SoNode *> children;
+    };
+
+    static void sensorCB(void * closure, SoSensor * sensor);
+
+    void build();
+    void addOccurrence(SoNode * parent, SoNode * child);
+    void removeOccurrence(SoNode * parent, SoNode * child);
+    void addName(SoNode * node, const SbName & name);
+    void removeName(SoNode * node, const SbName & name);
+    bool matches(SoNode * node, const Query & query) const;
+
+    SoNode * root;
+    SoNodeSensor * sensor;
+    bool built;
+    std::unordered_map<SoNode *, Entry> entries;
+    std::unordered_map<int16_t, std::unordered_set<SoNode *>> bytype;
+    // Ordered, so that all names with a given prefix are adjacent.
+    std::map<std::string, std::vector<SoNode *>> byname;
+};
+
+#endif // !SOFL_SOFLGRAPHEDITORINDEX_H
@@ -0,0 +1,528 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlGraphEditorModel.h"
+
+#include <Inventor/SoLists.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/fields/SoField.h>
+#include <Inventor/fields/SoFieldData.h>
+#include <Inventor/misc/SoChildList.h>
+#include <Inventor/misc/SoNotRec.h>
+#include <Inventor/nodes/SoNode.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include "sofldefs.h"
+
+SoFlGraphEditorModel::SoFlGraphEditorModel()
+    : root(nullptr), changecb(nullptr), changeclosure(nullptr), rowsdirty(false)
+{
+    // Immediate, so that the trigger information is available and the
+    // items are patched before a removed node can go away.
+    this->sensor = new SoNodeSensor(SoFlGraphEditorModel::sensorCB, this);
+    this->sensor->setPriority(0);
+}
+
+SoFlGraphEditorModel::~SoFlGraphEditorModel()
+{
+    this->clear();
+    delete this->sensor;
+}
+
+void
+SoFlGraphEditorModel::setChangeCallback(ChangeCB * callback, void * closure)
+{
+    this->changecb = callback;
+    this->changeclosure = closure;
+}
+
+void
+SoFlGraphEditorModel::setRoot(SoNode * node)
+{
+    if (node) node->ref();
+    this->clear();
+    this->root = node;
+    if (!node) return;
+    this->owners[node] = this->addItem(NODE, node, nullptr, -1);
+    this->rows.push_back(0);
+    this->sensor->attach(node);
+}
+
+SoNode *
+SoFlGraphEditorModel::getRoot() const
+{
+    return this->root;
+}
+
+void
+SoFlGraphEditorModel::clear()
+{
+    this->sensor->detach();
+    this->items.clear();
+    this->freeitems.clear();
+    this->rows.clear();
+    this->rowsdirty = false;
+    this->owners.clear();
+    this->references.clear();
+    if (this->root) this->root->unref();
+    this->root = nullptr;
+}
+
+int
+SoFlGraphEditorModel::getNumRows() const
+{
+    this->ensureRows();
+    return static_cast<int>(this->rows.size());
+}
+
+int
+SoFlGraphEditorModel::getItemAtRow(int row) const
+{
+    if (row < 0 || row >= this->getNumRows()) return -1;
+    return this->rows[row];
+}
+
+int
+SoFlGraphEditorModel::getRowOfItem(int item) const
+{
+    this->ensureRows();
+    auto it = std::find(this->rows.begin(), this->rows.end(), item);
+    return it == this->rows.end() ? -1 : static_cast<int>(it - this->rows.begin());
+}
+
+int
+SoFlGraphEditorModel::getNumItems() const
+{
+    return static_cast<int>(this->items.size());
+}
+
+const SoFlGraphEditorModel::Item &
+SoFlGraphEditorModel::getItem(int item) const
+{
+    assert(item >= 0 && item < this->getNumItems());
+    return this->items[item];
+}
+
+bool
+SoFlGraphEditorModel::isAlive(int item) const
+{
+    return item >= 0 && item < this->getNumItems() && this->items[item].node;
+}
+
+int
+SoFlGraphEditorModel::findItem(const SoNode * node) const
+{
+    auto it = this->owners.find(node);
+    return it == this->owners.end() ? -1 : it->second;
+}
+
+bool
+SoFlGraphEditorModel::isExpandable(int item) const
+{
+    const Item & i = this->getItem(item);
+    switch (i.kind) {
+    case NODE: {
+        // Answered without populating, so that the view can draw the
+        // expander of collapsed rows.
+        const SoFieldData * fields = i.node->getFieldData();
+        if (fields && fields->getNumFields() > 0) return true;
+        const SoChildList * children = i.node->getChildren();
+        return children && children->getLength() > 0;
+    }
+    case FIELDS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void
+SoFlGraphEditorModel::expand(int item)
+{
+    if (this->getItem(item).expanded || !this->isExpandable(item)) return;
+    this->populate(item);
+    // Rows rebuilt from here on would already hold the children, and
+    // would get them inserted a second time below.
+    this->ensureRows();
+    this->items[item].expanded = true;
+
+    // Nothing to show if an ancestor is collapsed; the rows are added
+    // when that one gets expanded.
+    const int row = this->getRowOfItem(item);
+    if (row < 0) return;
+
+    std::vector<int> shown;
+    for (int child : this->items[item].children)
+        this->appendVisible(child, shown);
+    this->rows.insert(this->rows.begin() + row + 1, shown.begin(), shown.end());
+}
+
+void
+SoFlGraphEditorModel::collapse(int item)
+{
+    if (!this->getItem(item).expanded) return;
+    const int row = this->getRowOfItem(item);
+    this->items[item].expanded = false;
+    if (row < 0) return;
+
+    // Rows below an item are its descendants for as long as they are
+    // nested deeper.
+    const int depth = this->items[item].depth;
+    auto first = this->rows.begin() + row + 1;
+    auto last = first;
+    while (last != this->rows.end() && this->items[*last].depth > depth) ++last;
+    this->rows.erase(first, last);
+}
+
+void
+SoFlGraphEditorModel::toggle(int item)
+{
+    if (this->getItem(item).expanded) this->collapse(item);
+    else this->expand(item);
+}
+
+int
+SoFlGraphEditorModel::expandPath(const std::vector<SoNode *> & path)
+{
+    if (path.empty() || !this->root || path.front() != this->root) return -1;
+
+    int item = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        this->expand(item);
+        int next = -1;
+        for (int child : this->items[item].children) {
+            if (this->items[child].kind != FIELDS && this->items[child].node == path[i]) {
+                next = child;
+                break;
+            }
+        }
+        if (next < 0) return -1;
+        if (this->items[next].kind == REFERENCE) {
+            next = this->items[next].original;
+            this->expandAncestors(next);
+        }
+        item = next;
+    }
+    return item;
+}
+
+void
+SoFlGraphEditorModel::expandAncestors(int item)
+{
+    std::vector<int> ancestors;
+    for (int p = this->items[item].parent; p >= 0; p = this->items[p].parent)
+        ancestors.push_back(p);
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it)
+        this->expand(*it);
+}
+
+SbString
+SoFlGraphEditorModel::getLabel(int item) const
+{
+    const Item & i = this->getItem(item);
+    SbString label;
+    switch (i.kind) {
+    case NODE:
+    case REFERENCE: {
+        // Built on every call, so renamed nodes show up on the next
+        // redraw; Coin does not notify about name changes.
+        label = i.node->getTypeId().getName().getString();
+        const SbName name = i.node->getName();
+        if (name.getLength() > 0) {
+            label += " \"";
+            label += name.getString();
+            label += "\"";
+        }
+        if (i.kind == REFERENCE) label += " (shared)";
+        break;
+    }
+    case FIELDS:
+        label = "[fields]";
+        break;
+    case FIELD: {
+        SbName name;
+        i.node->getFieldName(i.field, name);
+        label = name.getString();
+        break;
+    }
+    }
+    return label;
+}
+
+int
+SoFlGraphEditorModel::addItem(Kind kind, SoNode * node, SoField * field, int parent)
+{
+    Item i;
+    i.kind = kind;
+    i.node = node;
+    i.field = field;
+    i.parent = parent;
+    i.depth = parent < 0 ? 0 : this->items[parent].depth + 1;
+    i.original = -1;
+    i.expanded = false;
+    i.populated = false;
+
+    int index;
+    if (!this->freeitems.empty()) {
+        index = this->freeitems.back();
+        this->freeitems.pop_back();
+        this->items[index] = i;
+    }
+    else {
+        this->items.push_back(i);
+        index = static_cast<int>(this->items.size()) - 1;
+    }
+    if (parent >= 0) this->items[parent].children.push_back(index);
+    return index;
+}
+
+// Creates the item for a child node of 'parent', appended to its
+// children.
+int
+SoFlGraphEditorModel::newChild(SoNode * child, int parent)
+{
+    auto owner = this->owners.find(child);
+    if (owner != this->owners.end()) {
+        const int ref = this->addItem(REFERENCE, child, nullptr, parent);
+        this->items[ref].original = owner->second;
+        this->references.emplace(child, ref);
+        return ref;
+    }
+    const int item = this->addItem(NODE, child, nullptr, parent);
+    this->owners[child] = item;
+    return item;
+}
+
+// Releases an item and its subtree. If the item held the subtree of a
+// shared node, another occurrence takes over.
+void
+SoFlGraphEditorModel::releaseItem(int item)
+{
+    for (int child : this->items[item].children)
+        this->releaseItem(child);
+
+    Item & i = this->items[item];
+    if (i.kind == REFERENCE) {
+        auto range = this->references.equal_range(i.node);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == item) {
+                this->references.erase(it);
+                break;
+            }
+        }
+    }
+    else if (i.kind == NODE) {
+        this->owners.erase(i.node);
+        auto range = this->references.equal_range(i.node);
+        if (range.first != range.second) {
+            const int heir = range.first->second;
+            this->references.erase(range.first);
+            Item & h = this->items[heir];
+            h.kind = NODE;
+            h.original = -1;
+            this->owners[h.node] = heir;
+            range = this->references.equal_range(h.node);
+            for (auto it = range.first; it != range.second; ++it)
+                this->items[it->second].original = heir;
+        }
+    }
+
+    i.node = nullptr;
+    i.field = nullptr;
+    i.parent = -1;
+    i.children.clear();
+    this->freeitems.push_back(item);
+}
+
+int
+SoFlGraphEditorModel::firstChildSlot(int item) const
+{
+    const std::vector<int> & children = this->items[item].children;
+    return (!children.empty() && this->items[children[0]].kind == FIELDS) ? 1 : 0;
+}
+
+void
+SoFlGraphEditorModel::populate(int item)
+{
+    if (this->items[item].populated) return;
+    this->items[item].populated = true;
+
+    SoNode * node = this->items[item].node;
+    if (this->items[item].kind == FIELDS) {
+        SoFieldList fields;
+        node->getFields(fields);
+        for (int i = 0; i < fields.getLength(); i++)
+            this->addItem(FIELD, node, fields[i], item);
+        return;
+    }
+
+    const SoFieldData * fielddata = node->getFieldData();
+    if (fielddata && fielddata->getNumFields() > 0)
+        this->addItem(FIELDS, node, nullptr, item);
+
+    const SoChildList * children = node->getChildren();
+    if (!children) return;
+    for (int i = 0; i < children->getLength(); i++)
+        this->newChild((*children)[i], item);
+}
+
+// Drops and recreates the child items of 'item', for changes which
+// could not be patched in place.
+void
+SoFlGraphEditorModel::repopulate(int item)
+{
+    this->childrenRemoved(item);
+    const SoChildList * children = this->items[item].node->getChildren();
+    if (!children) return;
+    for (int i = 0; i < children->getLength(); i++)
+        this->newChild((*children)[i], item);
+}
+
+void
+SoFlGraphEditorModel::childInserted(int item, int index)
+{
+    SoNode * child = (*this->items[item].node->getChildren())[index];
+    const int created = this->newChild(child, item);
+    // newChild() appends; move it into place.
+    std::vector<int> & children = this->items[item].children;
+    children.pop_back();
+    children.insert(children.begin() + this->firstChildSlot(item) + index, created);
+}
+
+void
+SoFlGraphEditorModel::childRemoved(int item, int index)
+{
+    std::vector<int> & children = this->items[item].children;
+    const int slot = this->firstChildSlot(item) + index;
+    const int removed = children[slot];
+    children.erase(children.begin() + slot);
+    this->releaseItem(removed);
+}
+
+void
+SoFlGraphEditorModel::childReplaced(int item, int index)
+{
+    this->childRemoved(item, index);
+    this->childInserted(item, index);
+}
+
+void
+SoFlGraphEditorModel::childrenRemoved(int item)
+{
+    std::vector<int> & children = this->items[item].children;
+    const int first = this->firstChildSlot(item);
+    const std::vector<int> removed(children.begin() + first, children.end());
+    children.resize(first);
+    for (int child : removed)
+        this->releaseItem(child);
+}
+
+void
+SoFlGraphEditorModel::sensorCB(void * closure, SoSensor * s)
+{
+    auto * model = static_cast<SoFlGraphEditorModel *>(closure);
+    auto * sensor = static_cast<SoNodeSensor *>(s);
+
+    // Field edits leave the tree alone; only group changes matter.
+    const SoNotRec::OperationType op = sensor->getTriggerOperationType();
+    if (op == SoNotRec::UNSPECIFIED || op == SoNotRec::FIELD_UPDATE) return;
+
+    const int item = model->findItem(sensor->getTriggerNode());
+    if (item < 0) return;
+
+    // Children which were never materialized need no patching, but the
+    // expander may have to appear or go away.
+    if (model->items[item].populated) {
+        const SoChildList * children = model->items[item].node->getChildren();
+        const int count = children ? children->getLength() : 0;
+        const int index = sensor->getTriggerIndex();
+        switch (op) {
+        case SoNotRec::GROUP_ADDCHILD:
+            model->childInserted(item, count - 1);
+            break;
+        case SoNotRec::GROUP_INSERTCHILD:
+            model->childInserted(item, index);
+            break;
+        case SoNotRec::GROUP_REMOVECHILD:
+            model->childRemoved(item, index);
+            break;
+        case SoNotRec::GROUP_REPLACECHILD:
+            model->childReplaced(item, index);
+            break;
+        case SoNotRec::GROUP_REMOVEALLCHILDREN:
+            model->childrenRemoved(item);
+            break;
+        default:
+            break;
+        }
+
+        const int patched = static_cast<int>(model->items[item].children.size()) -
+            model->firstChildSlot(item);
+        if (patched != count) {
+#if SOFL_DEBUG
+            SoDebugError::postWarning("SoFlGraphEditorModel::sensorCB",
+                                      "out of sync with %s, rebuilding",
+                                      model->items[item].node->getTypeId().getName().getString());
+#endif
+            model->repopulate(item);
+        }
+    }
+
+    model->rowsdirty = true;
+    if (model->changecb) model->changecb(model->changeclosure);
+}
+
+void
+SoFlGraphEditorModel::ensureRows() const
+{
+    if (!this->rowsdirty) return;
+    this->rowsdirty = false;
+    this->rows.clear();
+    if (this->root) this->appendVisible(0, this->rows);
+}
+
+void
+SoFlGraphEditorModel::appendVisible(int item, std::vector<int> & out) const
+{
+    out.push_back(item);
+    if (!this->items[item].expanded) return;
+    for (int child : this->items[item].children)
+        this->appendVisible(child, out);
+}
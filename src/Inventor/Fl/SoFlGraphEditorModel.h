@@ -0,0 +1,151 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGRAPHEDITORMODEL_H
+#define SOFL_SOFLGRAPHEDITORMODEL_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbString.h>
+
+#include <unordered_map>
+#include <vector>
+
+class SoField;
+class SoNode;
+class SoNodeSensor;
+class SoSensor;
+
+// Tree model behind the graph editor. Items are created lazily: a
+// node's fields and children are only looked at when the node is
+// expanded, so opening a huge scene graph costs one item. Only the
+// rows currently visible (the expanded part of the tree) are kept in a
+// flat list, which is all a view needs to paint and hit-test.
+//
+// A node referenced from several places in the graph gets its subtree
+// once, under the occurrence expanded first; the other occurrences
+// become leaf items referring to it.
+//
+// The model follows the scene graph: child insertions, removals and
+// replacements are patched into the items already materialized, as
+// they happen. The visible rows are rebuilt lazily the next time they
+// are asked for, so a burst of changes costs one pass over the rows.
+class SoFlGraphEditorModel {
+public:
+    enum Kind {
+        NODE,       // a node, with its fields and children below it
+        FIELDS,     // the "[fields]" group of a node
+        FIELD,      // a single field
+        REFERENCE   // another occurrence of an already listed node
+    };
+
+    struct Item {
+        Kind kind;
+        SoNode * node;  // NULL for a released item
+        SoField * field;
+        int parent;     // -1 for the root
+        int depth;
+        int original;   // for REFERENCE: the item owning the subtree
+        bool expanded;
+        bool populated;
+        std::vector<int> children;
+    };
+
+    typedef void ChangeCB(void * closure);
+
+    SoFlGraphEditorModel();
+    ~SoFlGraphEditorModel();
+
+    // Called after the items were patched for a scene graph change.
+    void setChangeCallback(ChangeCB * callback, void * closure);
+
+    void setRoot(SoNode * root);
+    SoNode * getRoot() const;
+    void clear();
+
+    // Visible rows, top to bottom.
+    int getNumRows() const;
+    int getItemAtRow(int row) const;
+    int getRowOfItem(int item) const;
+
+    // Items materialized so far.
+    int getNumItems() const;
+    const Item & getItem(int item) const;
+    bool isAlive(int item) const;
+    int findItem(const SoNode * node) const;
+
+    bool isExpandable(int item) const;
+    void expand(int item);
+    void collapse(int item);
+    void toggle(int item);
+
+    // Expands the tree along 'path', a list of nodes from the root
+    // down, and returns the item of the last node, or -1 if the path
+    // does not match the graph. Where the path passes through another
+    // occurrence of a shared node, it continues at the listed one.
+    int expandPath(const std::vector<SoNode *> & path);
+
+    SbString getLabel(int item) const;
+
+private:
+    static void sensorCB(void * closure, SoSensor * sensor);
+
+    int addItem(Kind kind, SoNode * node, SoField * field, int parent);
+    int newChild(SoNode * child, int parent);
+    void releaseItem(int item);
+    int firstChildSlot(int item) const;
+    void populate(int item);
+    void repopulate(int item);
+    void childInserted(int item, int index);
+    void childRemoved(int item, int index);
+    void childReplaced(int item, int index);
+    void childrenRemoved(int item);
+    void expandAncestors(int item);
+    void ensureRows() const;
+    void appendVisible(int item, std::vector<int> & out) const;
+
+    SoNode * root;
+    SoNodeSensor * sensor;
+    ChangeCB * changecb;
+    void * changeclosure;
+    std::vector<Item> items;
+    std::vector<int> freeitems;
+    mutable std::vector<int> rows;
+    mutable bool rowsdirty;
+    std::unordered_map<const SoNode *, int> owners;
+    std::unordered_multimap<const SoNode *, int> references;
+};
+
+#endif // !SOFL_SOFLGRAPHEDITORMODEL_H
@@ -52,3 +52,14 @@ dumpWidgetData(const Fl_Widget* widget) {
     <<"h:"<<widget->h();
     return oss.str();
 }
+
+void
+enableWorkerThreads() {
+    // FLTK wants Fl::lock() once, from the main thread, before any other
+    // thread calls Fl::awake(); calling it again would nest the lock.
+    static bool enabled = false;
+    if (!enabled) {
+        Fl::lock();
+        enabled = true;
+    }
+}
@@ -42,4 +42,8 @@ class SoFlInternal {
 std::string dumpWindowData(const Fl_Window* window);
 std::string dumpWidgetData(const Fl_Widget* widget);
 
+// Lets worker threads hand results back through Fl::awake(). Must be
+// called from the main thread before the first worker is started.
+void enableWorkerThreads();
+
 #endif //SOFL_SOFLINTERNAL_H
@@ -31,3 +31,27 @@
 \**************************************************************************/
 
 #include "SoFlLightSliderSet.h"
+
+#include <Inventor/fields/SoSFColor.h>
+#include <Inventor/fields/SoSFFloat.h>
+
+SoFlLightSliderSet::SoFlLightSliderSet(SoNode * light)
+    : SoFlSliderSet(light)
+{
+}
+
+void
+SoFlLightSliderSet::setIntensity(float intensity)
+{
+    SoSFFloat value;
+    value.setValue(intensity);
+    this->setFieldValue("intensity", value);
+}
+
+void
+SoFlLightSliderSet::setColor(const SbColor & color)
+{
+    SoSFColor value;
+    value.setValue(color);
+    this->setFieldValue("color", value);
+}
@@ -29,13 +29,21 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
 #ifndef SOFL_SOFLLIGHTSLIDERSET_H
 #define SOFL_SOFLLIGHTSLIDERSET_H
 
+#include <Inventor/Fl/SoFlSliderSet.h>
 
-class SoFlLightSliderSet {
+class SbColor;
 
-};
+// Edits SoLight nodes.
+class SOFL_DLL_API SoFlLightSliderSet : public SoFlSliderSet {
+public:
+    explicit SoFlLightSliderSet(SoNode * light = nullptr);
 
+    void setIntensity(float intensity);
+    void setColor(const SbColor & color);
+};
 
 #endif //SOFL_SOFLLIGHTSLIDERSET_H
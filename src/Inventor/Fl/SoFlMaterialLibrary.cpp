@@ -0,0 +1,134 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlMaterialLibrary.h"
+#include "Inventor/Fl/SoFlMaterialTable.h"
+
+#include <Inventor/nodes/SoMaterial.h>
+
+#include <cstring>
+
+namespace {
+
+    const SoFlMaterialRecord *
+    lookup(int group, int material)
+    {
+        if (group < 0 || group >= SOFL_NUM_MATERIAL_GROUPS) return nullptr;
+        const SoFlMaterialGroupRecord & g = SOFL_MATERIAL_GROUPS[group];
+        if (material < 0 || material >= g.count) return nullptr;
+        return &SOFL_MATERIALS[g.first + material];
+    }
+
+    SbColor
+    color(const float rgb[3])
+    {
+        return SbColor(rgb[0], rgb[1], rgb[2]);
+    }
+
+} // namespace
+
+int
+SoFlMaterialLibrary::getNumGroups()
+{
+    return SOFL_NUM_MATERIAL_GROUPS;
+}
+
+const char *
+SoFlMaterialLibrary::getGroupName(int group)
+{
+    if (group < 0 || group >= SOFL_NUM_MATERIAL_GROUPS) return nullptr;
+    return SOFL_MATERIAL_GROUPS[group].name;
+}
+
+int
+SoFlMaterialLibrary::findGroup(const char * name)
+{
+    if (!name) return -1;
+    for (int i = 0; i < SOFL_NUM_MATERIAL_GROUPS; i++) {
+        if (std::strcmp(SOFL_MATERIAL_GROUPS[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+int
+SoFlMaterialLibrary::getNumMaterials(int group)
+{
+    if (group < 0 || group >= SOFL_NUM_MATERIAL_GROUPS) return 0;
+    return SOFL_MATERIAL_GROUPS[group].count;
+}
+
+const char *
+SoFlMaterialLibrary::getMaterialName(int group, int material)
+{
+    const SoFlMaterialRecord * record = lookup(group, material);
+    return record ? record->name : nullptr;
+}
+
+int
+SoFlMaterialLibrary::findMaterial(int group, const char * name)
+{
+    if (!name) return -1;
+    const int count = SoFlMaterialLibrary::getNumMaterials(group);
+    for (int i = 0; i < count; i++) {
+        if (std::strcmp(lookup(group, i)->name, name) == 0) return i;
+    }
+    return -1;
+}
+
+SoMaterial *
+SoFlMaterialLibrary::createMaterial(int group, int material)
+{
+    if (!lookup(group, material)) return nullptr;
+    auto * node = new SoMaterial;
+    node->setName(SoFlMaterialLibrary::getMaterialName(group, material));
+    SoFlMaterialLibrary::getMaterial(group, material, node);
+    return node;
+}
+
+bool
+SoFlMaterialLibrary::getMaterial(int group, int material, SoMaterial * node)
+{
+    const SoFlMaterialRecord * record = lookup(group, material);
+    if (!record || !node) return false;
+    node->ambientColor.setValue(color(record->ambient));
+    node->diffuseColor.setValue(color(record->diffuse));
+    node->specularColor.setValue(color(record->specular));
+    node->emissiveColor.setValue(color(record->emissive));
+    node->shininess.setValue(record->shininess);
+    node->transparency.setValue(record->transparency);
+    return true;
+}
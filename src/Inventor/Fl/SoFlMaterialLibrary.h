@@ -0,0 +1,67 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_MATERIALLIBRARY_H
+#define SOFL_MATERIALLIBRARY_H
+
+#include "Inventor/Fl/SoFlBasic.h"
+
+class SoMaterial;
+
+// The stock material library, organised in named groups. The values
+// are compiled into the library, so browsing it costs no file access
+// or parsing; a SoMaterial node is only created when a material is
+// actually asked for.
+class SOFL_DLL_API SoFlMaterialLibrary {
+public:
+    static int getNumGroups();
+    static const char * getGroupName(int group);
+    // -1 if there is no group by that name.
+    static int findGroup(const char * name);
+
+    static int getNumMaterials(int group);
+    static const char * getMaterialName(int group, int material);
+    static int findMaterial(int group, const char * name);
+
+    // Returns a new node with zero references, or nullptr for an
+    // invalid index.
+    static SoMaterial * createMaterial(int group, int material);
+    // Sets the values of an existing node. Returns false for an
+    // invalid index, leaving the node untouched.
+    static bool getMaterial(int group, int material, SoMaterial * node);
+
+private:
+    SoFlMaterialLibrary() = delete;
+};
+
+#endif // SOFL_MATERIALLIBRARY_H
@@ -29,4 +29,65 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
 #include "SoFlMaterialSliderSet.h"
+
+#include <Inventor/fields/SoMFColor.h>
+#include <Inventor/fields/SoMFFloat.h>
+
+SoFlMaterialSliderSet::SoFlMaterialSliderSet(SoNode * material)
+    : SoFlSliderSet(material)
+{
+}
+
+void
+SoFlMaterialSliderSet::setAmbientColor(const SbColor & color)
+{
+    this->setColor("ambientColor", color);
+}
+
+void
+SoFlMaterialSliderSet::setDiffuseColor(const SbColor & color)
+{
+    this->setColor("diffuseColor", color);
+}
+
+void
+SoFlMaterialSliderSet::setSpecularColor(const SbColor & color)
+{
+    this->setColor("specularColor", color);
+}
+
+void
+SoFlMaterialSliderSet::setEmissiveColor(const SbColor & color)
+{
+    this->setColor("emissiveColor", color);
+}
+
+void
+SoFlMaterialSliderSet::setShininess(float shininess)
+{
+    this->setFloat("shininess", shininess);
+}
+
+void
+SoFlMaterialSliderSet::setTransparency(float transparency)
+{
+    this->setFloat("transparency", transparency);
+}
+
+void
+SoFlMaterialSliderSet::setColor(const SbName & fieldname, const SbColor & color)
+{
+    SoMFColor value;
+    value.setValue(color);
+    this->setFieldValue(fieldname, value);
+}
+
+void
+SoFlMaterialSliderSet::setFloat(const SbName & fieldname, float v)
+{
+    SoMFFloat value;
+    value.setValue(v);
+    this->setFieldValue(fieldname, value);
+}
@@ -29,13 +29,29 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
 #ifndef SOFL_SOFLMATERIALSLIDERSET_H
 #define SOFL_SOFLMATERIALSLIDERSET_H
 
+#include <Inventor/Fl/SoFlSliderSet.h>
 
-class SoFlMaterialSliderSet {
+class SbColor;
 
-};
+// Edits SoMaterial nodes.
+class SOFL_DLL_API SoFlMaterialSliderSet : public SoFlSliderSet {
+public:
+    explicit SoFlMaterialSliderSet(SoNode * material = nullptr);
 
+    void setAmbientColor(const SbColor & color);
+    void setDiffuseColor(const SbColor & color);
+    void setSpecularColor(const SbColor & color);
+    void setEmissiveColor(const SbColor & color);
+    void setShininess(float shininess);
+    void setTransparency(float transparency);
+
+private:
+    void setColor(const SbName & fieldname, const SbColor & color);
+    void setFloat(const SbName & fieldname, float value);
+};
 
 #endif //SOFL_SOFLMATERIALSLIDERSET_H
@@ -0,0 +1,67 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_MATERIALTABLE_H
+#define SOFL_MATERIALTABLE_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+// Layout of the material library table. The table itself is generated
+// at build time from data/materials by MaterialTable.cmake, so it is
+// plain constant data: nothing is parsed or allocated to use it.
+
+struct SoFlMaterialRecord {
+    const char * name;
+    float ambient[3];
+    float diffuse[3];
+    float specular[3];
+    float emissive[3];
+    float shininess;
+    float transparency;
+};
+
+// A group owns the records [first, first + count) of SOFL_MATERIALS.
+struct SoFlMaterialGroupRecord {
+    const char * name;
+    int first;
+    int count;
+};
+
+extern const SoFlMaterialGroupRecord SOFL_MATERIAL_GROUPS[];
+extern const SoFlMaterialRecord SOFL_MATERIALS[];
+extern const int SOFL_NUM_MATERIAL_GROUPS;
+extern const int SOFL_NUM_MATERIALS;
+
+#endif // SOFL_MATERIALTABLE_H
@@ -0,0 +1,369 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlMultiViewRenderArea.h"
+
+#include <Inventor/SbColor.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoHandleEventAction.h>
+#include <Inventor/events/SoMouseButtonEvent.h>
+#include <Inventor/nodes/SoCamera.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "sofldefs.h"
+
+namespace {
+
+    // A rectangle of pixels, [x0, x1) by [y0, y1).
+    struct PixelRect {
+        int x0, y0, x1, y1;
+
+        bool isEmpty() const { return x0 >= x1 || y0 >= y1; }
+
+        PixelRect intersect(const PixelRect & other) const {
+            const PixelRect result = { std::max(x0, other.x0), std::max(y0, other.y0),
+                                       std::min(x1, other.x1), std::min(y1, other.y1) };
+            return result;
+        }
+    };
+
+    PixelRect
+    viewportRect(const SbViewportRegion & region) {
+        const SbVec2s origin = region.getViewportOriginPixels();
+        const SbVec2s size = region.getViewportSizePixels();
+        const PixelRect rect = { origin[0], origin[1], origin[0] + size[0], origin[1] + size[1] };
+        return rect;
+    }
+
+    // Replaces the rectangles in 'rects' with what is left of them
+    // outside 'cut', at most four pieces each.
+    void
+    subtract(std::vector<PixelRect> & rects, const PixelRect & cut) {
+        std::vector<PixelRect> left;
+        for (const PixelRect & rect : rects) {
+            const PixelRect overlap = rect.intersect(cut);
+            if (overlap.isEmpty()) {
+                left.push_back(rect);
+                continue;
+            }
+            const PixelRect pieces[4] = {
+                { rect.x0, rect.y0, rect.x1, overlap.y0 },          // below
+                { rect.x0, overlap.y1, rect.x1, rect.y1 },          // above
+                { rect.x0, overlap.y0, overlap.x0, overlap.y1 },    // left
+                { overlap.x1, overlap.y0, rect.x1, overlap.y1 }     // right
+            };
+            for (const PixelRect & piece : pieces) {
+                if (!piece.isEmpty()) left.push_back(piece);
+            }
+        }
+        rects.swap(left);
+    }
+
+    void
+    setScissor(const PixelRect & rect) {
+        glScissor(rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+    }
+
+} // namespace
+
+/*!
+  \class SoFlMultiViewRenderArea Inventor/Fl/SoFlMultiViewRenderArea.h
+  \brief A render area showing several views in one GL widget.
+
+  Each view has a viewport, given as fractions of the render area, a
+  camera, and optionally a scene graph of its own; views without one
+  show the render area's scene graph. A four-view CAD layout onto one
+  model is set up like this:
+
+  \code
+  SoFlMultiViewRenderArea * area = new SoFlMultiViewRenderArea(window);
+  area->setSceneGraph(model);
+  area->addView(SbVec2f(0.0f, 0.5f), SbVec2f(0.5f, 0.5f), top);
+  area->addView(SbVec2f(0.5f, 0.5f), SbVec2f(0.5f, 0.5f), front);
+  area->addView(SbVec2f(0.0f, 0.0f), SbVec2f(0.5f, 0.5f), side);
+  area->addView(SbVec2f(0.5f, 0.0f), SbVec2f(0.5f, 0.5f), perspective);
+  \endcode
+
+  All views are rendered with the render area's GL render action into
+  its one context, so display lists, textures and other render caches
+  are shared between them. Events are handled in the view under the
+  cursor, with that view's viewport, so picking and draggers work per
+  view.
+
+  Partial redraws and progressive antialiasing work on the render
+  area's one camera and viewport, and are not available here:
+  SoFlGLArea::setPartialRedraw() returns \c false and
+  SoFlGLWidget::setAccumulationBuffer() leaves accumulation off.
+*/
+
+SOFL_OBJECT_SOURCE(SoFlMultiViewRenderArea);
+
+SoFlMultiViewRenderArea::SoFlMultiViewRenderArea(Fl_Window *parent,
+                                                 const char *name,
+                                                 SbBool embed,
+                                                 SbBool mouseInput,
+                                                 SbBool keyboardInput)
+    : inherited(parent, name, embed, mouseInput, keyboardInput),
+      scene(nullptr),
+      grab(-1) {
+    // The scene manager renders and watches the roots of all views, so
+    // a change in any of them schedules a redraw.
+    this->viewroots = new SoGroup;
+    this->viewroots->ref();
+    inherited::setSceneGraph(this->viewroots);
+}
+
+SoFlMultiViewRenderArea::~SoFlMultiViewRenderArea() {
+    inherited::setSceneGraph(nullptr);
+    for (View &view : this->views) view.root->unref();
+    this->viewroots->unref();
+    if (this->scene) this->scene->unref();
+}
+
+void
+SoFlMultiViewRenderArea::setSceneGraph(SoNode *newscene) {
+    if (newscene) newscene->ref();
+    if (this->scene) this->scene->unref();
+    this->scene = newscene;
+    for (View &view : this->views) {
+        if (!view.scene) this->updateView(view);
+    }
+}
+
+SoNode *
+SoFlMultiViewRenderArea::getSceneGraph() {
+    return this->scene;
+}
+
+int
+SoFlMultiViewRenderArea::addView(const SbVec2f &origin, const SbVec2f &size,
+                                 SoCamera *camera, SoNode *viewscene) {
+    View view;
+    view.origin = origin;
+    view.size = size;
+    view.camera = camera;
+    view.scene = viewscene;
+    view.root = new SoSeparator;
+    view.root->ref();
+    this->updateView(view);
+    this->views.push_back(view);
+    this->viewroots->addChild(view.root);
+    return int(this->views.size()) - 1;
+}
+
+void
+SoFlMultiViewRenderArea::removeView(int index) {
+    if (index < 0 || index >= this->getNumViews()) return;
+    View &view = this->views[index];
+    this->viewroots->removeChild(view.root);
+    view.root->unref();
+    this->views.erase(this->views.begin() + index);
+    if (this->grab == index) this->grab = -1;
+    else if (this->grab > index) --this->grab;
+}
+
+int
+SoFlMultiViewRenderArea::getNumViews() const {
+    return int(this->views.size());
+}
+
+void
+SoFlMultiViewRenderArea::setViewport(int index, const SbVec2f &origin, const SbVec2f &size) {
+    if (index < 0 || index >= this->getNumViews()) return;
+    this->views[index].origin = origin;
+    this->views[index].size = size;
+    this->scheduleRedraw();
+}
+
+/*!
+  Returns the viewport of \a view in pixels of the current window size.
+*/
+SbViewportRegion
+SoFlMultiViewRenderArea::getViewportRegion(int index) const {
+    const SbViewportRegion &area = this->getViewportRegion();
+    SbViewportRegion region(area);
+    if (index < 0 || index >= this->getNumViews()) return region;
+
+    // Adjacent views round to the same pixel edge, so they neither
+    // overlap nor leave gaps.
+    const View &view = this->views[index];
+    const SbVec2s window = area.getViewportSizePixels();
+    const SbVec2s areaorigin = area.getViewportOriginPixels();
+    short corners[2][2];
+    for (int i = 0; i < 2; ++i) {
+        const float lower = view.origin[i];
+        const float upper = view.origin[i] + view.size[i];
+        corners[0][i] = short(std::lround(std::min(std::max(lower, 0.0f), 1.0f) * window[i]));
+        corners[1][i] = short(std::lround(std::min(std::max(upper, 0.0f), 1.0f) * window[i]));
+    }
+    region.setViewportPixels(short(areaorigin[0] + corners[0][0]),
+                             short(areaorigin[1] + corners[0][1]),
+                             std::max(short(corners[1][0] - corners[0][0]), short(1)),
+                             std::max(short(corners[1][1] - corners[0][1]), short(1)));
+    return region;
+}
+
+void
+SoFlMultiViewRenderArea::setCamera(int index, SoCamera *camera) {
+    if (index < 0 || index >= this->getNumViews()) return;
+    this->views[index].camera = camera;
+    this->updateView(this->views[index]);
+}
+
+SoCamera *
+SoFlMultiViewRenderArea::getCamera(int index) const {
+    if (index < 0 || index >= this->getNumViews()) return nullptr;
+    return this->views[index].camera;
+}
+
+void
+SoFlMultiViewRenderArea::setViewSceneGraph(int index, SoNode *viewscene) {
+    if (index < 0 || index >= this->getNumViews()) return;
+    this->views[index].scene = viewscene;
+    this->updateView(this->views[index]);
+}
+
+SoNode *
+SoFlMultiViewRenderArea::getViewSceneGraph(int index) const {
+    if (index < 0 || index >= this->getNumViews()) return nullptr;
+    return this->views[index].scene;
+}
+
+int
+SoFlMultiViewRenderArea::getViewAt(const SbVec2s &pos) const {
+    for (int i = this->getNumViews() - 1; i >= 0; --i) {
+        const SbViewportRegion region = this->getViewportRegion(i);
+        const SbVec2s origin = region.getViewportOriginPixels();
+        const SbVec2s size = region.getViewportSizePixels();
+        if (pos[0] >= origin[0] && pos[0] < origin[0] + size[0] &&
+            pos[1] >= origin[1] && pos[1] < origin[1] + size[1]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// The camera and the scene go under a separator of the view's own,
+// which keeps the camera out of the other views. The view's root holds
+// the references, so cameras and scenes are kept alive as long as a
+// view uses them.
+void
+SoFlMultiViewRenderArea::updateView(View &view) {
+    view.root->removeAllChildren();
+    if (view.camera) view.root->addChild(view.camera);
+    SoNode *viewscene = view.scene ? view.scene : this->scene;
+    if (viewscene) view.root->addChild(viewscene);
+}
+
+// A scissor box set by whoever draws the frame is respected; the views
+// are drawn inside it, and it is put back afterwards.
+void
+SoFlMultiViewRenderArea::actualRedraw() {
+    SoGLRenderAction *action = this->getGLRenderAction();
+    const SbViewportRegion full = action->getViewportRegion();
+    const SbBool clear = this->isClearBeforeRender();
+    const SbColor &background = this->getBackgroundColor();
+    glClearColor(background[0], background[1], background[2], 0.0f);
+
+    const GLboolean scissored = glIsEnabled(GL_SCISSOR_TEST);
+    GLint box[4];
+    glGetIntegerv(GL_SCISSOR_BOX, box);
+    const SbVec2s window = full.getWindowSize();
+    PixelRect limit = { 0, 0, window[0], window[1] };
+    if (scissored) {
+        const PixelRect scissor = { box[0], box[1], box[0] + box[2], box[1] + box[3] };
+        limit = limit.intersect(scissor);
+    }
+
+    // The render action sets the GL viewport from its viewport region,
+    // the scissor box keeps each view's clear inside it.
+    glEnable(GL_SCISSOR_TEST);
+    std::vector<PixelRect> gaps(1, limit);
+    for (int i = 0; i < this->getNumViews(); ++i) {
+        const SbViewportRegion region = this->getViewportRegion(i);
+        const PixelRect rect = viewportRect(region);
+        subtract(gaps, rect);
+        const PixelRect visible = rect.intersect(limit);
+        if (visible.isEmpty()) continue;
+        setScissor(visible);
+        // Views may overlap, so each one clears what it covers.
+        if (clear) glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        else glClear(GL_DEPTH_BUFFER_BIT);
+        action->setViewportRegion(region);
+        action->apply(this->views[i].root);
+    }
+    // Only what no view covers is cleared on its own.
+    if (clear) {
+        for (const PixelRect &gap : gaps) {
+            setScissor(gap);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
+    }
+
+    if (!scissored) glDisable(GL_SCISSOR_TEST);
+    glScissor(box[0], box[1], box[2], box[3]);
+    action->setViewportRegion(full);
+}
+
+SbBool
+SoFlMultiViewRenderArea::processSoEvent(const SoEvent * const event) {
+    const bool press =
+        SoMouseButtonEvent::isButtonPressEvent(event, SoMouseButtonEvent::ANY) ? true : false;
+    const bool release =
+        SoMouseButtonEvent::isButtonReleaseEvent(event, SoMouseButtonEvent::ANY) ? true : false;
+
+    int index = this->grab;
+    if (index < 0 || press) index = this->getViewAt(event->getPosition());
+    if (press) this->grab = index;
+    else if (release) this->grab = -1;
+    if (index < 0) return FALSE;
+
+    SoHandleEventAction *action = this->getSceneManager()->getHandleEventAction();
+    const SbViewportRegion full = action->getViewportRegion();
+    action->setViewportRegion(this->getViewportRegion(index));
+    action->setEvent(event);
+    action->apply(this->views[index].root);
+    action->setViewportRegion(full);
+    return action->isHandled();
+}
@@ -0,0 +1,122 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLMULTIVIEWRENDERAREA_H
+#define SOFL_SOFLMULTIVIEWRENDERAREA_H
+
+#include <Inventor/Fl/SoFlRenderArea.h>
+#include <Inventor/SbLinear.h>
+#include <Inventor/SbViewportRegion.h>
+
+#include <vector>
+
+class SoCamera;
+class SoGroup;
+class SoNode;
+class SoSeparator;
+
+// A render area split into several viewports, each with a camera of
+// its own and optionally a scene graph of its own.
+//
+// All views share the render area's GL context, render action and
+// scene manager, so a layout of four views onto one model costs one
+// window, one context and one set of render caches. The views are
+// drawn one after the other in a single frame, each clipped to its
+// viewport, and events go to the view under the cursor. A view keeps
+// getting mouse events from a drag that started in it until the
+// button is released.
+//
+// Viewports are given as fractions of the render area, with the
+// origin in the lower left corner, so they follow the render area
+// when it is resized. Views drawn later are drawn on top.
+//
+// Partial redraws and accumulation render through the render area's
+// one camera and viewport, so they are turned off for this class.
+class SOFL_DLL_API SoFlMultiViewRenderArea : public SoFlRenderArea {
+    SOFL_OBJECT_HEADER(SoFlMultiViewRenderArea, SoFlRenderArea);
+
+public:
+    SoFlMultiViewRenderArea(Fl_Window * parent = nullptr,
+                            const char * name = nullptr,
+                            SbBool embed = TRUE,
+                            SbBool mouseInput = TRUE,
+                            SbBool keyboardInput = TRUE);
+    ~SoFlMultiViewRenderArea();
+
+    // The scene graph of the views that have none of their own.
+    void setSceneGraph(SoNode * scene) override;
+    SoNode * getSceneGraph() override;
+
+    // Adds a view and returns its index. Without a camera the view
+    // looks through the first camera in its scene graph.
+    int addView(const SbVec2f & origin, const SbVec2f & size,
+                SoCamera * camera = nullptr, SoNode * scene = nullptr);
+    void removeView(int view);
+    int getNumViews() const;
+
+    void setViewport(int view, const SbVec2f & origin, const SbVec2f & size);
+    using SoFlRenderArea::getViewportRegion;
+    SbViewportRegion getViewportRegion(int view) const;
+
+    void setCamera(int view, SoCamera * camera);
+    SoCamera * getCamera(int view) const;
+
+    // Null goes back to the render area's scene graph.
+    void setViewSceneGraph(int view, SoNode * scene);
+    SoNode * getViewSceneGraph(int view) const;
+
+    // The topmost view at 'pos', in pixels from the lower left corner,
+    // or -1 if there is none.
+    int getViewAt(const SbVec2s & pos) const;
+
+protected:
+    void actualRedraw() override;
+    SbBool processSoEvent(const SoEvent * const event) override;
+
+private:
+    struct View {
+        SbVec2f origin;
+        SbVec2f size;
+        SoCamera * camera;
+        SoNode * scene;
+        SoSeparator * root;
+    };
+
+    void updateView(View & view);
+
+    std::vector<View> views;
+    SoNode * scene;
+    SoGroup * viewroots;
+    int grab;
+};
+
+#endif // SOFL_SOFLMULTIVIEWRENDERAREA_H
@@ -0,0 +1,648 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/SoFlPickCache.h"
+#include "Inventor/Fl/SoFlInternal.h"
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoFullPath.h>
+#include <Inventor/SoPrimitiveVertex.h>
+#include <Inventor/actions/SoCallbackAction.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/nodes/SoBaseColor.h>
+#include <Inventor/nodes/SoCamera.h>
+#include <Inventor/nodes/SoLight.h>
+#include <Inventor/nodes/SoMaterial.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoShape.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <FL/Fl.H>
+
+#include <algorithm>
+#include <cfloat>
+#include <thread>
+
+#include "sofldefs.h"
+
+namespace {
+
+    const unsigned int NO_PARENT = ~0u;
+    // Triangles per leaf.
+    const unsigned int LEAF_SIZE = 4;
+    // Deep enough for any tree the median split builds.
+    const int MAX_DEPTH = 64;
+
+    // Nodes that never change geometry, so edits to them need no refit.
+    // The camera is one of them: it moves all the time in a viewer.
+    bool
+    isAppearance(const SoNode *node) {
+        return node->isOfType(SoCamera::getClassTypeId()) ||
+               node->isOfType(SoLight::getClassTypeId()) ||
+               node->isOfType(SoMaterial::getClassTypeId()) ||
+               node->isOfType(SoBaseColor::getClassTypeId());
+    }
+
+    bool
+    hitBox(const SbBox3f &box, const SbVec3f &origin, const SbVec3f &inverse, float tmax) {
+        float tmin = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            float t0 = (box.getMin()[i] - origin[i]) * inverse[i];
+            float t1 = (box.getMax()[i] - origin[i]) * inverse[i];
+            if (t0 > t1) std::swap(t0, t1);
+            tmin = std::max(tmin, t0);
+            tmax = std::min(tmax, t1);
+            if (tmin > tmax) return false;
+        }
+        return true;
+    }
+
+    // Moeller-Trumbore. Returns the distance along the ray, or a
+    // negative value for a miss.
+    float
+    hitTriangle(const SbVec3f *vertex, const SbVec3f &origin, const SbVec3f &direction) {
+        const SbVec3f edge1 = vertex[1] - vertex[0];
+        const SbVec3f edge2 = vertex[2] - vertex[0];
+        const SbVec3f p = direction.cross(edge2);
+        const float determinant = edge1.dot(p);
+        if (determinant == 0.0f) return -1.0f;
+        const float inverse = 1.0f / determinant;
+        const SbVec3f s = origin - vertex[0];
+        const float u = s.dot(p) * inverse;
+        if (u < 0.0f || u > 1.0f) return -1.0f;
+        const SbVec3f q = s.cross(edge1);
+        const float v = direction.dot(q) * inverse;
+        if (v < 0.0f || u + v > 1.0f) return -1.0f;
+        return edge2.dot(q) * inverse;
+    }
+
+    bool
+    outside(const SbPlane &plane, const SbBox3f &box) {
+        const SbVec3f &normal = plane.getNormal();
+        const SbVec3f &min = box.getMin();
+        const SbVec3f &max = box.getMax();
+        const SbVec3f corner(normal[0] >= 0.0f ? max[0] : min[0],
+                             normal[1] >= 0.0f ? max[1] : min[1],
+                             normal[2] >= 0.0f ? max[2] : min[2]);
+        return !plane.isInHalfSpace(corner);
+    }
+
+} // namespace
+
+// Collects the world-space triangles of every shape below a node or
+// path, in traversal order.
+struct SoFlPickCache::Gatherer {
+    std::vector<Triangle> triangles;
+    std::vector<Shape> shapes;
+    SoCamera * camera{nullptr};
+    SbMatrix cameramatrix;
+
+    template<typename T>
+    void apply(T * what) {
+        SoCallbackAction action;
+        action.addPreCallback(SoCamera::getClassTypeId(), Gatherer::cameraCB, this);
+        action.addPreCallback(SoShape::getClassTypeId(), Gatherer::shapeCB, this);
+        action.addTriangleCallback(SoShape::getClassTypeId(), Gatherer::triangleCB, this);
+        action.apply(what);
+    }
+
+    static SoCallbackAction::Response
+    cameraCB(void *closure, SoCallbackAction *action, const SoNode *node) {
+        Gatherer *thisp = static_cast<Gatherer *>(closure);
+        if (!thisp->camera) {
+            thisp->camera = static_cast<SoCamera *>(const_cast<SoNode *>(node));
+            thisp->cameramatrix = action->getModelMatrix();
+        }
+        return SoCallbackAction::CONTINUE;
+    }
+
+    static SoCallbackAction::Response
+    shapeCB(void *closure, SoCallbackAction *action, const SoNode *) {
+        Gatherer *thisp = static_cast<Gatherer *>(closure);
+        Shape shape;
+        shape.path = action->getCurPath()->copy();
+        shape.path->ref();
+        shape.first = static_cast<unsigned int>(thisp->triangles.size());
+        shape.count = 0;
+        thisp->shapes.push_back(shape);
+        return SoCallbackAction::CONTINUE;
+    }
+
+    static void
+    triangleCB(void *closure, SoCallbackAction *action,
+               const SoPrimitiveVertex *v1, const SoPrimitiveVertex *v2, const SoPrimitiveVertex *v3) {
+        Gatherer *thisp = static_cast<Gatherer *>(closure);
+        const SbMatrix &matrix = action->getModelMatrix();
+        Triangle triangle;
+        matrix.multVecMatrix(v1->getPoint(), triangle.vertex[0]);
+        matrix.multVecMatrix(v2->getPoint(), triangle.vertex[1]);
+        matrix.multVecMatrix(v3->getPoint(), triangle.vertex[2]);
+        triangle.shape = static_cast<unsigned int>(thisp->shapes.size() - 1);
+        thisp->triangles.push_back(triangle);
+        thisp->shapes.back().count++;
+    }
+
+    void release() {
+        for (Shape &shape : this->shapes) shape.path->unref();
+        this->shapes.clear();
+    }
+};
+
+// A hierarchy being built on a worker thread. The worker only ever
+// touches the job; the result is installed by builtCB() in the main
+// thread.
+struct SoFlPickCache::Job {
+    SoFlPickCache * owner{nullptr}; // null once the cache is gone
+    std::vector<Triangle> triangles;
+    std::vector<Node> nodes;
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> leafof;
+    std::vector<unsigned int> parents;
+    std::vector<SbBox3f> bounds;
+    std::vector<SbVec3f> centers;
+
+    void build() {
+        const size_t count = this->triangles.size();
+        this->bounds.resize(count);
+        this->centers.resize(count);
+        this->order.resize(count);
+        this->leafof.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const Triangle &triangle = this->triangles[i];
+            this->bounds[i].makeEmpty();
+            for (const SbVec3f &vertex : triangle.vertex) this->bounds[i].extendBy(vertex);
+            this->centers[i] = this->bounds[i].getCenter();
+            this->order[i] = static_cast<unsigned int>(i);
+        }
+        this->nodes.reserve(count / LEAF_SIZE * 2 + 1);
+        if (count) this->buildNode(0, static_cast<unsigned int>(count), NO_PARENT);
+        this->bounds.clear();
+        this->centers.clear();
+    }
+
+    // Splits at the median along the longest axis of the triangle
+    // centres, which keeps the tree balanced whatever the geometry.
+    unsigned int buildNode(unsigned int first, unsigned int count, unsigned int parent) {
+        const unsigned int index = static_cast<unsigned int>(this->nodes.size());
+        this->nodes.push_back(Node());
+        this->parents.push_back(parent);
+
+        SbBox3f box, centerbox;
+        for (unsigned int i = first; i < first + count; i++) {
+            box.extendBy(this->bounds[this->order[i]]);
+            centerbox.extendBy(this->centers[this->order[i]]);
+        }
+        this->nodes[index].box = box;
+
+        float dx, dy, dz;
+        centerbox.getSize(dx, dy, dz);
+        const int axis = dx >= dy && dx >= dz ? 0 : (dy >= dz ? 1 : 2);
+        if (count <= LEAF_SIZE || std::max(dx, std::max(dy, dz)) <= 0.0f) {
+            this->nodes[index].index = first;
+            this->nodes[index].count = count;
+            for (unsigned int i = first; i < first + count; i++) this->leafof[this->order[i]] = index;
+            return index;
+        }
+
+        const unsigned int middle = first + count / 2;
+        const std::vector<SbVec3f> &centers = this->centers;
+        std::nth_element(this->order.begin() + first, this->order.begin() + middle,
+                         this->order.begin() + first + count,
+                         [&centers, axis](unsigned int a, unsigned int b) {
+                             return centers[a][axis] < centers[b][axis];
+                         });
+        this->buildNode(first, middle - first, index);
+        const unsigned int right = this->buildNode(middle, first + count - middle, index);
+        this->nodes[index].index = right;
+        this->nodes[index].count = 0;
+        return index;
+    }
+};
+
+SoFlPickCache::SoFlPickCache() {
+    this->sensor = new SoNodeSensor(SoFlPickCache::changedCB, this);
+    // Immediate notification, so every change is seen with the path to
+    // what changed rather than just the last one of the frame.
+    this->sensor->setPriority(0);
+    this->sensor->setTriggerPathFlag(TRUE);
+    this->updatesensor = new SoOneShotSensor(SoFlPickCache::updateCB, this);
+}
+
+SoFlPickCache::~SoFlPickCache() {
+    // A build still on a worker thread is deleted by its callback.
+    if (this->job) this->job->owner = nullptr;
+    delete this->sensor;
+    delete this->updatesensor;
+    this->clearPending();
+    this->clearShapes();
+    if (this->root) this->root->unref();
+}
+
+void
+SoFlPickCache::setSceneGraph(SoNode *newroot) {
+    if (newroot == this->root) return;
+    if (newroot) newroot->ref();
+    if (this->root) this->root->unref();
+    this->root = newroot;
+
+    this->sensor->detach();
+    if (newroot) this->sensor->attach(newroot);
+    this->ready = false;
+    this->structural = true;
+    this->updatesensor->schedule();
+}
+
+SoNode *
+SoFlPickCache::getSceneGraph() const {
+    return this->root;
+}
+
+bool
+SoFlPickCache::isReady() const {
+    return this->ready;
+}
+
+void
+SoFlPickCache::clearShapes() {
+    for (Shape &shape : this->shapes) shape.path->unref();
+    this->shapes.clear();
+    this->triangles.clear();
+    this->nodes.clear();
+    this->order.clear();
+    this->leafof.clear();
+    this->parents.clear();
+    if (this->camera) this->camera->unref();
+    this->camera = nullptr;
+}
+
+void
+SoFlPickCache::clearPending() {
+    for (SoPath *path : this->pending) path->unref();
+    this->pending.clear();
+}
+
+void
+SoFlPickCache::changedCB(void *closure, SoSensor *sensor) {
+    static_cast<SoFlPickCache *>(closure)->recordChange(static_cast<SoNodeSensor *>(sensor));
+}
+
+void
+SoFlPickCache::recordChange(SoNodeSensor *sensor) {
+    SoNode *node = sensor->getTriggerNode();
+    if (node && isAppearance(node)) return;
+
+    // Picks miss, and callers fall back, until the index has caught up:
+    // the geometry it holds is out of date from now on.
+    this->ready = false;
+
+    // Field edits can be refitted; anything else, such as children being
+    // added or removed, changes which shapes there are.
+    SoPath *path = sensor->getTriggerField() ? sensor->getTriggerPath() : nullptr;
+    if (!path) {
+        this->structural = true;
+        this->clearPending();
+    } else if (!this->structural) {
+        SoPath *copy = path->copy();
+        copy->ref();
+        this->pending.push_back(copy);
+    }
+    this->updatesensor->schedule();
+}
+
+void
+SoFlPickCache::updateCB(void *closure, SoSensor *) {
+    static_cast<SoFlPickCache *>(closure)->update();
+}
+
+void
+SoFlPickCache::update() {
+    // Whatever changes during a build is looked at once it is done.
+    if (this->job) return;
+    if (this->structural) {
+        this->rebuild();
+        return;
+    }
+
+    std::vector<SoPath *> changes;
+    changes.swap(this->pending);
+    std::vector<SoNode *> done;
+    bool refitted = true;
+    for (SoPath *change : changes) {
+        SoFullPath *path = static_cast<SoFullPath *>(change);
+        if (refitted && std::find(done.begin(), done.end(), path->getTail()) == done.end()) {
+            done.push_back(path->getTail());
+            refitted = this->refit(change);
+        }
+        change->unref();
+    }
+    if (!refitted) this->rebuild();
+    else this->ready = this->root != nullptr;
+}
+
+void
+SoFlPickCache::rebuild() {
+    this->clearPending();
+    this->clearShapes();
+    this->structural = false;
+    this->ready = false;
+    if (!this->root) return;
+
+    Gatherer gather;
+    gather.apply(this->root);
+    this->shapes.swap(gather.shapes);
+    this->camera = gather.camera;
+    if (this->camera) this->camera->ref();
+    this->cameramatrix = gather.cameramatrix;
+
+    this->job = new Job;
+    this->job->owner = this;
+    this->job->triangles.swap(gather.triangles);
+
+    Job *job = this->job;
+    enableWorkerThreads();
+    std::thread([job]() {
+        job->build();
+        Fl::awake(SoFlPickCache::builtCB, job);
+    }).detach();
+}
+
+void
+SoFlPickCache::builtCB(void *closure) {
+    Job *job = static_cast<Job *>(closure);
+    SoFlPickCache *owner = job->owner;
+    if (owner) {
+        owner->job = nullptr;
+        owner->triangles.swap(job->triangles);
+        owner->nodes.swap(job->nodes);
+        owner->order.swap(job->order);
+        owner->leafof.swap(job->leafof);
+        owner->parents.swap(job->parents);
+        // Edits made during the build are refitted, or rebuilt, first.
+        owner->ready = !owner->structural && owner->pending.empty();
+        if (!owner->ready) owner->updatesensor->schedule();
+#if SOFL_DEBUG
+        SoDebugError::postInfo("SoFlPickCache::builtCB",
+                               "%d shapes, %d triangles, %d nodes",
+                               static_cast<int>(owner->shapes.size()),
+                               static_cast<int>(owner->triangles.size()),
+                               static_cast<int>(owner->nodes.size()));
+#endif
+    }
+    delete job;
+}
+
+// Gathers the geometry a field edit can have changed again: everything
+// below the closest separator, or the shape itself if the edit was to
+// a shape. All instances of that part of the graph are updated. Returns
+// false if the shapes changed, such as a switch showing another child,
+// or their triangle counts did, which takes a rebuild.
+bool
+SoFlPickCache::refit(SoPath *change) {
+    SoFullPath *path = static_cast<SoFullPath *>(change);
+    SoNode *scope = nullptr;
+    for (int i = path->getLength() - 1; i > 0 && !scope; i--) {
+        SoNode *node = path->getNode(i);
+        if (node->isOfType(SoSeparator::getClassTypeId()) ||
+            node->isOfType(SoShape::getClassTypeId())) {
+            scope = node;
+        }
+    }
+    if (!scope) return false;
+
+    std::vector<unsigned int> changed;
+    size_t i = 0;
+    while (i < this->shapes.size()) {
+        SoFullPath *shapepath = static_cast<SoFullPath *>(this->shapes[i].path);
+        int depth = 0;
+        while (depth < shapepath->getLength() && shapepath->getNode(depth) != scope) depth++;
+        if (depth == shapepath->getLength()) {
+            i++;
+            continue;
+        }
+
+        // The shapes below one instance follow each other in traversal
+        // order, so they line up with what the gatherer finds.
+        SoPath *instance = shapepath->copy(0, depth + 1);
+        instance->ref();
+        Gatherer gather;
+        gather.apply(instance);
+        instance->unref();
+
+        bool match = !gather.shapes.empty() && i + gather.shapes.size() <= this->shapes.size();
+        for (size_t j = 0; match && j < gather.shapes.size(); j++) {
+            const Shape &shape = this->shapes[i + j];
+            const Shape &fresh = gather.shapes[j];
+            match = fresh.count == shape.count && *fresh.path == *shape.path;
+        }
+        if (match) {
+            for (size_t j = 0; j < gather.shapes.size(); j++) {
+                const Shape &shape = this->shapes[i + j];
+                const Shape &fresh = gather.shapes[j];
+                for (unsigned int t = 0; t < shape.count; t++) {
+                    std::copy(gather.triangles[fresh.first + t].vertex,
+                              gather.triangles[fresh.first + t].vertex + 3,
+                              this->triangles[shape.first + t].vertex);
+                    changed.push_back(shape.first + t);
+                }
+            }
+        }
+        const size_t found = gather.shapes.size();
+        gather.release();
+        if (!match) return false;
+        i += found;
+    }
+    this->refitNodes(changed);
+    return true;
+}
+
+// Recomputes the boxes of the leaves holding the changed triangles and
+// of their ancestors, children before parents.
+void
+SoFlPickCache::refitNodes(const std::vector<unsigned int> &changed) {
+    if (changed.empty()) return;
+    std::vector<bool> dirty(this->nodes.size(), false);
+    for (unsigned int triangle : changed) {
+        for (unsigned int node = this->leafof[triangle]; node != NO_PARENT && !dirty[node];
+             node = this->parents[node]) {
+            dirty[node] = true;
+        }
+    }
+    for (size_t i = this->nodes.size(); i-- > 0;) {
+        if (!dirty[i]) continue;
+        Node &node = this->nodes[i];
+        node.box.makeEmpty();
+        if (node.count) {
+            for (unsigned int j = node.index; j < node.index + node.count; j++) {
+                for (const SbVec3f &vertex : this->triangles[this->order[j]].vertex) {
+                    node.box.extendBy(vertex);
+                }
+            }
+        } else {
+            node.box.extendBy(this->nodes[i + 1].box);
+            node.box.extendBy(this->nodes[node.index].box);
+        }
+    }
+}
+
+SoPath *
+SoFlPickCache::pick(const SbLine &ray, SbVec3f *point) const {
+    if (!this->ready || this->nodes.empty()) return nullptr;
+
+    const SbVec3f &origin = ray.getPosition();
+    const SbVec3f &direction = ray.getDirection();
+    const SbVec3f inverse(1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]);
+
+    float nearest = FLT_MAX;
+    unsigned int hit = NO_PARENT;
+    unsigned int stack[MAX_DEPTH * 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const unsigned int index = stack[--top];
+        const Node &node = this->nodes[index];
+        if (!hitBox(node.box, origin, inverse, nearest)) continue;
+        if (node.count) {
+            for (unsigned int i = node.index; i < node.index + node.count; i++) {
+                const float t = hitTriangle(this->triangles[this->order[i]].vertex, origin, direction);
+                if (t > 0.0f && t < nearest) {
+                    nearest = t;
+                    hit = this->order[i];
+                }
+            }
+        } else {
+            stack[top++] = node.index;
+            stack[top++] = index + 1;
+        }
+    }
+    if (hit == NO_PARENT) return nullptr;
+    if (point) *point = origin + direction * nearest;
+    return this->shapes[this->triangles[hit].shape].path;
+}
+
+// The view through the first camera in the graph, set up the way the
+// camera sets it up for rendering into the viewport.
+bool
+SoFlPickCache::viewVolume(const SbViewportRegion &viewport, SbViewVolume &volume) const {
+    if (!this->camera) return false;
+    const float aspect = viewport.getViewportAspectRatio();
+    volume = this->camera->getViewVolume(aspect);
+    if (aspect < 1.0f) volume.scale(1.0f / aspect);
+    volume.transform(this->cameramatrix);
+    return true;
+}
+
+SoPath *
+SoFlPickCache::pick(const SbViewportRegion &viewport, const SbVec2s &pos, SbVec3f *point) const {
+    SbViewVolume volume;
+    if (!this->ready || !this->viewVolume(viewport, volume)) return nullptr;
+
+    const SbVec2s origin = viewport.getViewportOriginPixels();
+    const SbVec2s size = viewport.getViewportSizePixels();
+    SbLine ray;
+    volume.projectPointToLine(SbVec2f((pos[0] + 0.5f - origin[0]) / size[0],
+                                      (pos[1] + 0.5f - origin[1]) / size[1]), ray);
+    return this->pick(ray, point);
+}
+
+int
+SoFlPickCache::pick(const SbViewportRegion &viewport, const SbBox2s &rect, SoPathList &paths) const {
+    SbViewVolume volume;
+    if (rect.isEmpty() || !this->ready || this->nodes.empty() ||
+        !this->viewVolume(viewport, volume)) return 0;
+
+    // The four side planes of the part of the view volume inside the
+    // rectangle, facing inwards. Depth is not limited.
+    const SbVec2s origin = viewport.getViewportOriginPixels();
+    const SbVec2s size = viewport.getViewportSizePixels();
+    const SbViewVolume band = volume.narrow(float(rect.getMin()[0] - origin[0]) / size[0],
+                                            float(rect.getMin()[1] - origin[1]) / size[1],
+                                            float(rect.getMax()[0] + 1 - origin[0]) / size[0],
+                                            float(rect.getMax()[1] + 1 - origin[1]) / size[1]);
+    SbLine corner[4], center;
+    band.projectPointToLine(SbVec2f(0.0f, 0.0f), corner[0]);
+    band.projectPointToLine(SbVec2f(1.0f, 0.0f), corner[1]);
+    band.projectPointToLine(SbVec2f(1.0f, 1.0f), corner[2]);
+    band.projectPointToLine(SbVec2f(0.0f, 1.0f), corner[3]);
+    band.projectPointToLine(SbVec2f(0.5f, 0.5f), center);
+    const SbVec3f inside = center.getPosition() + center.getDirection();
+    SbPlane planes[4];
+    for (int i = 0; i < 4; i++) {
+        const SbLine &a = corner[i];
+        const SbLine &b = corner[(i + 1) % 4];
+        SbPlane plane(a.getPosition(), b.getPosition(), a.getPosition() + a.getDirection());
+        if (!plane.isInHalfSpace(inside)) {
+            plane = SbPlane(-plane.getNormal(), -plane.getDistanceFromOrigin());
+        }
+        planes[i] = plane;
+    }
+
+    std::vector<bool> seen(this->shapes.size(), false);
+    int found = 0;
+    unsigned int stack[MAX_DEPTH * 2];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const unsigned int index = stack[--top];
+        const Node &node = this->nodes[index];
+        bool visible = true;
+        for (int p = 0; p < 4 && visible; p++) visible = !outside(planes[p], node.box);
+        if (!visible) continue;
+        if (!node.count) {
+            stack[top++] = node.index;
+            stack[top++] = index + 1;
+            continue;
+        }
+        for (unsigned int i = node.index; i < node.index + node.count; i++) {
+            const Triangle &triangle = this->triangles[this->order[i]];
+            if (seen[triangle.shape]) continue;
+            // Conservative: only triangles entirely outside one of the
+            // planes are left out.
+            bool in = true;
+            for (int p = 0; p < 4 && in; p++) {
+                in = planes[p].isInHalfSpace(triangle.vertex[0]) ||
+                     planes[p].isInHalfSpace(triangle.vertex[1]) ||
+                     planes[p].isInHalfSpace(triangle.vertex[2]);
+            }
+            if (!in) continue;
+            seen[triangle.shape] = true;
+            paths.append(this->shapes[triangle.shape].path);
+            found++;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,145 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLPICKCACHE_H
+#define SOFL_SOFLPICKCACHE_H
+
+#include "Inventor/Fl/SoFlBasic.h"
+
+#include <Inventor/SbLinear.h>
+
+#include <vector>
+
+class SbViewportRegion;
+class SoCamera;
+class SoNode;
+class SoNodeSensor;
+class SoOneShotSensor;
+class SoPath;
+class SoPathList;
+class SoSensor;
+
+// A bounding volume hierarchy over the world-space triangles of a
+// scene graph, answering ray and rectangle picks in logarithmic time
+// instead of with a traversal of the whole graph.
+//
+// Triangles are gathered on the main thread, once per frame with
+// changes, and the hierarchy is built on a worker thread; the result
+// is installed from the FLTK main loop. Until then, and from any edit
+// until the index has caught up with it, isReady() is false and picks
+// miss, so callers fall back to SoRayPickAction. Edits that
+// only move or reshape existing geometry, such as coordinate,
+// transform or shape field changes, refit the hierarchy in place;
+// structural changes rebuild it.
+//
+// Only polygonal geometry is indexed. Lines, points and 2D text are
+// not pickable through the cache.
+class SOFL_DLL_API SoFlPickCache {
+public:
+    SoFlPickCache();
+    ~SoFlPickCache();
+
+    // The graph to index, usually the scene manager's root so that the
+    // camera is included for screen picks.
+    void setSceneGraph(SoNode * root);
+    SoNode * getSceneGraph() const;
+
+    bool isReady() const;
+
+    // The shape nearest along 'ray', in world space. Writes the hit
+    // point to 'point' if given. The path belongs to the cache and is
+    // valid until the next change of the graph; ref() it to keep it.
+    SoPath * pick(const SbLine & ray, SbVec3f * point = nullptr) const;
+    // The same for a position in pixels in the viewport, seen through
+    // the first camera in the graph.
+    SoPath * pick(const SbViewportRegion & viewport, const SbVec2s & pos,
+                  SbVec3f * point = nullptr) const;
+    // Appends the paths of all shapes inside a rubber band rectangle,
+    // in pixels, to 'paths', and returns how many were found.
+    int pick(const SbViewportRegion & viewport, const SbBox2s & rect,
+             SoPathList & paths) const;
+
+private:
+    struct Triangle {
+        SbVec3f vertex[3];
+        unsigned int shape;
+    };
+    struct Shape {
+        SoPath * path;
+        // Its triangles, as a range of 'triangles'.
+        unsigned int first;
+        unsigned int count;
+    };
+    // Nodes are stored depth first. An inner node's left child follows
+    // it and 'index' is its right child; a leaf has 'count' triangles,
+    // listed in 'order' from 'index' on.
+    struct Node {
+        SbBox3f box;
+        unsigned int index;
+        unsigned int count;
+    };
+    struct Gatherer;
+    struct Job;
+
+    static void changedCB(void * closure, SoSensor * sensor);
+    static void updateCB(void * closure, SoSensor * sensor);
+    static void builtCB(void * job);
+    void recordChange(SoNodeSensor * sensor);
+    void update();
+    void rebuild();
+    bool refit(SoPath * change);
+    void refitNodes(const std::vector<unsigned int> & triangles);
+    void clearShapes();
+    void clearPending();
+    bool viewVolume(const SbViewportRegion & viewport, SbViewVolume & volume) const;
+
+    SoNode * root{nullptr};
+    SoNodeSensor * sensor{nullptr};
+    SoOneShotSensor * updatesensor{nullptr};
+    std::vector<SoPath *> pending;
+    bool structural{false};
+
+    // Indexed geometry, valid while ready.
+    std::vector<Triangle> triangles;
+    std::vector<Shape> shapes;
+    std::vector<Node> nodes;
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> leafof;
+    std::vector<unsigned int> parents;
+    SoCamera * camera{nullptr};
+    SbMatrix cameramatrix;
+    bool ready{false};
+
+    Job * job{nullptr};
+};
+
+#endif //SOFL_SOFLPICKCACHE_H
@@ -31,3 +31,8 @@
 \**************************************************************************/
 
 #include "SoFlSliderSet.h"
+
+SoFlSliderSet::SoFlSliderSet(SoNode * node)
+    : SoFlSliderSetBase(node)
+{
+}
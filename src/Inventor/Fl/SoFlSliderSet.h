@@ -29,13 +29,15 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
 #ifndef SOFL_SOFLSLIDERSET_H
 #define SOFL_SOFLSLIDERSET_H
 
+#include <Inventor/Fl/SoFlSliderSetBase.h>
 
-class SoFlSliderSet {
-
+class SOFL_DLL_API SoFlSliderSet : public SoFlSliderSetBase {
+protected:
+    explicit SoFlSliderSet(SoNode * node = nullptr);
 };
 
-
 #endif //SOFL_SOFLSLIDERSET_H
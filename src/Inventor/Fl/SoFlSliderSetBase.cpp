@@ -29,4 +29,119 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
 #include "SoFlSliderSetBase.h"
+
+#include <Inventor/fields/SoField.h>
+#include <Inventor/nodes/SoNode.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <vector>
+
+SoFlSliderSetBase::SoFlSliderSetBase(SoNode * node)
+{
+    this->flushsensor = new SoOneShotSensor(SoFlSliderSetBase::flushCB, this);
+    if (node) this->nodes.append(node);
+}
+
+SoFlSliderSetBase::~SoFlSliderSetBase()
+{
+    // Edits already made by the user are not lost.
+    this->flush();
+    delete this->flushsensor;
+}
+
+void
+SoFlSliderSetBase::setNode(SoNode * node)
+{
+    SoNodeList list;
+    if (node) list.append(node);
+    this->setNodes(list);
+}
+
+SoNode *
+SoFlSliderSetBase::getNode() const
+{
+    return this->nodes.getLength() > 0 ? this->nodes[0] : nullptr;
+}
+
+void
+SoFlSliderSetBase::setNodes(const SoNodeList & list)
+{
+    // Pending edits belong to the old selection.
+    this->flush();
+    this->nodes = list;
+}
+
+const SoNodeList &
+SoFlSliderSetBase::getNodes() const
+{
+    return this->nodes;
+}
+
+bool
+SoFlSliderSetBase::hasPendingEdits() const
+{
+    return !this->pending.empty();
+}
+
+void
+SoFlSliderSetBase::setFieldValue(const SbName & fieldname, const SoField & value)
+{
+    SoField *& queued = this->pending[fieldname.getString()];
+    if (queued && queued->getTypeId() != value.getTypeId()) {
+        delete queued;
+        queued = nullptr;
+    }
+    if (!queued) queued = static_cast<SoField *>(value.getTypeId().createInstance());
+    if (!queued) {
+        this->pending.erase(fieldname.getString());
+        return;
+    }
+    queued->copyFrom(value);
+
+    if (!this->flushsensor->isScheduled()) this->flushsensor->schedule();
+}
+
+void
+SoFlSliderSetBase::flush()
+{
+    if (this->flushsensor->isScheduled()) this->flushsensor->unschedule();
+    if (this->pending.empty()) return;
+
+    for (int i = 0; i < this->nodes.getLength(); i++) {
+        SoNode * node = this->nodes[i];
+        const SbBool notify = node->enableNotify(FALSE);
+        bool changed = false;
+        for (const auto & edit : this->pending) {
+            SoField * field = node->getField(SbName(edit.first));
+            if (!field || field->getTypeId() != edit.second->getTypeId()) continue;
+            if (*field == *edit.second) continue;
+            // Connections and field sensors still see the write; the
+            // node and what is above it do not, until the touch below.
+            field->copyFrom(*edit.second);
+            changed = true;
+        }
+        node->enableNotify(notify);
+        // One notification per node for the whole batch.
+        if (changed && notify) node->touch();
+    }
+    this->discardPending();
+}
+
+void
+SoFlSliderSetBase::discardPending()
+{
+    for (const auto & edit : this->pending) delete edit.second;
+    this->pending.clear();
+}
+
+void
+SoFlSliderSetBase::flushCB(void * closure, SoSensor *)
+{
+    static_cast<SoFlSliderSetBase *>(closure)->flush();
+}
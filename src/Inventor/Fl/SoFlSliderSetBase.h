@@ -33,10 +33,56 @@
 #ifndef SOFL_SOFLSLIDERSETBASE_H
 #define SOFL_SOFLSLIDERSETBASE_H
 
+#include <Inventor/Fl/SoFlBasic.h>
+#include <Inventor/SbName.h>
+#include <Inventor/lists/SoNodeList.h>
 
-class SoFlSliderSetBase {
+#include <map>
 
-};
+class SoField;
+class SoNode;
+class SoOneShotSensor;
+class SoSensor;
+
+// Base for the slider sets, which edit fields of a node or of a
+// selection of nodes of the same kind.
+//
+// Slider moves are not written straight to the nodes. They are queued,
+// keeping only the latest value per field, and written in one batch per
+// round of Coin sensor processing with notification turned off; each
+// node is then touched once. However fast the user drags, the scene
+// sees one change per frame.
+class SOFL_DLL_API SoFlSliderSetBase {
+public:
+    virtual ~SoFlSliderSetBase();
+
+    virtual void setNode(SoNode * node);
+    SoNode * getNode() const;
+
+    // Edits apply to every node of the list.
+    virtual void setNodes(const SoNodeList & nodes);
+    const SoNodeList & getNodes() const;
+
+    // Writes out the queued edits right away.
+    void flush();
+    bool hasPendingEdits() const;
 
+protected:
+    explicit SoFlSliderSetBase(SoNode * node = nullptr);
+
+    // Queues 'value' for the field 'fieldname' of the edited nodes,
+    // replacing what was queued for it before. Nodes without such a
+    // field, or with a field of another type, are left alone.
+    void setFieldValue(const SbName & fieldname, const SoField & value);
+
+private:
+    static void flushCB(void * closure, SoSensor * sensor);
+    void discardPending();
+
+    SoNodeList nodes;
+    // Keyed on SbName::getString(), which is unique per name.
+    std::map<const char *, SoField *> pending;
+    SoOneShotSensor * flushsensor;
+};
 
 #endif //SOFL_SOFLSLIDERSETBASE_H
@@ -29,4 +29,47 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
+
 #include "SoFlTransformSliderSet.h"
+
+#include <Inventor/fields/SoSFRotation.h>
+#include <Inventor/fields/SoSFVec3f.h>
+
+SoFlTransformSliderSet::SoFlTransformSliderSet(SoNode * transform)
+    : SoFlSliderSet(transform)
+{
+}
+
+void
+SoFlTransformSliderSet::setTranslation(const SbVec3f & translation)
+{
+    this->setVec3f("translation", translation);
+}
+
+void
+SoFlTransformSliderSet::setRotation(const SbRotation & rotation)
+{
+    SoSFRotation value;
+    value.setValue(rotation);
+    this->setFieldValue("rotation", value);
+}
+
+void
+SoFlTransformSliderSet::setScaleFactor(const SbVec3f & scale)
+{
+    this->setVec3f("scaleFactor", scale);
+}
+
+void
+SoFlTransformSliderSet::setCenter(const SbVec3f & center)
+{
+    this->setVec3f("center", center);
+}
+
+void
+SoFlTransformSliderSet::setVec3f(const SbName & fieldname, const SbVec3f & vec)
+{
+    SoSFVec3f value;
+    value.setValue(vec);
+    this->setFieldValue(fieldname, value);
+}
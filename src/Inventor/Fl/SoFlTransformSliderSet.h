@@ -33,10 +33,23 @@
 #ifndef SOFL_SOFLTRANSFORMSLIDERSET_H
 #define SOFL_SOFLTRANSFORMSLIDERSET_H
 
+#include <Inventor/Fl/SoFlSliderSet.h>
 
-class SoFlTransformSliderSet {
+class SbRotation;
+class SbVec3f;
 
-};
+// Edits SoTransform nodes.
+class SOFL_DLL_API SoFlTransformSliderSet : public SoFlSliderSet {
+public:
+    explicit SoFlTransformSliderSet(SoNode * transform = nullptr);
+
+    void setTranslation(const SbVec3f & translation);
+    void setRotation(const SbRotation & rotation);
+    void setScaleFactor(const SbVec3f & scale);
+    void setCenter(const SbVec3f & center);
 
+private:
+    void setVec3f(const SbName & fieldname, const SbVec3f & vec);
+};
 
 #endif //SOFL_SOFLTRANSFORMSLIDERSET_H
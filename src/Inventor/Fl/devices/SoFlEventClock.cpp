@@ -0,0 +1,148 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/devices/SoFlEventClock.h"
+
+#include <FL/Enumerations.H>
+
+#ifdef HAVE_GLX
+#include <FL/x.H>
+#endif // HAVE_GLX
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+
+    // Stamp of the event being dispatched, if any.
+    SbTime current;
+    bool dispatching = false;
+
+    // A window system clock this far behind the offset seen so far has
+    // been restarted rather than held up.
+    const double RESYNC_INTERVAL = 60.0;
+
+    // The server time of the X event behind an FLTK input event.
+    bool
+    windowSystemTime(int event, unsigned long &milliseconds)
+    {
+#ifdef HAVE_GLX
+        if (!fl_xevent) return false;
+        const XEvent &xevent = *fl_xevent;
+        switch (event) {
+        case FL_PUSH:
+        case FL_RELEASE:
+        case FL_MOUSEWHEEL:
+            if (xevent.type != ButtonPress && xevent.type != ButtonRelease) return false;
+            milliseconds = xevent.xbutton.time;
+            return true;
+        case FL_MOVE:
+        case FL_DRAG:
+            if (xevent.type != MotionNotify) return false;
+            milliseconds = xevent.xmotion.time;
+            return true;
+        case FL_KEYDOWN:
+        case FL_KEYUP:
+            if (xevent.type != KeyPress && xevent.type != KeyRelease) return false;
+            milliseconds = xevent.xkey.time;
+            return true;
+        default:
+            break;
+        }
+#else
+        (void)event;
+        (void)milliseconds;
+#endif // HAVE_GLX
+        return false;
+    }
+
+} // namespace
+
+SbTime
+SoFlEventClock::now()
+{
+    typedef std::chrono::steady_clock clock;
+    static const clock::time_point start = clock::now();
+    static const double base = SbTime::getTimeOfDay().getValue();
+    return SbTime(base + std::chrono::duration<double>(clock::now() - start).count());
+}
+
+SbTime
+SoFlEventClock::eventTime()
+{
+    return dispatching ? current : SoFlEventClock::now();
+}
+
+// Events are read after they happen, so the smallest difference seen
+// between the two clocks is the closest to their real offset, and a
+// mapped stamp is never later than now().
+SbTime
+SoFlEventClock::fromWindowSystem(unsigned long milliseconds)
+{
+    static bool synced = false;
+    static uint32_t last = 0;
+    static double server = 0.0;
+    static double offset = 0.0;
+
+    const uint32_t stamp = static_cast<uint32_t>(milliseconds);
+    if (synced) server += static_cast<int32_t>(stamp - last) / 1000.0;
+    else server = stamp / 1000.0;
+    last = stamp;
+
+    const double difference = SoFlEventClock::now().getValue() - server;
+    if (!synced || difference < offset || difference - offset > RESYNC_INTERVAL) {
+        offset = difference;
+        synced = true;
+    }
+    return SbTime(server + offset);
+}
+
+SoFlEventClock::Dispatch::Dispatch(int event)
+    : previous(current), nested(dispatching)
+{
+    // An event handled from within another one, e.g. a callback that
+    // runs a nested loop, gets its own stamp.
+    unsigned long milliseconds;
+    current = windowSystemTime(event, milliseconds) ?
+              SoFlEventClock::fromWindowSystem(milliseconds) : SoFlEventClock::now();
+    dispatching = true;
+}
+
+SoFlEventClock::Dispatch::~Dispatch()
+{
+    current = this->previous;
+    dispatching = this->nested;
+}
@@ -0,0 +1,80 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLEVENTCLOCK_H
+#define SOFL_SOFLEVENTCLOCK_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbTime.h>
+
+// Time stamps for the events the devices produce.
+//
+// now() reads a monotonic clock, so stamps never go backwards when the
+// wall clock is adjusted. It is anchored to the time of day at start
+// up, so the stamps still compare with SbTime::getTimeOfDay().
+//
+// FLTK events are stamped once, when SoFlGLArea::handle() gets them,
+// and eventTime() returns that stamp for as long as the event is being
+// handled. Input events from an X server carry the server's time of the
+// event, which is mapped onto now()'s clock and used as the stamp, so
+// events queued up under load keep the times they happened at. Other
+// events are stamped with the time they are dispatched.
+class SoFlEventClock {
+public:
+    static SbTime now();
+    // The stamp of the FLTK event being handled, or now() outside of
+    // event handling.
+    static SbTime eventTime();
+    // Maps a window system time stamp, in milliseconds since some
+    // unspecified start and wrapping at 32 bits, onto now()'s clock.
+    static SbTime fromWindowSystem(unsigned long milliseconds);
+
+    // Stamps an FLTK event for the lifetime of the object.
+    class Dispatch {
+    public:
+        // 'event' is the FLTK event, which tells whether the window
+        // system's event has a time stamp of its own.
+        explicit Dispatch(int event = 0);
+        ~Dispatch();
+
+    private:
+        Dispatch(const Dispatch &) = delete;
+        Dispatch & operator=(const Dispatch &) = delete;
+        SbTime previous;
+        bool nested;
+    };
+};
+
+#endif // SOFL_SOFLEVENTCLOCK_H
@@ -34,8 +34,11 @@
 #include <Inventor/events/SoKeyboardEvent.h>
 #include <Inventor/errors/SoDebugError.h>
 
+#include <FL/Fl.H>
+
 #include "Inventor/Fl/devices/SoFlKeyboard.h"
 #include "SoFlKeyboardP.h"
+#include "SoFlEventClock.h"
 #include "sofldefs.h"
 
 #define PRIVATE(p) (p->pimpl)
@@ -65,59 +68,34 @@ SoFlKeyboard::disable(Fl_Window *widget, SoFlEventHandler *handler, void *closur
 
 const SoEvent *
 SoFlKeyboard::translateEvent(int event) {
-    int key_event = event;
-
-    if (key_event == FL_KEYBOARD) {
-#ifdef SOFL_DEBUG
-    SoDebugError::postWarning("SoFlKeyboard::translateEvent",
-                              "key event!");
-#endif
-    return (0);
-    }
-#if 0
-    SbBool keypress = key_event->GetEventType() == wxEVT_KEY_DOWN;
-    SbBool keyrelease = key_event->GetEventType() == wxEVT_KEY_UP;
-
-    SbBool keyevent = keypress || keyrelease;
-
-    if (keyevent && (PRIVATE(this)->eventmask & (KEY_PRESS | KEY_RELEASE))) {
-        if (!SoFlKeyboardP::translatetable)
-            SoFlKeyboardP::make_translation_table();
-
-        int key = key_event->GetKeyCode();
-        // Key code / sequence unknown.
-        if (key == 0) return nullptr;
-
-        // Allocate system-neutral event object once and reuse.
-        if (!PRIVATE(this)->kbdevent) PRIVATE(this)->kbdevent = new SoKeyboardEvent;
-
-        PRIVATE(this)->kbdevent->setPrintableCharacter(key);
-
-        // Translate keycode fl -> So
-        void *table;
-        if (SoFlKeyboardP::translatetable->find(key, table)) {
-            struct SoFlKeyboardP::key1map *map = (struct SoFlKeyboardP::key1map *) table;
-            PRIVATE(this)->kbdevent->setKey(map->to);
-        } else {
-            return nullptr;
-        }
-
-        // Press or release?
-        if (keyrelease) PRIVATE(this)->kbdevent->setState(SoButtonEvent::UP);
-        else
-            PRIVATE(this)->kbdevent->setState(SoButtonEvent::DOWN);
-
-        PRIVATE(this)->kbdevent->setShiftDown(key_event->ShiftDown());
-        PRIVATE(this)->kbdevent->setCtrlDown(key_event->ControlDown());
-        PRIVATE(this)->kbdevent->setAltDown(key_event->AltDown());
-
-        this->setEventPosition(PRIVATE(this)->kbdevent,
-                               key_event->GetX(),
-                               key_event->GetY());
-
-        PRIVATE(this)->kbdevent->setTime(SbTime::getTimeOfDay());
-        return PRIVATE(this)->kbdevent;
-    }
-#endif
-    return (nullptr);
+    const bool keypress = event == FL_KEYDOWN;
+    const bool keyrelease = event == FL_KEYUP;
+    if (!keypress && !keyrelease) return nullptr;
+    if (!(PRIVATE(this)->eventmask & (keypress ? KEY_PRESS : KEY_RELEASE))) return nullptr;
+
+    const SoFlKeyboardP::KeyMapping & mapping = SoFlKeyboardP::lookup(Fl::event_key());
+    // Key code / sequence unknown.
+    if (mapping.key == SoKeyboardEvent::ANY) return nullptr;
+
+    // Allocate system-neutral event object once and reuse.
+    if (!PRIVATE(this)->kbdevent) PRIVATE(this)->kbdevent = new SoKeyboardEvent;
+
+    PRIVATE(this)->kbdevent->setKey(mapping.key);
+    // Prefer the character FLTK composed, which honours shift and the
+    // keyboard layout; the table only knows the unshifted key.
+    char printable = mapping.printable;
+    if (keypress && Fl::event_length() == 1) printable = Fl::event_text()[0];
+    PRIVATE(this)->kbdevent->setPrintableCharacter(printable);
+
+    PRIVATE(this)->kbdevent->setState(keypress ? SoButtonEvent::DOWN : SoButtonEvent::UP);
+    PRIVATE(this)->kbdevent->setShiftDown(Fl::event_shift() != 0);
+    PRIVATE(this)->kbdevent->setCtrlDown(Fl::event_ctrl() != 0);
+    PRIVATE(this)->kbdevent->setAltDown(Fl::event_alt() != 0);
+
+    this->setEventPosition(PRIVATE(this)->kbdevent,
+                           Fl::event_x(),
+                           Fl::event_y());
+
+    PRIVATE(this)->kbdevent->setTime(SoFlEventClock::eventTime());
+    return PRIVATE(this)->kbdevent;
 }
@@ -33,65 +33,125 @@
 #include "SoFlKeyboardP.h"
 #include <FL/Enumerations.H>
 
-SbDict * SoFlKeyboardP::translatetable = nullptr;
-
-struct SoFlKeyboardP::key1map SoFlKeyboardP::wxToSoMapping[] = {
-    {FL_Escape, SoKeyboardEvent::ESCAPE, '.'},
-        {FL_Tab, SoKeyboardEvent::TAB, '.'},
-        {FL_Back, SoKeyboardEvent::BACKSPACE, '.'},
-        {FL_Enter, SoKeyboardEvent::RETURN, '.'},
-        {FL_Enter, SoKeyboardEvent::ENTER, '.'},
-        {FL_Insert, SoKeyboardEvent::INSERT, '.'},
-        {FL_Delete, SoKeyboardEvent::KEY_DELETE, '.'},
-        {FL_Pause, SoKeyboardEvent::PAUSE, '.'},
-        {FL_Print, SoKeyboardEvent::PRINT, '.'},
-        {FL_Home, SoKeyboardEvent::HOME, '.'},
-        {FL_End, SoKeyboardEvent::END, '.'},
-        {FL_Left, SoKeyboardEvent::LEFT_ARROW, '.'},
-        {FL_Up, SoKeyboardEvent::UP_ARROW, '.'},
-        {FL_Right, SoKeyboardEvent::RIGHT_ARROW, '.'},
-        {FL_Down, SoKeyboardEvent::DOWN_ARROW, '.'},
-        {FL_Page_Up, SoKeyboardEvent::PRIOR, '.'},
-        {FL_Page_Up, SoKeyboardEvent::PAGE_UP, '.'},
-        {FL_Page_Down, SoKeyboardEvent::NEXT, '.'},
-        {FL_Page_Down, SoKeyboardEvent::PAGE_DOWN, '.'},
-
-        {FL_SHIFT, SoKeyboardEvent::LEFT_SHIFT, '.'},
-        {FL_CONTROL, SoKeyboardEvent::LEFT_CONTROL, '.'},
-        {FL_ALT, SoKeyboardEvent::LEFT_ALT, '.'},
-        {FL_Caps_Lock, SoKeyboardEvent::CAPS_LOCK, '.'},
-        {FL_NUM_LOCK, SoKeyboardEvent::NUM_LOCK, '.'},
-        {FL_SCROLL_LOCK, SoKeyboardEvent::SCROLL_LOCK, '.'},
-
-        {FL_F, SoKeyboardEvent::F1, '.'},
-#if 0
-        {WXK_F2, SoKeyboardEvent::F2, '.'},
-        {WXK_F3, SoKeyboardEvent::F3, '.'},
-        {WXK_F4, SoKeyboardEvent::F4, '.'},
-        {WXK_F5, SoKeyboardEvent::F5, '.'},
-        {WXK_F6, SoKeyboardEvent::F6, '.'},
-        {WXK_F7, SoKeyboardEvent::F7, '.'},
-        {WXK_F8, SoKeyboardEvent::F8, '.'},
-        {WXK_F9, SoKeyboardEvent::F9, '.'},
-        {WXK_F10, SoKeyboardEvent::F10, '.'},
-        {WXK_F11, SoKeyboardEvent::F11, '.'},
-        {WXK_F12, SoKeyboardEvent::F12, '.'},
-{ , SoKeyboardEvent::SPACE, ' '},
-#endif
-
-
-};
-
-void
-SoFlKeyboardP::make_translation_table(void)
-{
-    assert(SoFlKeyboardP::translatetable == nullptr);
-    SoFlKeyboardP::translatetable = new SbDict;
-
-    int i = 0;
-    while ( SoFlKeyboardP::wxToSoMapping[i].from != 0) {
-        SoFlKeyboardP::translatetable->enter((unsigned long)SoFlKeyboardP::wxToSoMapping[i].from,
-                                             (void *)&SoFlKeyboardP::wxToSoMapping[i]);
-        i++;
+// The translation is a plain array lookup: FLTK keys are X11 keysyms,
+// which fall in two 256-key pages, Latin-1 (0x00xx) and the function
+// and modifier keys (0xffxx). Both pages are filled in by the compiler,
+// so there is nothing to set up or allocate at run time.
+
+namespace {
+
+    typedef SoFlKeyboardP::KeyMapping KeyMapping;
+
+    static_assert(SoKeyboardEvent::Z - SoKeyboardEvent::A == 25, "letters must be contiguous");
+    static_assert(SoKeyboardEvent::NUMBER_9 - SoKeyboardEvent::NUMBER_0 == 9, "digits must be contiguous");
+    static_assert(SoKeyboardEvent::PAD_9 - SoKeyboardEvent::PAD_0 == 9, "keypad digits must be contiguous");
+    static_assert(SoKeyboardEvent::F12 - SoKeyboardEvent::F1 == 11, "function keys must be contiguous");
+
+    constexpr KeyMapping
+    map(SoKeyboardEvent::Key key, char printable = '\0')
+    {
+        return {key, printable};
+    }
+
+    constexpr KeyMapping
+    offset(SoKeyboardEvent::Key first, int n, char printable = '\0')
+    {
+        return map(static_cast<SoKeyboardEvent::Key>(first + n), printable);
+    }
+
+    constexpr KeyMapping
+    latin1(int c)
+    {
+        return
+            (c >= 'a' && c <= 'z') ? offset(SoKeyboardEvent::A, c - 'a', static_cast<char>(c)) :
+            (c >= '0' && c <= '9') ? offset(SoKeyboardEvent::NUMBER_0, c - '0', static_cast<char>(c)) :
+            c == ' '  ? map(SoKeyboardEvent::SPACE, ' ') :
+            c == '\'' ? map(SoKeyboardEvent::APOSTROPHE, '\'') :
+            c == ','  ? map(SoKeyboardEvent::COMMA, ',') :
+            c == '-'  ? map(SoKeyboardEvent::MINUS, '-') :
+            c == '.'  ? map(SoKeyboardEvent::PERIOD, '.') :
+            c == '/'  ? map(SoKeyboardEvent::SLASH, '/') :
+            c == ';'  ? map(SoKeyboardEvent::SEMICOLON, ';') :
+            c == '='  ? map(SoKeyboardEvent::EQUAL, '=') :
+            c == '['  ? map(SoKeyboardEvent::BRACKETLEFT, '[') :
+            c == '\\' ? map(SoKeyboardEvent::BACKSLASH, '\\') :
+            c == ']'  ? map(SoKeyboardEvent::BRACKETRIGHT, ']') :
+            c == '`'  ? map(SoKeyboardEvent::GRAVE, '`') :
+            map(SoKeyboardEvent::ANY);
+    }
+
+    constexpr KeyMapping
+    function(int k)
+    {
+        return
+            (k >= FL_F + 1 && k <= FL_F + 12) ? offset(SoKeyboardEvent::F1, k - (FL_F + 1)) :
+            (k >= FL_KP + '0' && k <= FL_KP + '9') ? offset(SoKeyboardEvent::PAD_0, k - (FL_KP + '0'), static_cast<char>(k - FL_KP)) :
+            k == FL_KP + '*'    ? map(SoKeyboardEvent::PAD_MULTIPLY, '*') :
+            k == FL_KP + '+'    ? map(SoKeyboardEvent::PAD_ADD, '+') :
+            k == FL_KP + '-'    ? map(SoKeyboardEvent::PAD_SUBTRACT, '-') :
+            k == FL_KP + '.'    ? map(SoKeyboardEvent::PAD_PERIOD, '.') :
+            k == FL_KP + '/'    ? map(SoKeyboardEvent::PAD_DIVIDE, '/') :
+            k == FL_KP_Enter    ? map(SoKeyboardEvent::PAD_ENTER, '\r') :
+            k == FL_BackSpace   ? map(SoKeyboardEvent::BACKSPACE, '\b') :
+            k == FL_Tab         ? map(SoKeyboardEvent::TAB, '\t') :
+            k == FL_Enter       ? map(SoKeyboardEvent::RETURN, '\r') :
+            k == FL_Pause       ? map(SoKeyboardEvent::PAUSE) :
+            k == FL_Scroll_Lock ? map(SoKeyboardEvent::SCROLL_LOCK) :
+            k == FL_Escape      ? map(SoKeyboardEvent::ESCAPE, '\033') :
+            k == FL_Home        ? map(SoKeyboardEvent::HOME) :
+            k == FL_Left        ? map(SoKeyboardEvent::LEFT_ARROW) :
+            k == FL_Up          ? map(SoKeyboardEvent::UP_ARROW) :
+            k == FL_Right       ? map(SoKeyboardEvent::RIGHT_ARROW) :
+            k == FL_Down        ? map(SoKeyboardEvent::DOWN_ARROW) :
+            k == FL_Page_Up     ? map(SoKeyboardEvent::PAGE_UP) :
+            k == FL_Page_Down   ? map(SoKeyboardEvent::PAGE_DOWN) :
+            k == FL_End         ? map(SoKeyboardEvent::END) :
+            k == FL_Print       ? map(SoKeyboardEvent::PRINT) :
+            k == FL_Insert      ? map(SoKeyboardEvent::INSERT) :
+            k == FL_Num_Lock    ? map(SoKeyboardEvent::NUM_LOCK) :
+            k == FL_Shift_L     ? map(SoKeyboardEvent::LEFT_SHIFT) :
+            k == FL_Shift_R     ? map(SoKeyboardEvent::RIGHT_SHIFT) :
+            k == FL_Control_L   ? map(SoKeyboardEvent::LEFT_CONTROL) :
+            k == FL_Control_R   ? map(SoKeyboardEvent::RIGHT_CONTROL) :
+            k == FL_Caps_Lock   ? map(SoKeyboardEvent::CAPS_LOCK) :
+            k == FL_Alt_L       ? map(SoKeyboardEvent::LEFT_ALT) :
+            k == FL_Alt_R       ? map(SoKeyboardEvent::RIGHT_ALT) :
+            k == FL_Delete      ? map(SoKeyboardEvent::KEY_DELETE, '\177') :
+            map(SoKeyboardEvent::ANY);
+    }
+
+    struct KeyTable {
+        KeyMapping latin1[256];
+        KeyMapping function[256];
+    };
+
+    // C++11 has no std::index_sequence.
+    template <int... I> struct Indices {};
+    template <int N, int... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+    template <int... I> struct MakeIndices<0, I...> {
+        typedef Indices<I...> type;
+    };
+
+    template <int... I>
+    constexpr KeyTable
+    makeTable(Indices<I...>)
+    {
+        return {{latin1(I)...}, {function(0xff00 + I)...}};
     }
-}
\ No newline at end of file
+
+    constexpr KeyTable TABLE = makeTable(MakeIndices<256>::type());
+
+    static_assert(TABLE.latin1[0].key == SoKeyboardEvent::ANY, "key 0 is the unmapped entry");
+    static_assert(TABLE.latin1['q'].key == SoKeyboardEvent::Q, "");
+    static_assert(TABLE.function[(FL_F + 12) & 0xff].key == SoKeyboardEvent::F12, "");
+    static_assert(TABLE.function[(FL_KP + '7') & 0xff].key == SoKeyboardEvent::PAD_7, "");
+
+} // namespace
+
+const SoFlKeyboardP::KeyMapping &
+SoFlKeyboardP::lookup(int flkey)
+{
+    if (flkey >= 0 && flkey < 0x100) return TABLE.latin1[flkey];
+    if ((flkey & ~0xff) == 0xff00) return TABLE.function[flkey & 0xff];
+    return TABLE.latin1[0];
+}
@@ -42,15 +42,14 @@
 
 class SoFlKeyboardP : public SoGuiKeyboardP {
 public:
-    struct key1map {
-        int from;                // Fl val
-        SoKeyboardEvent::Key to; // So val
+    struct KeyMapping {
+        SoKeyboardEvent::Key key; // SoKeyboardEvent::ANY if unmapped
         char printable;
     };
 
-    static struct key1map wxToSoMapping[];
-    static SbDict * translatetable;
-    static void make_translation_table(void);
+    // Translates an FLTK key (Fl::event_key()) with a lookup in a
+    // dense table built at compile time.
+    static const KeyMapping & lookup(int flkey);
 };
 
 #endif //SOFL_SOFLKEYBOARDP_H
@@ -29,4 +29,448 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
-#include "SoFlLinuxJoystick.h"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/devices/SoFlLinuxJoystick.h"
+#include "Inventor/Fl/devices/SoFlEventClock.h"
+
+#include <Inventor/SbRotation.h>
+#include <Inventor/SbVec3f.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/events/SoMotion3Event.h>
+#include <Inventor/events/SoSpaceballButtonEvent.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <FL/Fl.H>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+SOFL_OBJECT_SOURCE(SoFlLinuxJoystick);
+
+namespace {
+
+    const char DEFAULT_DIRECTORY[] = "/dev/input";
+
+    // Motion events go out at this rate while a stick is held.
+    const double FRAME_INTERVAL = 1.0 / 60.0;
+    // A stall longer than this does not turn into one big jump.
+    const double MAX_STEP = 0.1;
+
+    bool
+    isJoystickName(const char * name)
+    {
+        if (std::strncmp(name, "js", 2) != 0 || name[2] == '\0') return false;
+        for (const char * c = name + 2; *c; c++) {
+            if (*c < '0' || *c > '9') return false;
+        }
+        return true;
+    }
+
+    // The js* entries of a directory, in numeric order.
+    std::vector<std::string>
+    findJoysticks(const char * directory)
+    {
+        std::vector<std::string> names;
+        DIR * dir = opendir(directory);
+        if (!dir) return names;
+        while (dirent * entry = readdir(dir)) {
+            if (isJoystickName(entry->d_name)) names.push_back(entry->d_name);
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end(), [](const std::string & a, const std::string & b) {
+            return a.size() != b.size() ? a.size() < b.size() : a < b;
+        });
+        return names;
+    }
+
+} // namespace
+
+SoFlLinuxJoystick::SoFlLinuxJoystick(const char * devicedir)
+{
+    if (SoFlLinuxJoystick::getClassTypeId() == SoType::badType()) {
+        SoFlLinuxJoystick::initClass();
+    }
+    this->devicedir = devicedir ? devicedir : DEFAULT_DIRECTORY;
+
+    this->motionsensor = new SoOneShotSensor(SoFlLinuxJoystick::motionCB, this);
+    this->motionevent = new SoMotion3Event;
+    this->buttonevent = new SoSpaceballButtonEvent;
+}
+
+SoFlLinuxJoystick::~SoFlLinuxJoystick()
+{
+    this->unwatch();
+    this->close();
+    delete this->motionsensor;
+    delete this->motionevent;
+    delete this->buttonevent;
+}
+
+void
+SoFlLinuxJoystick::enable(Fl_Window * widget, SoFlEventHandler * handler, void * closure)
+{
+    this->widget = widget;
+    this->handler = handler;
+    this->closure = closure;
+    this->watch();
+    this->rescan();
+}
+
+void
+SoFlLinuxJoystick::disable(Fl_Window * /*widget*/, SoFlEventHandler * handler, void * closure)
+{
+    if (handler != this->handler || closure != this->closure) return;
+    this->unwatch();
+    this->close();
+    this->widget = nullptr;
+    this->handler = nullptr;
+    this->closure = nullptr;
+}
+
+const SoEvent *
+SoFlLinuxJoystick::translateEvent(int event)
+{
+    return event == JOYSTICK_EVENT ? this->current : nullptr;
+}
+
+bool
+SoFlLinuxJoystick::exists()
+{
+    for (const std::string & name : findJoysticks(DEFAULT_DIRECTORY)) {
+        const std::string path = std::string(DEFAULT_DIRECTORY) + "/" + name;
+        if (::access(path.c_str(), R_OK) == 0) return true;
+    }
+    return false;
+}
+
+bool
+SoFlLinuxJoystick::rescan()
+{
+    if (this->fd >= 0) return true;
+    for (const std::string & name : findJoysticks(this->devicedir.getString())) {
+        const std::string path = std::string(this->devicedir.getString()) + "/" + name;
+        if (this->open(path.c_str())) return true;
+    }
+    return false;
+}
+
+bool
+SoFlLinuxJoystick::isOpen() const
+{
+    return this->fd >= 0;
+}
+
+const SbString &
+SoFlLinuxJoystick::getDevicePath() const
+{
+    return this->devicepath;
+}
+
+bool
+SoFlLinuxJoystick::open(const char * path)
+{
+    const int f = ::open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    // Permissions are often set up by udev right after the device node
+    // appears; the IN_ATTRIB that follows gets us another try.
+    if (f < 0) return false;
+
+    this->fd = f;
+    this->devicepath = path;
+    this->buffered = 0;
+    this->axes.clear();
+    this->buttons.clear();
+    // Not every device file answers these; the state then grows as
+    // axes and buttons report in.
+    unsigned char count = 0;
+    if (::ioctl(f, JSIOCGAXES, &count) == 0) this->axes.resize(count, 0.0f);
+    if (::ioctl(f, JSIOCGBUTTONS, &count) == 0) this->buttons.resize(count, false);
+
+    Fl::add_fd(this->fd, FL_READ, SoFlLinuxJoystick::inputCB, this);
+#if SOFL_DEBUG
+    SoDebugError::postInfo("SoFlLinuxJoystick::open", "%s: %d axes, %d buttons",
+                           path, int(this->axes.size()), int(this->buttons.size()));
+#endif
+    return true;
+}
+
+void
+SoFlLinuxJoystick::close()
+{
+    if (this->fd < 0) return;
+    Fl::remove_fd(this->fd);
+    ::close(this->fd);
+    this->fd = -1;
+    this->devicepath = "";
+    this->buffered = 0;
+    this->motionsensor->unschedule();
+    this->motionpending = false;
+    Fl::remove_timeout(SoFlLinuxJoystick::frameCB, this);
+    this->moving = false;
+    std::fill(this->axes.begin(), this->axes.end(), 0.0f);
+    std::fill(this->buttons.begin(), this->buttons.end(), false);
+}
+
+void
+SoFlLinuxJoystick::watch()
+{
+    if (this->inotifyfd >= 0) return;
+    this->inotifyfd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->inotifyfd < 0) return;
+    if (::inotify_add_watch(this->inotifyfd, this->devicedir.getString(), IN_CREATE | IN_ATTRIB) < 0) {
+        ::close(this->inotifyfd);
+        this->inotifyfd = -1;
+        return;
+    }
+    Fl::add_fd(this->inotifyfd, FL_READ, SoFlLinuxJoystick::hotplugCB, this);
+}
+
+void
+SoFlLinuxJoystick::unwatch()
+{
+    if (this->inotifyfd < 0) return;
+    Fl::remove_fd(this->inotifyfd);
+    ::close(this->inotifyfd);
+    this->inotifyfd = -1;
+}
+
+void
+SoFlLinuxJoystick::hotplugCB(int fd, void * closure)
+{
+    auto * thisp = static_cast<SoFlLinuxJoystick *>(closure);
+    bool joystick = false;
+    alignas(inotify_event) char data[4096];
+    for (;;) {
+        const ssize_t n = ::read(fd, data, sizeof(data));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        for (ssize_t i = 0; i < n;) {
+            const auto * event = reinterpret_cast<const inotify_event *>(data + i);
+            if (event->len > 0 && isJoystickName(event->name)) joystick = true;
+            i += sizeof(inotify_event) + event->len;
+        }
+    }
+    if (joystick) thisp->rescan();
+}
+
+void
+SoFlLinuxJoystick::setDeadZone(float fraction)
+{
+    this->deadzone = std::min(std::max(fraction, 0.0f), 0.99f);
+}
+
+float
+SoFlLinuxJoystick::getDeadZone() const
+{
+    return this->deadzone;
+}
+
+void
+SoFlLinuxJoystick::setAxisScale(int axis, float scale)
+{
+    if (axis < 0) return;
+    if (axis >= int(this->axisscales.size())) this->axisscales.resize(axis + 1, 1.0f);
+    this->axisscales[axis] = scale;
+}
+
+float
+SoFlLinuxJoystick::getAxisScale(int axis) const
+{
+    if (axis < 0 || axis >= int(this->axisscales.size())) return 1.0f;
+    return this->axisscales[axis];
+}
+
+void
+SoFlLinuxJoystick::setTranslationScaleFactor(float f)
+{
+    this->translationscale = f;
+}
+
+float
+SoFlLinuxJoystick::getTranslationScaleFactor() const
+{
+    return this->translationscale;
+}
+
+void
+SoFlLinuxJoystick::setRotationScaleFactor(float f)
+{
+    this->rotationscale = f;
+}
+
+float
+SoFlLinuxJoystick::getRotationScaleFactor() const
+{
+    return this->rotationscale;
+}
+
+int
+SoFlLinuxJoystick::getNumAxes() const
+{
+    return int(this->axes.size());
+}
+
+float
+SoFlLinuxJoystick::getAxisValue(int axis) const
+{
+    if (axis < 0 || axis >= int(this->axes.size())) return 0.0f;
+    const float raw = this->axes[axis];
+    const float magnitude = std::fabs(raw);
+    if (magnitude <= this->deadzone) return 0.0f;
+    const float value = (magnitude - this->deadzone) / (1.0f - this->deadzone);
+    return std::copysign(value, raw) * this->getAxisScale(axis);
+}
+
+int
+SoFlLinuxJoystick::getNumButtons() const
+{
+    return int(this->buttons.size());
+}
+
+bool
+SoFlLinuxJoystick::getButtonValue(int button) const
+{
+    if (button < 0 || button >= int(this->buttons.size())) return false;
+    return this->buttons[button];
+}
+
+bool
+SoFlLinuxJoystick::processInput()
+{
+    unsigned char data[64 * sizeof(js_event)];
+    while (this->fd >= 0) {
+        const ssize_t n = ::read(this->fd, data, sizeof(data));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (n <= 0) {
+            // Unplugged; inotify tells when it is back.
+            this->close();
+            return false;
+        }
+        for (ssize_t i = 0; i < n;) {
+            const int count = std::min(int(n - i), int(sizeof(js_event)) - this->buffered);
+            std::memcpy(this->buffer + this->buffered, data + i, count);
+            this->buffered += count;
+            i += count;
+            if (this->buffered == int(sizeof(js_event))) {
+                js_event event;
+                std::memcpy(&event, this->buffer, sizeof(event));
+                this->buffered = 0;
+                this->handleEvent(event.type, event.number, event.value);
+            }
+        }
+    }
+    return false;
+}
+
+void
+SoFlLinuxJoystick::inputCB(int /*fd*/, void * closure)
+{
+    static_cast<SoFlLinuxJoystick *>(closure)->processInput();
+}
+
+void
+SoFlLinuxJoystick::motionCB(void * closure, SoSensor *)
+{
+    static_cast<SoFlLinuxJoystick *>(closure)->flushMotion();
+}
+
+void
+SoFlLinuxJoystick::frameCB(void * closure)
+{
+    auto * thisp = static_cast<SoFlLinuxJoystick *>(closure);
+    thisp->motionpending = true;
+    thisp->flushMotion();
+}
+
+void
+SoFlLinuxJoystick::handleEvent(unsigned int type, int number, int value)
+{
+    // The driver opens with a burst of events giving the initial state;
+    // they are not user input.
+    const bool initial = (type & JS_EVENT_INIT) != 0;
+    type &= ~JS_EVENT_INIT;
+
+    if (type == JS_EVENT_AXIS) {
+        if (number >= int(this->axes.size())) this->axes.resize(number + 1, 0.0f);
+        this->axes[number] = std::max(value / 32767.0f, -1.0f);
+        if (!initial && number < 6 && !this->motionpending) {
+            this->motionpending = true;
+            this->motionsensor->schedule();
+        }
+    }
+    else if (type == JS_EVENT_BUTTON) {
+        if (number >= int(this->buttons.size())) this->buttons.resize(number + 1, false);
+        this->buttons[number] = value != 0;
+        if (initial || number >= 8) return;
+        this->flushMotion();
+        this->buttonevent->setButton(static_cast<SoSpaceballButtonEvent::Button>(SoSpaceballButtonEvent::BUTTON1 + number));
+        this->buttonevent->setState(value ? SoButtonEvent::DOWN : SoButtonEvent::UP);
+        this->deliver(this->buttonevent);
+    }
+}
+
+void
+SoFlLinuxJoystick::flushMotion()
+{
+    if (!this->motionpending) return;
+    this->motionpending = false;
+    this->motionsensor->unschedule();
+
+    // A stick leaving the rest position counts as one frame; after that
+    // the motion covers the time since the last event.
+    const SbTime now = SoFlEventClock::now();
+    double elapsed = FRAME_INTERVAL;
+    if (this->moving) {
+        elapsed = std::min(std::max((now - this->lastmotion).getValue(), 0.0), MAX_STEP);
+    }
+    this->lastmotion = now;
+    const float step = static_cast<float>(elapsed);
+
+    // Stick axes grow downwards.
+    const SbVec3f translation(this->getAxisValue(0), -this->getAxisValue(1), this->getAxisValue(2));
+    SbVec3f axis(this->getAxisValue(3), -this->getAxisValue(4), this->getAxisValue(5));
+    const float angle = axis.normalize() * this->rotationscale * step;
+    this->motionevent->setTranslation(translation * (this->translationscale * step));
+    this->motionevent->setRotation(angle != 0.0f ? SbRotation(axis, angle) : SbRotation::identity());
+
+    // A held stick sends no more input, so the timer keeps it moving.
+    this->moving = this->isDeflected();
+    Fl::remove_timeout(SoFlLinuxJoystick::frameCB, this);
+    if (this->moving) Fl::add_timeout(FRAME_INTERVAL, SoFlLinuxJoystick::frameCB, this);
+
+    this->deliver(this->motionevent);
+}
+
+bool
+SoFlLinuxJoystick::isDeflected() const
+{
+    for (int i = 0; i < 6; i++) {
+        if (this->getAxisValue(i) != 0.0f) return true;
+    }
+    return false;
+}
+
+void
+SoFlLinuxJoystick::deliver(SoEvent * event)
+{
+    event->setTime(SoFlEventClock::now());
+    if (!this->handler) return;
+    this->current = event;
+    bool stop = false;
+    this->handler(this->widget, this->closure, JOYSTICK_EVENT, &stop);
+    this->current = nullptr;
+}
@@ -29,14 +29,121 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
-
 #ifndef SOFL_SOFLLINUXJOYSTICK_H
 #define SOFL_SOFLLINUXJOYSTICK_H
 
+#include <Inventor/Fl/devices/SoFlDevice.h>
+#include <Inventor/SbString.h>
+#include <Inventor/SbTime.h>
 
-class SoFlLinuxJoystick {
+#include <vector>
 
-};
+class SoMotion3Event;
+class SoOneShotSensor;
+class SoSensor;
+class SoSpaceballButtonEvent;
+
+// Joysticks and gamepads through the Linux joystick API (/dev/input/js*).
+//
+// The device file is watched with Fl::add_fd(), so input is handled as
+// it arrives. Axis changes only update the axis state; one
+// SoMotion3Event per frame is made from it, and a frame timer keeps the
+// events coming for as long as a stick is held outside the dead zone.
+// Axes 0-2 drive the translation and axes 3-5 the rotation, scaled by
+// the time since the previous event, so motion does not depend on the
+// frame rate. Buttons give SoSpaceballButtonEvents as they come.
+//
+// The input directory is watched with inotify. A joystick plugged in
+// later is picked up, and one that is unplugged is let go until it
+// comes back.
+class SOFL_DLL_API SoFlLinuxJoystick : public SoFlDevice {
+  SOFL_OBJECT_HEADER(SoFlLinuxJoystick, SoFlDevice);
+
+public:
+  // The FLTK event number the device's events are passed to the event
+  // handlers with; translateEvent() only answers to this one.
+  enum { JOYSTICK_EVENT = 0x4a53 };
+
+  // A null directory means /dev/input.
+  SoFlLinuxJoystick(const char * devicedir = nullptr);
+  virtual ~SoFlLinuxJoystick();
+
+  virtual void enable(Fl_Window * widget, SoFlEventHandler * handler, void * closure);
+  virtual void disable(Fl_Window * widget, SoFlEventHandler * handler, void * closure);
+
+  virtual const SoEvent * translateEvent(int event);
+
+  static bool exists();
+
+  // Opens the first js* device in the directory, unless one is open.
+  bool rescan();
+  bool isOpen() const;
+  const SbString & getDevicePath() const;
 
+  // Deflections below the dead zone, as a fraction of full range, read
+  // as zero. The rest of the range is stretched to start from zero.
+  void setDeadZone(float fraction);
+  float getDeadZone() const;
+  // Per-axis multiplier, e.g. -1 to invert an axis.
+  void setAxisScale(int axis, float scale);
+  float getAxisScale(int axis) const;
+  // Motion at full deflection, per second.
+  void setTranslationScaleFactor(float f);
+  float getTranslationScaleFactor() const;
+  void setRotationScaleFactor(float f);
+  float getRotationScaleFactor() const;
+
+  int getNumAxes() const;
+  // In [-1, 1], after dead zone and axis scale.
+  float getAxisValue(int axis) const;
+  int getNumButtons() const;
+  bool getButtonValue(int button) const;
+
+  // Reads whatever the device has sent. Called from the FLTK fd
+  // callback; returns false once the device is gone.
+  bool processInput();
+
+private:
+  static void inputCB(int fd, void * closure);
+  static void hotplugCB(int fd, void * closure);
+  static void motionCB(void * closure, SoSensor * sensor);
+  static void frameCB(void * closure);
+  bool open(const char * path);
+  void close();
+  void watch();
+  void unwatch();
+  void handleEvent(unsigned int type, int number, int value);
+  void flushMotion();
+  bool isDeflected() const;
+  void deliver(SoEvent * event);
+
+  SbString devicedir;
+  SbString devicepath;
+  int fd{-1};
+  int inotifyfd{-1};
+  // Partial event left over from the last read.
+  unsigned char buffer[8];
+  int buffered{0};
+
+  Fl_Window * widget{nullptr};
+  SoFlEventHandler * handler{nullptr};
+  void * closure{nullptr};
+
+  std::vector<float> axes;
+  std::vector<float> axisscales;
+  std::vector<bool> buttons;
+  float deadzone{0.1f};
+  float translationscale{6.0f};
+  float rotationscale{3.0f};
+
+  bool motionpending{false};
+  // Whether the frame timer runs, and when the last motion went out.
+  bool moving{false};
+  SbTime lastmotion;
+  SoOneShotSensor * motionsensor{nullptr};
+  SoMotion3Event * motionevent{nullptr};
+  SoSpaceballButtonEvent * buttonevent{nullptr};
+  SoEvent * current{nullptr};
+};
 
 #endif //SOFL_SOFLLINUXJOYSTICK_H
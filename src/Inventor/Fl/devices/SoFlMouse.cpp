@@ -34,43 +34,150 @@
 #include <config.h>
 #endif // HAVE_CONFIG_H
 
+#include <cstdlib>
 #include <iostream>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/events/SoLocation2Event.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
+#ifdef HAVE_SOMOUSEWHEELEVENT
+#include <Inventor/events/SoMouseWheelEvent.h>
+#endif // HAVE_SOMOUSEWHEELEVENT
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <FL/Fl.H>
 
 #include <Inventor/Fl/devices/SoFlMouse.h>
 #include "Inventor/Fl/devices/SoGuiMouseP.h"
+#include "Inventor/Fl/devices/SoFlEventClock.h"
 #include "sofldefs.h"
 
 #define PRIVATE(p) (p->pimpl)
 #define PUBLIC(p) (p->pub)
 
+#ifdef HAVE_SOMOUSEWHEELEVENT
+namespace {
+    // What one notch of a wheel comes to in an SoMouseWheelEvent.
+    const int WHEEL_DELTA = 120;
+}
+#endif // HAVE_SOMOUSEWHEELEVENT
+
 class SoFlMouseP : public SoGuiMouseP {
 public:
     SoFlMouseP(SoFlMouse *p) : SoGuiMouseP(p) {
     }
+
+    static void wheelCB(void * closure, SoSensor * sensor);
+    void sendWheel(int steps, bool horizontal);
+    void dispatchWheel(SoEvent * event, bool horizontal);
+
+    // Where the events go; set by enable(), as for the other devices.
+    Fl_Window * widget{nullptr};
+    SoFlEventHandler * handler{nullptr};
+    void * closure{nullptr};
+
+    // Wheel motion is summed up per axis and handed on once per frame.
+    // The position and modifiers are those of the last wheel event.
+    SoOneShotSensor * wheelsensor{nullptr};
+    int wheeldx{0};
+    int wheeldy{0};
+    int wheelx{0};
+    int wheely{0};
+    int wheelstate{0};
+    SoEvent * wheelevent{nullptr};
+#ifdef HAVE_SOMOUSEWHEELEVENT
+    SoMouseWheelEvent * wheelmotion{nullptr};
+#endif // HAVE_SOMOUSEWHEELEVENT
 };
 
+void
+SoFlMouseP::wheelCB(void * closure, SoSensor *) {
+    auto * thisp = static_cast<SoFlMouseP *>(closure);
+    // Steps one way and the other within a frame cancel out.
+    const int dy = thisp->wheeldy;
+    const int dx = thisp->wheeldx;
+    thisp->wheeldy = thisp->wheeldx = 0;
+    if (dy != 0) thisp->sendWheel(dy, false);
+    if (dx != 0 && thisp->handler) thisp->sendWheel(dx, true);
+}
+
+// Coin has no horizontal wheel, so sideways motion goes out as the
+// wheel with Shift held, the way most applications scroll sideways.
+// Negative steps are away from the user, or to the left.
+void
+SoFlMouseP::sendWheel(int steps, bool horizontal) {
+#ifdef HAVE_SOMOUSEWHEELEVENT
+    // The whole burst as one event, so the scene is traversed once a
+    // frame however fast the wheel turns.
+    this->wheelmotion->setDelta(-steps * WHEEL_DELTA);
+    this->dispatchWheel(this->wheelmotion, horizontal);
+#else
+    // Without wheel events every step is pressed and released like any
+    // other button, so fast scrolling still goes as far.
+    const SoMouseButtonEvent::Button button =
+        steps < 0 ? SoMouseButtonEvent::BUTTON4 : SoMouseButtonEvent::BUTTON5;
+    this->buttonevent->setButton(button);
+    for (int i = std::abs(steps); i > 0 && this->handler; i--) {
+        this->buttonevent->setState(SoButtonEvent::DOWN);
+        this->dispatchWheel(this->buttonevent, horizontal);
+        if (!this->handler) break;
+        this->buttonevent->setState(SoButtonEvent::UP);
+        this->dispatchWheel(this->buttonevent, horizontal);
+    }
+#endif // HAVE_SOMOUSEWHEELEVENT
+}
+
+void
+SoFlMouseP::dispatchWheel(SoEvent * event, bool horizontal) {
+    event->setShiftDown(horizontal || (this->wheelstate & FL_SHIFT) != 0);
+    event->setCtrlDown((this->wheelstate & FL_CTRL) != 0);
+    event->setAltDown((this->wheelstate & FL_ALT) != 0);
+    // Made up at the end of the frame, not by an FLTK event.
+    event->setTime(SoFlEventClock::now());
+
+    // translateEvent() hands this out when the handler asks for it.
+    this->wheelevent = event;
+    bool stop = false;
+    this->handler(this->widget, this->closure, FL_MOUSEWHEEL, &stop);
+    this->wheelevent = nullptr;
+}
+
 SoFlMouse::SoFlMouse(int mask) {
     PRIVATE(this) = new SoFlMouseP(this);
     PRIVATE(this)->eventmask = mask;
+    PRIVATE(this)->wheelsensor = new SoOneShotSensor(SoFlMouseP::wheelCB, PRIVATE(this));
+#ifdef HAVE_SOMOUSEWHEELEVENT
+    PRIVATE(this)->wheelmotion = new SoMouseWheelEvent;
+#endif // HAVE_SOMOUSEWHEELEVENT
 }
 
 SoFlMouse::~SoFlMouse(void) {
+    delete PRIVATE(this)->wheelsensor;
+#ifdef HAVE_SOMOUSEWHEELEVENT
+    delete PRIVATE(this)->wheelmotion;
+#endif // HAVE_SOMOUSEWHEELEVENT
     delete PRIVATE(this);
 }
 
 void SoFlMouse::enable(Fl_Window *widget, SoFlEventHandler *handler, void *closure) {
-    // Nothing to do, already managed by callback in GLArea
+    // Button and motion events come through the callback in GLArea;
+    // the handler is only needed to hand on accumulated wheel motion.
+    PRIVATE(this)->widget = widget;
+    PRIVATE(this)->handler = handler;
+    PRIVATE(this)->closure = closure;
 }
 
 void SoFlMouse::disable(Fl_Window *widget, SoFlEventHandler *handler, void *closure) {
-    // Nothing to do, already managed by callback in GLArea
+    if (handler != PRIVATE(this)->handler || closure != PRIVATE(this)->closure) return;
+    PRIVATE(this)->wheelsensor->unschedule();
+    PRIVATE(this)->wheeldx = PRIVATE(this)->wheeldy = 0;
+    PRIVATE(this)->widget = nullptr;
+    PRIVATE(this)->handler = nullptr;
+    PRIVATE(this)->closure = nullptr;
 }
 
 const SoEvent *SoFlMouse::translateEvent(int event) {
     SoEvent *conv = nullptr;
+    bool horizontal = false;
 #if 0
     switch (event) {
         case FL_KEYBOARD:
@@ -111,22 +218,51 @@ const SoEvent *SoFlMouse::translateEvent(int event) {
     }
 #endif
 
-    bool isWheelInverted = false;
-    //TODO: mouse_event->IsWheelInverted()
-    // Convert wheel mouse events to Coin SoMouseButtonEvents.
-#ifdef HAVE_SOMOUSEBUTTONEVENT_BUTTON5_TODO
-    if (mouse_event->GetWheelRotation() > 0)
-        PRIVATE(this)->buttonevent->setButton(isWheelInverted
-                                                  ? SoMouseButtonEvent::BUTTON5
-                                                  : SoMouseButtonEvent::BUTTON4);
-    else if (mouse_event->GetWheelRotation() < 0)
-        PRIVATE(this)->buttonevent->setButton(isWheelInverted
-                                                  ? SoMouseButtonEvent::BUTTON4
-                                                  : SoMouseButtonEvent::BUTTON5);
-
-    PRIVATE(this)->buttonevent->setState(SoButtonEvent::DOWN);
-    conv = PRIVATE(this)->buttonevent;
+#ifdef HAVE_SOMOUSEBUTTONEVENT_BUTTON5
+    // Convert wheel mouse events to Coin SoMouseWheelEvents, or
+    // SoMouseButtonEvents where Coin has no wheel events.
+    if (event == FL_MOUSEWHEEL) {
+        // Our own accumulated motion, coming back through the handler.
+        if (PRIVATE(this)->wheelevent) {
+            this->setEventPosition(PRIVATE(this)->wheelevent,
+                                   PRIVATE(this)->wheelx,
+                                   PRIVATE(this)->wheely);
+            return PRIVATE(this)->wheelevent;
+        }
+        if (!(PRIVATE(this)->eventmask & BUTTON_PRESS)) return nullptr;
+
+        // Negative is away from the user, or to the left. Trackpads
+        // send many small steps where a wheel sends a few notches,
+        // which is why steps are counted, not events.
+        const int dx = Fl::event_dx();
+        const int dy = Fl::event_dy();
+        if (dx == 0 && dy == 0) return nullptr;
 
+        if (!PRIVATE(this)->handler) {
+            // Not enabled through a render area; nowhere to hand
+            // accumulated motion to later.
+            const int steps = dy != 0 ? dy : dx;
+#ifdef HAVE_SOMOUSEWHEELEVENT
+            PRIVATE(this)->wheelmotion->setDelta(-steps * WHEEL_DELTA);
+            conv = PRIVATE(this)->wheelmotion;
+#else
+            PRIVATE(this)->buttonevent->setButton(steps < 0 ? SoMouseButtonEvent::BUTTON4
+                                                            : SoMouseButtonEvent::BUTTON5);
+            PRIVATE(this)->buttonevent->setState(SoButtonEvent::DOWN);
+            conv = PRIVATE(this)->buttonevent;
+#endif // HAVE_SOMOUSEWHEELEVENT
+            horizontal = dy == 0;
+        }
+        else {
+            PRIVATE(this)->wheeldx += dx;
+            PRIVATE(this)->wheeldy += dy;
+            PRIVATE(this)->wheelx = Fl::event_x();
+            PRIVATE(this)->wheely = Fl::event_y();
+            PRIVATE(this)->wheelstate = Fl::event_state();
+            PRIVATE(this)->wheelsensor->schedule();
+            return nullptr;
+        }
+    }
 #endif // HAVE_SOMOUSEBUTTONEVENT_BUTTON5
 
     // Check for mousebutton press/release. Note that mousebutton
@@ -206,13 +342,13 @@ const SoEvent *SoFlMouse::translateEvent(int event) {
 
     // Common settings for SoEvent superclass.
     if (conv) {
-        conv->setShiftDown(Fl::event_shift());
+        conv->setShiftDown(horizontal || Fl::event_shift());
         conv->setCtrlDown(Fl::event_ctrl());
         conv->setAltDown(Fl::event_alt());
         this->setEventPosition(conv,
                                Fl::event_x(),
                                Fl::event_y());
-        conv->setTime(SbTime::getTimeOfDay());
+        conv->setTime(SoFlEventClock::eventTime());
     }
 
     return (conv);
@@ -29,4 +29,284 @@
  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
-#include "SoFlSpacenavDevice.h"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/devices/SoFlSpacenavDevice.h"
+#include "Inventor/Fl/devices/SoFlEventClock.h"
+
+#include <Inventor/SbRotation.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/events/SoMotion3Event.h>
+#include <Inventor/events/SoSpaceballButtonEvent.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
+
+#include <FL/Fl.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(HAVE_SPACENAV_SUPPORT) && !defined(_WIN32)
+#define SOFL_SPACENAV_SOCKET 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+SOFL_OBJECT_SOURCE(SoFlSpacenavDevice);
+
+namespace {
+
+    const char DEFAULT_SOCKET[] = "/var/run/spnav.sock";
+
+    // spacenavd packets are eight native ints: the type, then three
+    // translation and three rotation axes and the sample period in
+    // milliseconds for motion, or the button number for buttons.
+    enum PacketType {
+        MOTION = 0,
+        BUTTON_PRESS = 1,
+        BUTTON_RELEASE = 2
+    };
+    const int PACKET_INTS = 8;
+    const int PACKET_SIZE = PACKET_INTS * sizeof(int32_t);
+
+    // For daemons too old to report the period.
+    const int DEFAULT_PERIOD = 16;
+
+} // namespace
+
+SoFlSpacenavDevice::SoFlSpacenavDevice(const char * socketpath)
+{
+    if (SoFlSpacenavDevice::getClassTypeId() == SoType::badType()) {
+        SoFlSpacenavDevice::initClass();
+    }
+    if (!socketpath) socketpath = std::getenv("SPNAV_SOCKET");
+    this->socketpath = socketpath ? socketpath : DEFAULT_SOCKET;
+
+    this->motionsensor = new SoOneShotSensor(SoFlSpacenavDevice::motionCB, this);
+    this->motionevent = new SoMotion3Event;
+    this->buttonevent = new SoSpaceballButtonEvent;
+}
+
+SoFlSpacenavDevice::~SoFlSpacenavDevice()
+{
+    this->disconnect();
+    delete this->motionsensor;
+    delete this->motionevent;
+    delete this->buttonevent;
+}
+
+void
+SoFlSpacenavDevice::enable(Fl_Window * widget, SoFlEventHandler * handler, void * closure)
+{
+    this->widget = widget;
+    this->handler = handler;
+    this->closure = closure;
+    if (!this->connect()) {
+#if SOFL_DEBUG
+        SoDebugError::postWarning("SoFlSpacenavDevice::enable",
+                                  "could not connect to spacenavd at %s",
+                                  this->socketpath.getString());
+#endif
+    }
+}
+
+void
+SoFlSpacenavDevice::disable(Fl_Window * /*widget*/, SoFlEventHandler * handler, void * closure)
+{
+    if (handler != this->handler || closure != this->closure) return;
+    this->disconnect();
+    this->widget = nullptr;
+    this->handler = nullptr;
+    this->closure = nullptr;
+}
+
+const SoEvent *
+SoFlSpacenavDevice::translateEvent(int event)
+{
+    return event == SPACENAV_EVENT ? this->current : nullptr;
+}
+
+bool
+SoFlSpacenavDevice::connect()
+{
+#ifdef SOFL_SPACENAV_SOCKET
+    if (this->fd >= 0) return true;
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (this->socketpath.getLength() >= static_cast<int>(sizeof(addr.sun_path))) return false;
+    std::strcpy(addr.sun_path, this->socketpath.getString());
+
+    const int s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s < 0) return false;
+    if (::connect(s, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        ::close(s);
+        return false;
+    }
+    ::fcntl(s, F_SETFL, ::fcntl(s, F_GETFL) | O_NONBLOCK);
+
+    this->fd = s;
+    this->buffered = 0;
+    Fl::add_fd(this->fd, FL_READ, SoFlSpacenavDevice::inputCB, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+SoFlSpacenavDevice::disconnect()
+{
+#ifdef SOFL_SPACENAV_SOCKET
+    if (this->fd < 0) return;
+    Fl::remove_fd(this->fd);
+    ::close(this->fd);
+    this->fd = -1;
+    this->buffered = 0;
+    // Motion not delivered yet is stale by now.
+    this->motionsensor->unschedule();
+    this->motionpending = false;
+    this->translation.setValue(0.0f, 0.0f, 0.0f);
+    this->rotation.setValue(0.0f, 0.0f, 0.0f);
+#endif
+}
+
+bool
+SoFlSpacenavDevice::isConnected() const
+{
+    return this->fd >= 0;
+}
+
+void
+SoFlSpacenavDevice::setTranslationScaleFactor(float f)
+{
+    this->translationscale = f;
+}
+
+float
+SoFlSpacenavDevice::getTranslationScaleFactor() const
+{
+    return this->translationscale;
+}
+
+void
+SoFlSpacenavDevice::setRotationScaleFactor(float f)
+{
+    this->rotationscale = f;
+}
+
+float
+SoFlSpacenavDevice::getRotationScaleFactor() const
+{
+    return this->rotationscale;
+}
+
+bool
+SoFlSpacenavDevice::processInput()
+{
+#ifdef SOFL_SPACENAV_SOCKET
+    unsigned char data[64 * PACKET_SIZE];
+    while (this->fd >= 0) {
+        const ssize_t n = ::read(this->fd, data, sizeof(data));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (n <= 0) {
+            // The daemon went away.
+            this->disconnect();
+            return false;
+        }
+        for (ssize_t i = 0; i < n;) {
+            const int count = std::min(static_cast<int>(n - i), PACKET_SIZE - this->buffered);
+            std::memcpy(this->buffer + this->buffered, data + i, count);
+            this->buffered += count;
+            i += count;
+            if (this->buffered == PACKET_SIZE) {
+                int32_t packet[PACKET_INTS];
+                std::memcpy(packet, this->buffer, PACKET_SIZE);
+                this->buffered = 0;
+                this->handlePacket(packet);
+            }
+        }
+    }
+#endif
+    return false;
+}
+
+void
+SoFlSpacenavDevice::inputCB(int /*fd*/, void * closure)
+{
+    static_cast<SoFlSpacenavDevice *>(closure)->processInput();
+}
+
+void
+SoFlSpacenavDevice::motionCB(void * closure, SoSensor *)
+{
+    static_cast<SoFlSpacenavDevice *>(closure)->flushMotion();
+}
+
+void
+SoFlSpacenavDevice::handlePacket(const int32_t * packet)
+{
+    switch (packet[0]) {
+    case MOTION: {
+        // Integrate over the sample period, so that the motion per
+        // frame does not depend on how many packets made it in.
+        const float dt = (packet[7] > 0 ? packet[7] : DEFAULT_PERIOD) / 1000.0f;
+        // spacenavd's z axes point into the screen.
+        this->translation += SbVec3f(float(packet[1]), float(packet[2]), -float(packet[3])) * dt;
+        this->rotation += SbVec3f(float(packet[4]), float(packet[5]), -float(packet[6])) * dt;
+        if (!this->motionpending) {
+            this->motionpending = true;
+            this->motionsensor->schedule();
+        }
+        break;
+    }
+    case BUTTON_PRESS:
+    case BUTTON_RELEASE: {
+        const int button = packet[1];
+        if (button < 0 || button >= 8) break;
+        this->flushMotion();
+        this->buttonevent->setButton(static_cast<SoSpaceballButtonEvent::Button>(SoSpaceballButtonEvent::BUTTON1 + button));
+        this->buttonevent->setState(packet[0] == BUTTON_PRESS ? SoButtonEvent::DOWN : SoButtonEvent::UP);
+        this->deliver(this->buttonevent);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void
+SoFlSpacenavDevice::flushMotion()
+{
+    if (!this->motionpending) return;
+    this->motionpending = false;
+    this->motionsensor->unschedule();
+
+    this->motionevent->setTranslation(this->translation * this->translationscale);
+    SbVec3f axis = this->rotation;
+    const float angle = axis.normalize() * this->rotationscale;
+    this->motionevent->setRotation(angle != 0.0f ? SbRotation(axis, angle) : SbRotation::identity());
+    this->translation.setValue(0.0f, 0.0f, 0.0f);
+    this->rotation.setValue(0.0f, 0.0f, 0.0f);
+    this->deliver(this->motionevent);
+}
+
+void
+SoFlSpacenavDevice::deliver(SoEvent * event)
+{
+    event->setTime(SoFlEventClock::now());
+    if (!this->handler) return;
+    this->current = event;
+    bool stop = false;
+    this->handler(this->widget, this->closure, SPACENAV_EVENT, &stop);
+    this->current = nullptr;
+}
@@ -32,10 +32,85 @@
 #ifndef SOFL_SOFLSPACENAVDEVICE_H
 #define SOFL_SOFLSPACENAVDEVICE_H
 
+#include <Inventor/Fl/devices/SoFlDevice.h>
+#include <Inventor/SbString.h>
+#include <Inventor/SbVec3f.h>
 
-class SoFlSpacenavDevice {
+#include <cstdint>
 
-};
+class SoMotion3Event;
+class SoOneShotSensor;
+class SoSensor;
+class SoSpaceballButtonEvent;
+
+// 6DOF input from a 3Dconnexion device, read from the spacenavd daemon.
+//
+// The device talks to spacenavd over its UNIX socket and watches the
+// socket with Fl::add_fd(), so reading never blocks the event loop.
+// Motion packets arrive at the device's own rate, well above the frame
+// rate. They are integrated over their sample periods and delivered as
+// at most one SoMotion3Event per frame. Button packets are delivered as
+// they come, after any motion received before them.
+class SOFL_DLL_API SoFlSpacenavDevice : public SoFlDevice {
+  SOFL_OBJECT_HEADER(SoFlSpacenavDevice, SoFlDevice);
+
+public:
+  // The FLTK event number the device's events are passed to the event
+  // handlers with; translateEvent() only answers to this one.
+  enum { SPACENAV_EVENT = 0x5350 };
+
+  // A null path means $SPNAV_SOCKET, or else /var/run/spnav.sock.
+  SoFlSpacenavDevice(const char * socketpath = nullptr);
+  virtual ~SoFlSpacenavDevice();
+
+  virtual void enable(Fl_Window * widget, SoFlEventHandler * handler, void * closure);
+  virtual void disable(Fl_Window * widget, SoFlEventHandler * handler, void * closure);
+
+  virtual const SoEvent * translateEvent(int event);
+
+  bool connect();
+  void disconnect();
+  bool isConnected() const;
 
+  // Scale from full deflection held for one second to scene units and
+  // radians.
+  void setTranslationScaleFactor(float f);
+  float getTranslationScaleFactor() const;
+  void setRotationScaleFactor(float f);
+  float getRotationScaleFactor() const;
+
+  // Reads whatever the daemon has sent. Called from the FLTK fd
+  // callback; returns false once the connection is lost.
+  bool processInput();
+
+private:
+  static void inputCB(int fd, void * closure);
+  static void motionCB(void * closure, SoSensor * sensor);
+  void handlePacket(const int32_t * packet);
+  void deliver(SoEvent * event);
+  void flushMotion();
+
+  SbString socketpath;
+  int fd{-1};
+  // Partial packet left over from the last read.
+  unsigned char buffer[32];
+  int buffered{0};
+
+  Fl_Window * widget{nullptr};
+  SoFlEventHandler * handler{nullptr};
+  void * closure{nullptr};
+
+  // Motion integrated since the last delivered event.
+  SbVec3f translation;
+  SbVec3f rotation;
+  bool motionpending{false};
+  SoOneShotSensor * motionsensor{nullptr};
+  float translationscale{0.005f};
+  float rotationscale{0.005f};
+
+  SoMotion3Event * motionevent{nullptr};
+  SoSpaceballButtonEvent * buttonevent{nullptr};
+  SoEvent * current{nullptr};
+};
 
 #endif //SOFL_SOFLSPACENAVDEVICE_H
@@ -108,6 +108,23 @@ void onSeekClicked(Fl_Widget *, void *data) {
     if (pimpl) pimpl->seekbuttonClicked(0);
 }
 
+void onWheelChanged(Fl_Widget *w, void *data) {
+    auto *pimpl = static_cast<SoFlFullViewerP *>(data);
+    auto *wheel = static_cast<SoFlThumbWheel *>(w);
+    if (!pimpl) return;
+    switch (wheel->interaction()) {
+    case SoFlThumbWheel::Started:
+        pimpl->wheelPressed(wheel);
+        break;
+    case SoFlThumbWheel::Moved:
+        pimpl->wheelMoved(wheel, wheel->currentValue());
+        break;
+    case SoFlThumbWheel::Finished:
+        pimpl->wheelReleased(wheel);
+        break;
+    }
+}
+
 } // namespace
 
 SoFlFullViewer::SoFlFullViewer(Fl_Window* parent,
@@ -407,6 +424,7 @@ SoFlFullViewer::buildLeftTrim(Fl_Window* parent)
     t->copy_label("left thumb wheel");
     t->setRangeBoundaryHandling(SoFlThumbWheel::ACCUMULATE);
     this->leftWheelVal = t->value();
+    t->callback(&onWheelChanged, PRIVATE(this));
     this->leftWheel = t;
     return t;
 }
@@ -423,6 +441,7 @@ SoFlFullViewer::buildBottomTrim(Fl_Window* parent)
     t->copy_label("bottom thumb wheel");
     t->setRangeBoundaryHandling(SoFlThumbWheel::ACCUMULATE);
     this->bottomWheelVal = t->value();
+    t->callback(&onWheelChanged, PRIVATE(this));
     this->bottomWheel = t;
     return t;
 }
@@ -439,6 +458,7 @@ SoFlFullViewer::buildRightTrim(Fl_Window* parent)
     t->copy_label("right thumb wheel");
     t->setRangeBoundaryHandling(SoFlThumbWheel::ACCUMULATE);
     this->rightWheelVal = t->value();
+    t->callback(&onWheelChanged, PRIVATE(this));
     this->rightWheel = t;
     return t;
 }
@@ -0,0 +1,337 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/viewers/SoFlAnimationClock.h"
+#include "Inventor/Fl/devices/SoFlEventClock.h"
+#include "Inventor/Fl/viewers/SoFlExaminerViewer.h"
+#include "Inventor/Fl/viewers/SoFlViewer.h"
+
+#include <Inventor/SoPath.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/nodes/SoCamera.h>
+
+#include <FL/Fl.H>
+
+#include <algorithm>
+#include <cmath>
+
+#include "sofldefs.h"
+
+namespace {
+
+    // Only the camera motion this long before the button is released
+    // counts towards the spin, and a drag that came to rest for longer
+    // than this does not spin at all.
+    const double SPIN_WINDOW = 0.1;
+    // Slower spins, in radians per second, are taken as letting go.
+    const float MIN_SPIN_SPEED = 0.05f;
+    const float PI = 3.14159265358979f;
+
+    double
+    now() {
+        return SoFlEventClock::now().getValue();
+    }
+
+    SbVec3f
+    viewDirection(const SbRotation &orientation) {
+        SbVec3f direction;
+        orientation.multVec(SbVec3f(0.0f, 0.0f, -1.0f), direction);
+        return direction;
+    }
+
+} // namespace
+
+SoFlAnimationClock::SoFlAnimationClock(SoFlViewer *v)
+    : viewer(v),
+      rate(60.0f),
+      examiner(v->isOfType(SoFlExaminerViewer::getClassTypeId()) ? true : false),
+      spinsuspended(false),
+      ticking(false),
+      last(0.0),
+      next(0.0),
+      spinning(false),
+      spinspeed(0.0f),
+      seeking(false),
+      seekstart(0.0),
+      seektime(0.0f) {
+}
+
+SoFlAnimationClock::~SoFlAnimationClock() {
+    Fl::remove_timeout(SoFlAnimationClock::tickCB, this);
+}
+
+void
+SoFlAnimationClock::release() {
+    this->stop();
+    this->endMouseEvent();
+    this->examiner = false;
+}
+
+void
+SoFlAnimationClock::setRate(float r) {
+    this->rate = std::min(std::max(r, 1.0f), 1000.0f);
+}
+
+float
+SoFlAnimationClock::getRate() const {
+    return this->rate;
+}
+
+// The examiner starts its own spin when the button is let go, unless
+// its animation is off; for the clock to spin instead, it is off while
+// the examiner handles the event.
+void
+SoFlAnimationClock::beginMouseEvent() {
+    if (!this->examiner || this->spinsuspended) return;
+    SoFlExaminerViewer *examinerviewer = static_cast<SoFlExaminerViewer *>(this->viewer);
+    if (!examinerviewer->isAnimationEnabled()) return;
+    this->spinsuspended = true;
+    examinerviewer->setAnimationEnabled(FALSE);
+}
+
+void
+SoFlAnimationClock::endMouseEvent() {
+    if (!this->spinsuspended) return;
+    this->spinsuspended = false;
+    static_cast<SoFlExaminerViewer *>(this->viewer)->setAnimationEnabled(TRUE);
+}
+
+bool
+SoFlAnimationClock::isSpinEnabled() const {
+    if (!this->examiner) return false;
+    return this->spinsuspended ||
+           static_cast<SoFlExaminerViewer *>(this->viewer)->isAnimationEnabled();
+}
+
+void
+SoFlAnimationClock::mousePressed() {
+    this->spinning = false;
+    this->samples.clear();
+    this->schedule();
+}
+
+void
+SoFlAnimationClock::mouseDragged() {
+    if (!this->isSpinEnabled()) return;
+    if (!(Fl::event_state() & FL_BUTTON1)) return;
+    SoCamera *camera = this->viewer->getCamera();
+    if (!camera || !this->viewer->isViewing() || this->viewer->isSeekMode()) return;
+
+    const Sample sample = { SoFlEventClock::eventTime().getValue(), camera->orientation.getValue() };
+    this->samples.push_back(sample);
+    while (this->samples.size() > 2 &&
+           this->samples[1].time < sample.time - SPIN_WINDOW) {
+        this->samples.pop_front();
+    }
+}
+
+void
+SoFlAnimationClock::mouseReleased() {
+    if (Fl::event_button() != FL_LEFT_MOUSE || this->samples.size() < 2 ||
+        !this->isSpinEnabled()) {
+        this->samples.clear();
+        return;
+    }
+    const Sample first = this->samples.front();
+    const Sample latest = this->samples.back();
+    this->samples.clear();
+
+    const double released = SoFlEventClock::eventTime().getValue();
+    const double elapsed = latest.time - first.time;
+    if (released - latest.time > SPIN_WINDOW || elapsed <= 0.0) return;
+
+    // The examiner turns the camera about its own axes, so the spin is
+    // kept in camera space as well.
+    SbRotation delta = latest.orientation * first.orientation.inverse();
+    SbVec3f axis;
+    float angle;
+    delta.getValue(axis, angle);
+    if (angle > PI) {
+        angle = 2.0f * PI - angle;
+        axis.negate();
+    }
+    const float speed = float(angle / elapsed);
+    if (speed < MIN_SPIN_SPEED) return;
+
+    this->spinaxis = axis;
+    this->spinspeed = speed;
+    this->spinning = true;
+    this->schedule();
+}
+
+void
+SoFlAnimationClock::seekTo(const SbVec3f &point) {
+    SoCamera *camera = this->viewer->getCamera();
+    if (!camera) return;
+
+    this->startposition = camera->position.getValue();
+    this->startorientation = camera->orientation.getValue();
+
+    SbVec3f direction = point - this->startposition;
+    const float distance = direction.length();
+    if (distance <= 0.0f) return;
+    direction /= distance;
+
+    float focal = this->viewer->getSeekDistance();
+    if (this->viewer->isSeekValuePercentage()) focal *= distance / 100.0f;
+    camera->focalDistance.setValue(focal);
+
+    this->endposition = point - direction * focal;
+    this->endorientation = this->startorientation *
+                           SbRotation(viewDirection(this->startorientation), direction);
+    this->seektime = this->viewer->getSeekTime();
+    this->seekstart = now();
+    this->seeking = true;
+    this->spinning = false;
+    this->seek(this->seekstart);
+    this->schedule();
+}
+
+SbVec3f
+SoFlAnimationClock::seekTarget(const SbVec3f &point, SoPath *path, bool detail,
+                               const SbViewportRegion &viewport) {
+    if (detail || !path) return point;
+    SoGetBoundingBoxAction bbaction(viewport);
+    bbaction.apply(path);
+    const SbBox3f box = bbaction.getBoundingBox();
+    return box.isEmpty() ? point : box.getCenter();
+}
+
+void
+SoFlAnimationClock::stop() {
+    this->spinning = false;
+    this->samples.clear();
+    if (this->seeking) {
+        this->seeking = false;
+        this->viewer->setSeekMode(FALSE);
+    }
+    this->schedule();
+}
+
+bool
+SoFlAnimationClock::isAnimating() const {
+    return this->spinning || this->seeking;
+}
+
+void
+SoFlAnimationClock::tickCB(void *closure) {
+    static_cast<SoFlAnimationClock *>(closure)->tick();
+}
+
+void
+SoFlAnimationClock::schedule() {
+    if (!this->isAnimating()) {
+        Fl::remove_timeout(SoFlAnimationClock::tickCB, this);
+        this->ticking = false;
+        return;
+    }
+    if (Fl::has_timeout(SoFlAnimationClock::tickCB, this)) return;
+
+    const double t = now();
+    const double period = 1.0 / this->rate;
+    if (!this->ticking) {
+        this->ticking = true;
+        this->last = t;
+        this->next = t + period;
+    } else {
+        this->next = SoFlAnimationClock::nextTick(this->next, t, period);
+    }
+    Fl::add_timeout(this->next - t, SoFlAnimationClock::tickCB, this);
+}
+
+double
+SoFlAnimationClock::nextTick(double next, double t, double period) {
+    next += period;
+    // Late: skip the ticks that should have run by now instead of
+    // running them back to back.
+    if (next <= t) next += (std::floor((t - next) / period) + 1.0) * period;
+    return next;
+}
+
+void
+SoFlAnimationClock::tick() {
+    const double t = now();
+    const double elapsed = t - this->last;
+    this->last = t;
+
+    if (this->spinning) this->spin(elapsed);
+    if (this->seeking) this->seek(t);
+    this->schedule();
+}
+
+void
+SoFlAnimationClock::spin(double elapsed) {
+    SoCamera *camera = this->viewer->getCamera();
+    // The application stops spinning by turning the animation off.
+    if (!camera || !this->viewer->isViewing() || !this->isSpinEnabled()) {
+        this->spinning = false;
+        return;
+    }
+
+    // Turn the camera about its focal point, as the examiner does.
+    const float focal = camera->focalDistance.getValue();
+    SbRotation orientation = camera->orientation.getValue();
+    const SbVec3f center = camera->position.getValue() + viewDirection(orientation) * focal;
+    orientation = SbRotation(this->spinaxis, float(this->spinspeed * elapsed)) * orientation;
+    camera->orientation.setValue(orientation);
+    camera->position.setValue(center - viewDirection(orientation) * focal);
+}
+
+void
+SoFlAnimationClock::seek(double t) {
+    // The application ended seek mode.
+    if (!this->viewer->isSeekMode()) {
+        this->seeking = false;
+        return;
+    }
+    SoCamera *camera = this->viewer->getCamera();
+    float fraction = 1.0f;
+    if (camera && this->seektime > 0.0f) {
+        fraction = std::min(float((t - this->seekstart) / this->seektime), 1.0f);
+    }
+    if (camera) {
+        // Ease in and out.
+        const float eased = (1.0f - std::cos(PI * fraction)) * 0.5f;
+        camera->position.setValue(this->startposition +
+                                  (this->endposition - this->startposition) * eased);
+        camera->orientation.setValue(SbRotation::slerp(this->startorientation,
+                                                       this->endorientation, eased));
+    }
+    if (fraction >= 1.0f) {
+        this->seeking = false;
+        this->viewer->setSeekMode(FALSE);
+    }
+}
@@ -0,0 +1,135 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLANIMATIONCLOCK_H
+#define SOFL_SOFLANIMATIONCLOCK_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbLinear.h>
+
+#include <deque>
+
+class SbViewportRegion;
+class SoFlViewer;
+class SoPath;
+
+// Spin and seek animations for a viewer, driven by one FLTK timeout.
+//
+// Every tick moves the camera by the real time elapsed since the last
+// one, so animations keep their speed however long frames take to
+// render. Ticks that were missed while a frame took long are dropped
+// rather than run back to back, and the timeout only runs while
+// something is animating.
+//
+// Examiner viewers spin on a fixed angle per timer tick, so their own
+// spin animation is switched off while they handle mouse input, and
+// only then; SoFlExaminerViewer::isAnimationEnabled() otherwise reports
+// what the application set, and turning it off stops the clock's spin
+// too. Spins are measured from how the camera turned during the last
+// part of a left button drag instead, and continue about the focal
+// point at that angular speed.
+class SoFlAnimationClock {
+public:
+    explicit SoFlAnimationClock(SoFlViewer * viewer);
+    ~SoFlAnimationClock();
+
+    // Stops animating.
+    void release();
+
+    // Ticks per second.
+    void setRate(float rate);
+    float getRate() const;
+
+    // Called around the viewer's handling of mouse input.
+    void beginMouseEvent();
+    void endMouseEvent();
+
+    // Mouse input, passed on after the viewer has handled it.
+    void mousePressed();
+    void mouseDragged();
+    void mouseReleased();
+
+    // What SoFlViewer::seekToPoint() does, on this clock, with a point
+    // from seekTarget().
+    void seekTo(const SbVec3f & point);
+
+    // Where a seek that hit 'point' on 'path' goes: the point itself for
+    // a detail seek, the centre of the object otherwise.
+    static SbVec3f seekTarget(const SbVec3f & point, SoPath * path, bool detail,
+                              const SbViewportRegion & viewport);
+    // When the tick after one due at 'next' is due, skipping those that
+    // are already late at time 't'.
+    static double nextTick(double next, double t, double period);
+
+    void stop();
+    bool isAnimating() const;
+
+private:
+    static void tickCB(void * closure);
+    void schedule();
+    void tick();
+    bool isSpinEnabled() const;
+    void spin(double elapsed);
+    void seek(double now);
+
+    struct Sample {
+        double time;
+        SbRotation orientation;
+    };
+
+    SoFlViewer * viewer;
+    float rate;
+    bool examiner;
+    // Whether the examiner's own spinning is switched off for an event.
+    bool spinsuspended;
+    bool ticking;
+    double last;
+    double next;
+
+    std::deque<Sample> samples;
+    bool spinning;
+    SbVec3f spinaxis;
+    float spinspeed;
+
+    bool seeking;
+    double seekstart;
+    float seektime;
+    SbVec3f startposition;
+    SbVec3f endposition;
+    SbRotation startorientation;
+    SbRotation endorientation;
+};
+
+#endif // SOFL_SOFLANIMATIONCLOCK_H
@@ -0,0 +1,253 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/viewers/SoFlBoundingBoxCache.h"
+#include "Inventor/Fl/viewers/SoFlViewer.h"
+
+#include <Inventor/SbSphere.h>
+#include <Inventor/SoSceneManager.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "sofldefs.h"
+
+namespace {
+
+    // Keeps geometry lying right on the bounds from being clipped.
+    const float SLACK = 0.001f;
+
+    // Frames the box with the camera looking along its current
+    // direction, the way SoCamera::viewAll() does.
+    bool
+    viewBox(SoCamera *camera, const SbBox3f &box, float aspect) {
+        SbSphere sphere;
+        sphere.circumscribe(box);
+        const float radius = sphere.getRadius();
+        SbVec3f direction;
+        camera->orientation.getValue().multVec(SbVec3f(0.0f, 0.0f, -1.0f), direction);
+
+        if (camera->isOfType(SoPerspectiveCamera::getClassTypeId())) {
+            SoPerspectiveCamera *perspective = static_cast<SoPerspectiveCamera *>(camera);
+            float angle = perspective->heightAngle.getValue() / 2.0f;
+            if (aspect < 1.0f) angle = std::atan(std::tan(angle) * aspect);
+            const float distance = radius / std::sin(angle);
+            camera->position.setValue(sphere.getCenter() - direction * distance);
+            camera->nearDistance.setValue(distance - radius);
+            camera->farDistance.setValue(distance + radius);
+            camera->focalDistance.setValue(distance);
+            return true;
+        }
+        if (camera->isOfType(SoOrthographicCamera::getClassTypeId())) {
+            SoOrthographicCamera *orthographic = static_cast<SoOrthographicCamera *>(camera);
+            camera->position.setValue(sphere.getCenter() - direction * radius);
+            orthographic->height.setValue(aspect < 1.0f ? 2.0f * radius / aspect : 2.0f * radius);
+            camera->nearDistance.setValue(0.0f);
+            camera->farDistance.setValue(2.0f * radius);
+            camera->focalDistance.setValue(radius);
+            return true;
+        }
+        return false;
+    }
+
+} // namespace
+
+SoFlBoundingBoxCache::SoFlBoundingBoxCache(SoFlViewer *v)
+    : viewer(v),
+      action(v->getGLRenderAction()),
+      bboxaction(new SoGetBoundingBoxAction(v->getViewportRegion())),
+      root(nullptr),
+      nodeid(0),
+      valid(false),
+      clipping(false),
+      strategy(SoFlGLArea::CLIPPING_VARIABLE_NEAR_PLANE),
+      strategyvalue(0.6f),
+      clipcb(nullptr),
+      clipcbdata(nullptr) {
+    this->action->addPreRenderCallback(SoFlBoundingBoxCache::preRenderCB, this);
+}
+
+// As with partial redraws, the render action is already gone when the
+// GL widget tears down its private data, so it is only let go of in
+// release().
+SoFlBoundingBoxCache::~SoFlBoundingBoxCache() {
+    delete this->bboxaction;
+}
+
+void
+SoFlBoundingBoxCache::release() {
+    if (!this->action) return;
+    this->action->removePreRenderCallback(SoFlBoundingBoxCache::preRenderCB, this);
+    this->action = nullptr;
+}
+
+void
+SoFlBoundingBoxCache::setClippingStrategy(int s, float value,
+                                          SoFlAutoClippingCB *cb, void *userdata) {
+    this->strategy = s;
+    this->strategyvalue = value;
+    this->clipcb = cb;
+    this->clipcbdata = userdata;
+}
+
+// The viewer works out its clipping planes before rendering, from the
+// setting it has then; what the application set is back in place once
+// the frame is done.
+void
+SoFlBoundingBoxCache::beginRedraw() {
+    this->clipping = this->viewer->isAutoClipping() ? true : false;
+    if (this->clipping) this->viewer->setAutoClipping(FALSE);
+}
+
+void
+SoFlBoundingBoxCache::endRedraw() {
+    if (!this->clipping) return;
+    this->clipping = false;
+    // Turning automatic clipping on schedules a redraw, which handing
+    // the setting back must not do.
+    SoSceneManager *manager = this->viewer->getSceneManager();
+    manager->deactivate();
+    this->viewer->setAutoClipping(TRUE);
+    manager->activate();
+}
+
+const SbXfBox3f &
+SoFlBoundingBoxCache::getBoundingBox() {
+    SoNode *scene = this->viewer->getSceneGraph();
+    const SbViewportRegion &vp = this->viewer->getViewportRegion();
+    if (!scene) {
+        this->box.makeEmpty();
+        this->valid = false;
+        return this->box;
+    }
+    // Screen-space shapes such as SoText2 depend on the viewport too.
+    if (this->valid && scene == this->root && scene->getNodeId() == this->nodeid &&
+        vp == this->viewport) {
+        return this->box;
+    }
+
+    this->bboxaction->setViewportRegion(vp);
+    this->bboxaction->apply(scene);
+    this->box = this->bboxaction->getXfBoundingBox();
+    this->root = scene;
+    this->nodeid = scene->getNodeId();
+    this->viewport = vp;
+    this->valid = true;
+    return this->box;
+}
+
+void
+SoFlBoundingBoxCache::viewAll() {
+    SoCamera *camera = this->viewer->getCamera();
+    if (!camera) return;
+    const SbXfBox3f &bounds = this->getBoundingBox();
+    if (bounds.isEmpty() ||
+        !viewBox(camera, bounds.project(), this->viewer->getViewportRegion().getViewportAspectRatio())) {
+        this->viewer->viewAll();
+    }
+}
+
+void
+SoFlBoundingBoxCache::preRenderCB(void *closure, SoGLRenderAction *) {
+    SoFlBoundingBoxCache *thisp = static_cast<SoFlBoundingBoxCache *>(closure);
+    if (thisp->clipping) thisp->setClippingPlanes();
+}
+
+bool
+SoFlBoundingBoxCache::clippingPlanes(const SbBox3f &eyebox, bool perspective,
+                                     int depthbits, int s, float value,
+                                     SbVec2f &nearfar) {
+    float nearval = -eyebox.getMax()[2];
+    float farval = -eyebox.getMin()[2];
+    // Everything is behind the camera.
+    if (farval <= 0.0f) return false;
+
+    if (perspective) {
+        float nearlimit = value;
+        if (s == SoFlGLArea::CLIPPING_VARIABLE_NEAR_PLANE) {
+            // The near plane is kept far enough out that this part of
+            // the depth buffer bits still resolves the far plane.
+            const int usebits = static_cast<int>(depthbits * (1.0f - value));
+            nearlimit = farval / float(1 << std::min(std::max(usebits, 1), 30));
+        }
+        if (nearlimit >= farval) nearlimit = farval / 5000.0f;
+        nearval = std::max(nearval, nearlimit);
+        nearval *= 1.0f - SLACK;
+    } else {
+        nearval -= std::fabs(nearval) * SLACK;
+    }
+    farval *= 1.0f + SLACK;
+    nearfar.setValue(nearval, farval);
+    return true;
+}
+
+// Fits the near and far planes around the scene bounds, as the
+// viewer's automatic clipping does. Called with the context current,
+// right before the scene is rendered.
+void
+SoFlBoundingBoxCache::setClippingPlanes() {
+    SoCamera *camera = this->viewer->getCamera();
+    if (!camera) return;
+    SbXfBox3f bounds = this->getBoundingBox();
+    if (bounds.isEmpty()) return;
+
+    SbMatrix affine, projection;
+    camera->getViewVolume(1.0f).getMatrices(affine, projection);
+    bounds.transform(affine);
+
+    GLint depthbits = 0;
+    glGetIntegerv(GL_DEPTH_BITS, &depthbits);
+    SbVec2f nearfar;
+    if (!SoFlBoundingBoxCache::clippingPlanes(bounds.project(),
+                                              camera->isOfType(SoPerspectiveCamera::getClassTypeId()),
+                                              depthbits, this->strategy, this->strategyvalue,
+                                              nearfar)) {
+        return;
+    }
+    if (this->clipcb) nearfar = this->clipcb(this->clipcbdata, nearfar);
+
+    // Not a scene change: this is part of rendering the frame.
+    const SbBool notify = camera->enableNotify(FALSE);
+    camera->nearDistance.setValue(nearfar[0]);
+    camera->farDistance.setValue(nearfar[1]);
+    camera->enableNotify(notify);
+}
@@ -0,0 +1,112 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#ifndef SOFL_SOFLBOUNDINGBOXCACHE_H
+#define SOFL_SOFLBOUNDINGBOXCACHE_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <Inventor/SbLinear.h>
+#include <Inventor/SbViewportRegion.h>
+
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
+
+class SoFlViewer;
+class SoGetBoundingBoxAction;
+class SoGLRenderAction;
+class SoNode;
+
+// Scene bounds for a viewer's view all and automatic clipping planes.
+//
+// The bounds are kept together with the node ID of the scene graph
+// they were computed for. Coin gives a node a new ID whenever anything
+// below it changes, so an unchanged ID means unchanged bounds and no
+// traversal at all. When the scene did change, the bounding box action
+// is applied again and separators whose own caches are still valid
+// answer from them, so only the changed subgraphs are traversed.
+//
+// The viewer's own automatic clipping computes the bounds every frame.
+// While the viewer redraws, it is switched off and the clipping planes
+// are set from a pre-render callback instead; between redraws the
+// viewer's setting is left as the application made it, so turning
+// automatic clipping off turns the cache's clipping off too. The
+// viewer does not report its clipping strategy, so the one given
+// through SoFlGLArea::setAutoClippingStrategy() is used.
+class SoFlBoundingBoxCache {
+public:
+    explicit SoFlBoundingBoxCache(SoFlViewer * viewer);
+    ~SoFlBoundingBoxCache();
+
+    // Detaches from the viewer's render action.
+    void release();
+
+    void setClippingStrategy(int strategy, float value,
+                             SoFlAutoClippingCB * cb, void * userdata);
+
+    // Called around the viewer's redraw.
+    void beginRedraw();
+    void endRedraw();
+
+    const SbXfBox3f & getBoundingBox();
+
+    // What SoFlViewer::viewAll() does, from the cached bounds.
+    void viewAll();
+
+    // The near and far planes the viewer's automatic clipping picks for
+    // a box in eye space. False if the box is behind the camera.
+    static bool clippingPlanes(const SbBox3f & eyebox, bool perspective,
+                               int depthbits, int strategy, float value,
+                               SbVec2f & nearfar);
+
+private:
+    static void preRenderCB(void * closure, SoGLRenderAction * action);
+    void setClippingPlanes();
+
+    SoFlViewer * viewer;
+    SoGLRenderAction * action;
+    SoGetBoundingBoxAction * bboxaction;
+    SbXfBox3f box;
+    SbViewportRegion viewport;
+    SoNode * root;
+    uint32_t nodeid;
+    bool valid;
+    // Whether the viewer's automatic clipping is on, for this redraw.
+    bool clipping;
+    int strategy;
+    float strategyvalue;
+    SoFlAutoClippingCB * clipcb;
+    void * clipcbdata;
+};
+
+#endif //SOFL_SOFLBOUNDINGBOXCACHE_H
@@ -32,6 +32,7 @@
 
 #include "Inventor/Fl/viewers/SoFlFullViewerP.h"
 #include "Inventor/Fl/viewers/SoFlFullViewer.h"
+#include "Inventor/Fl/widgets/SoFlGLArea.h"
 #include "Inventor/Fl/widgets/SoFlThumbWheel.h"
 #include "ButtonIndexValues.h"
 #include "sofldefs.h"
@@ -76,11 +77,11 @@ SoFlFullViewerP::showDecorationWidgets(SbBool onOff) {
 }
 
 void
-SoFlFullViewerP::wheelPressed(int event) {
+SoFlFullViewerP::wheelPressed(Fl_Window *wheel) {
 #if SOFL_DEBUG
     SoDebugError::postInfo("SoFlFullViewerP::wheelPressed", "event arrived!");
 #endif
-    MapEvent::iterator it = objectMap.find(static_cast<Fl_Window*>(nullptr));//event.GetEventObject()));
+    MapEvent::iterator it = objectMap.find(wheel);
     if( it != objectMap.end() ) {
         VoidFuncNoPar function = it->second.onPress;
         (PUBLIC(this)->*function)();
@@ -91,16 +92,14 @@ SoFlFullViewerP::wheelPressed(int event) {
         SoDebugError::postWarning("SoFlFullViewerP::wheelPressed", "not valid event found!");
     }
 #endif
-
-
 }
 
 void
-SoFlFullViewerP::wheelReleased(int event) {
+SoFlFullViewerP::wheelReleased(Fl_Window *wheel) {
 #if SOFL_DEBUG
     SoDebugError::postInfo("SoFlFullViewerP::wheelReleased", "event arrived!");
 #endif
-    MapEvent::iterator it = objectMap.find(static_cast<Fl_Window*>(nullptr));//event.GetEventObject()));
+    MapEvent::iterator it = objectMap.find(wheel);
     if( it != objectMap.end() ) {
         VoidFuncNoPar function = it->second.onRelease;
         (PUBLIC(this)->*function)();
@@ -111,22 +110,17 @@ SoFlFullViewerP::wheelReleased(int event) {
         SoDebugError::postWarning("SoFlFullViewerP::wheelReleased", "not valid event found!");
     }
 #endif
-
 }
 
 void
-SoFlFullViewerP::wheelMoved(int event) {
-#if SOFL_DEBUG
-    SoDebugError::postInfo("SoFlFullViewerP::wheelMoved", "event arrived!");
+SoFlFullViewerP::wheelMoved(Fl_Window *wheel, float value) {
+#if SOFL_DEBUG && 0 // debug
+    SoDebugError::postInfo("SoFlFullViewerP::wheelMoved", "value: %f", value);
 #endif
-
-    Fl_Window* emitting_thumb_wheel = nullptr; //static_cast<Fl_Widget*>(event.GetEventObject());
-    MapEvent::iterator it = objectMap.find( emitting_thumb_wheel);
+    MapEvent::iterator it = objectMap.find(wheel);
     if( it != objectMap.end() ) {
         VoidFuncOnePar function = it->second.onMove;
-        float *v = nullptr;//static_cast<float*>(event.GetClientData());
-        if(v)
-            (PUBLIC(this)->*function)(*v);
+        (PUBLIC(this)->*function)(value);
     }
 
 #if SOFL_DEBUG
@@ -134,8 +128,6 @@ SoFlFullViewerP::wheelMoved(int event) {
         SoDebugError::postWarning("SoFlFullViewerP::wheelMoved", "not valid event found!");
     }
 #endif
-
-
 }
 
 #define ADD_DATA_IN_MAP(objectName) \
@@ -162,6 +154,9 @@ SoFlFullViewerP::sethomebuttonClicked(int) {
 
 void
 SoFlFullViewerP::viewallbuttonClicked(int) {
+    // Use the cached scene bounds when the GL area keeps them.
+    SoFlGLArea *area = dynamic_cast<SoFlGLArea *>(PUBLIC(this)->getGLWidget());
+    if (area && area->viewAll()) return;
     PUBLIC(this)->viewAll();
 }
 
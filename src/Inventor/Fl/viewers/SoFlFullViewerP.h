@@ -88,9 +88,9 @@ public:
     static void setThumbWheelValue(Fl_Window*, float value);
     void showDecorationWidgets(SbBool onOff);
     // Thumbwheels.
-    void wheelPressed(int);
-    void wheelReleased(int);
-    void wheelMoved(int);
+    void wheelPressed(Fl_Window *);
+    void wheelReleased(Fl_Window *);
+    void wheelMoved(Fl_Window *, float value);
 
 
     // Button row.
@@ -30,12 +30,85 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 \**************************************************************************/
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
 #include "Inventor/Fl/widgets/SoFlGLArea.h"
 #include "Inventor/Fl/SoFlGLWidgetP.h"
+#include "Inventor/Fl/SoFlGLAccumulator.h"
+#include "Inventor/Fl/SoFlGLDamage.h"
+#include "Inventor/Fl/SoFlGLPicker.h"
+#include "Inventor/Fl/SoFlGLStereo.h"
+#include "Inventor/Fl/viewers/SoFlAnimationClock.h"
+#include "Inventor/Fl/viewers/SoFlBoundingBoxCache.h"
+#include "Inventor/Fl/devices/SoFlEventClock.h"
 #include <Inventor/errors/SoDebugError.h>
 
+#include <GL/gl.h>
+
+#include <cstring>
+
+#ifdef HAVE_GLX
+#include <GL/glx.h>
+#endif
+
 #include "sofldefs.h"
 
+namespace {
+
+#ifdef HAVE_GLX
+    // Extension names are space separated, and one name can be the
+    // prefix of another (GLX_EXT_swap_control vs
+    // GLX_EXT_swap_control_tear), so match whole tokens only.
+    bool hasGLXExtension(Display *display, const char *name) {
+        const char *extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+        if (!extensions) return false;
+        const size_t length = strlen(name);
+        const char *p = extensions;
+        while ((p = strstr(p, name)) != nullptr) {
+            const bool start = (p == extensions) || (p[-1] == ' ');
+            const bool end = (p[length] == ' ') || (p[length] == '\0');
+            if (start && end) return true;
+            p += length;
+        }
+        return false;
+    }
+
+    template<typename T>
+    T getGLXProcAddress(const char *name) {
+        return reinterpret_cast<T>(glXGetProcAddressARB(reinterpret_cast<const GLubyte *>(name)));
+    }
+
+    // Same attribute list FLTK builds from an Fl_Mode, but with an
+    // explicit sample count instead of the fixed one FL_MULTISAMPLE asks
+    // for.
+    void buildGLXAttributes(Fl_Mode m, int samples, std::vector<int> &list) {
+        list.clear();
+        const int colorsize = (m & FL_RGB8) ? 8 : 1;
+        list.push_back(GLX_RGBA);
+        list.push_back(GLX_RED_SIZE);   list.push_back(colorsize);
+        list.push_back(GLX_GREEN_SIZE); list.push_back(colorsize);
+        list.push_back(GLX_BLUE_SIZE);  list.push_back(colorsize);
+        if (m & FL_ALPHA) { list.push_back(GLX_ALPHA_SIZE); list.push_back(colorsize); }
+        if (m & FL_ACCUM) {
+            list.push_back(GLX_ACCUM_RED_SIZE);   list.push_back(1);
+            list.push_back(GLX_ACCUM_GREEN_SIZE); list.push_back(1);
+            list.push_back(GLX_ACCUM_BLUE_SIZE);  list.push_back(1);
+            if (m & FL_ALPHA) { list.push_back(GLX_ACCUM_ALPHA_SIZE); list.push_back(1); }
+        }
+        if (m & FL_DOUBLE) list.push_back(GLX_DOUBLEBUFFER);
+        if (m & FL_DEPTH) { list.push_back(GLX_DEPTH_SIZE); list.push_back(1); }
+        if (m & FL_STENCIL) { list.push_back(GLX_STENCIL_SIZE); list.push_back(1); }
+        if (m & FL_STEREO) list.push_back(GLX_STEREO);
+        list.push_back(GLX_SAMPLE_BUFFERS); list.push_back(1);
+        list.push_back(GLX_SAMPLES);        list.push_back(samples);
+        list.push_back(None);
+    }
+#endif // HAVE_GLX
+
+} // namespace
+
 
 SoFlGLArea::SoFlGLArea(Fl_Window *parent,
                        SoFlGLWidgetP *parentW,
@@ -45,8 +118,10 @@ SoFlGLArea::SoFlGLArea(Fl_Window *parent,
                    parent->w(),
                    parent->h())
 , widget_p(parentW)
-, gl_format(attributes){
-    mode(gl_format);
+, gl_format(attributes)
+, requested_samples(parentW->numsamples)
+, granted_samples(0){
+    this->applyMode();
     this->copy_label("SoFlGLArea");
     gl_real_context = nullptr;
     is_gl_initialized = false;
@@ -65,6 +140,13 @@ void SoFlGLArea::draw() {
                            h());
 #endif
 
+    // Resized or uncovered: nothing of the previous frame can be reused.
+    if (widget_p->damage && (!valid() || (damage() & FL_DAMAGE_EXPOSE))) {
+        widget_p->damage->invalidate();
+    }
+    widget_p->updatePickCache();
+    if (widget_p->stereo) widget_p->stereo->updateAction();
+
     if (!valid()) {
         InitGL();
         // ...other initialization...
@@ -90,11 +172,15 @@ void SoFlGLArea::draw() {
 #endif
 
     widget_p->concreteRedraw();
+    // Single buffered areas never swap, so the render ends here.
+    if (widget_p->damage) widget_p->damage->endRender();
 
     Fl_Gl_Window::draw(); // Draw FLTK child widgets.
 }
 
 int SoFlGLArea::handle(int event) {
+    // Stamp the event; the devices read the stamp back.
+    SoFlEventClock::Dispatch dispatch(event);
 #if SOFL_DEBUG && 0
     SoDebugError::postInfo("SoFlGLArea::handle",
                            "event: %d",
@@ -102,12 +188,14 @@ int SoFlGLArea::handle(int event) {
 #endif
     switch (event) {
         case FL_KEYBOARD:
+        case FL_KEYUP:
             widget_p->onKey(event);
             return 1;
         case FL_PUSH:
         case FL_RELEASE:
         case FL_DRAG:
         case FL_MOVE:
+        case FL_MOUSEWHEEL:
             widget_p->onMouse(event);
             return 1;
         case FL_ENTER:
@@ -125,6 +213,22 @@ void SoFlGLArea::InitGL() {
         this->make_current();
         gl_real_context = this->context();
         assert(gl_real_context != nullptr);
+        this->applySwapInterval();
+
+        GLint samples = 0;
+#ifdef GL_SAMPLES
+        glGetIntegerv(GL_SAMPLES, &samples);
+#endif
+        granted_samples = samples;
+#if SOFL_DEBUG
+        if (requested_samples > 1 && samples != requested_samples) {
+            SoDebugError::postWarning("SoFlGLArea::InitGL",
+                                      "wanted %d samples, but the OpenGL "
+                                      "driver granted %d",
+                                      requested_samples, samples);
+        }
+#endif
+
         widget_p->initGL();
     }
 }
@@ -132,3 +236,365 @@ void SoFlGLArea::InitGL() {
 void SoFlGLArea::makeCurrent() {
     this->make_current();
 }
+
+/*!
+  Sets the number of vertical retraces to wait for before a buffer
+  swap. 0 renders uncapped, 1 syncs to every retrace, and a negative
+  value requests adaptive sync (late swaps tear instead of waiting a
+  full extra frame) where GLX_EXT_swap_control_tear is available.
+
+  The setting is kept across GL widget rebuilds. Returns \c true if the
+  driver accepted the interval.
+*/
+bool SoFlGLArea::setSwapInterval(int interval) {
+    widget_p->swapinterval = interval;
+    if (is_gl_initialized && this->shown()) {
+        this->make_current();
+        this->applySwapInterval();
+    }
+    return widget_p->swapcontrol;
+}
+
+/*!
+  Returns the swap interval reported back by the driver, or the
+  requested interval if swap control is not available.
+*/
+int SoFlGLArea::getSwapInterval() const {
+    return widget_p->appliedswapinterval;
+}
+
+bool SoFlGLArea::isSwapControlSupported() const {
+    return widget_p->swapcontrol;
+}
+
+/*!
+  Limits buffer swaps to at most \a fps per second by sleeping before
+  the swap, which paces rendering when the driver offers no swap
+  control. 0 disables the limiter.
+*/
+void SoFlGLArea::setFrameRateLimit(float fps) {
+    widget_p->maxframerate = (fps > 0.0f) ? fps : 0.0f;
+}
+
+float SoFlGLArea::getFrameRateLimit() const {
+    return widget_p->maxframerate;
+}
+
+Fl_Mode SoFlGLArea::getGLFormat() const {
+    return gl_format;
+}
+
+/*!
+  Returns the sample count this widget's visual was requested with.
+*/
+int SoFlGLArea::getRequestedSamples() const {
+    return requested_samples;
+}
+
+/*!
+  Returns the sample count the driver actually granted, which is only
+  known once the context has been created. 0 means no multisampling.
+*/
+int SoFlGLArea::getGrantedSamples() const {
+    return is_gl_initialized ? granted_samples : 0;
+}
+
+/*!
+  Controls whether multisampling stays enabled while a viewer is being
+  interacted with. When disabled, viewer frames rendered between the
+  interaction start and finish callbacks skip multisampling, and a
+  full-quality frame is rendered once interaction stops.
+*/
+void SoFlGLArea::setInteractiveMultisample(bool enable) {
+    widget_p->interactivemultisample = enable;
+}
+
+bool SoFlGLArea::isInteractiveMultisample() const {
+    return widget_p->interactivemultisample;
+}
+
+/*!
+  Sets how many jittered passes the progressive antialiasing enabled
+  with SoFlGLWidget::setAccumulationBuffer() averages before it stops
+  refining a still frame. Has no effect while accumulation is off.
+*/
+void SoFlGLArea::setAccumulationPasses(int passes) {
+    if (widget_p->accumulator) widget_p->accumulator->setPasses(passes);
+}
+
+int SoFlGLArea::getAccumulationPasses() const {
+    return widget_p->accumulator ? widget_p->accumulator->getPasses() : 0;
+}
+
+/*!
+  Enables partial redraws for render areas. Changes confined to a
+  separator then only re-render the screen rectangle covering that
+  separator's old and new bounding boxes, and the rest of the frame is
+  restored from a copy of the previous one. Camera changes, resizes,
+  exposes and large changes still render the full frame.
+
+  Returns \c false if partial redraws are not available, which is the
+  case for GL widgets that are not render areas, and for
+  SoFlMultiViewRenderArea.
+*/
+bool SoFlGLArea::setPartialRedraw(bool enable) {
+    return widget_p->setPartialRedraw(enable);
+}
+
+bool SoFlGLArea::isPartialRedraw() const {
+    return widget_p->damage != nullptr;
+}
+
+/*!
+  Enables picking from an ID buffer for render areas. Every shape is
+  rendered offscreen in a colour of its own, together with depth, and
+  the buffer is kept until the scene, the camera or the size changes.
+  Picks against an unchanged view then only read back a few pixels,
+  which is cheap enough for hover highlighting on large scenes. Viewers
+  also use it to find the point to seek to.
+
+  Returns \c false if ID buffer picking is not available, which is the
+  case for GL widgets that are not render areas.
+*/
+bool SoFlGLArea::setIDBufferPicking(bool enable) {
+    return widget_p->setIDBufferPicking(enable);
+}
+
+bool SoFlGLArea::isIDBufferPicking() const {
+    return widget_p->picker != nullptr;
+}
+
+/*!
+  Returns the path to the shape drawn nearest to \a pos, in pixels from
+  the lower left corner, within a few pixels, or \c NULL if there is
+  none or ID buffer picking is off. The point that was hit is written
+  to \a point if given.
+
+  The path is owned by the pick cache and only lives until the scene
+  or camera changes; ref() it to keep it.
+*/
+SoPath * SoFlGLArea::pick(const SbVec2s & pos, SbVec3f * point) {
+    return widget_p->picker ? widget_p->picker->pick(pos, point) : nullptr;
+}
+
+/*!
+  Appends the paths to all shapes visible inside \a rect, in pixels, to
+  \a paths and returns how many there were.
+*/
+int SoFlGLArea::pick(const SbBox2s & rect, SoPathList & paths) {
+    return widget_p->picker ? widget_p->picker->pick(rect, paths) : 0;
+}
+
+/*!
+  Makes a render area keep an SoFlPickCache over its scene manager's
+  scene graph, camera included. The cache is built in the background
+  and kept up to date as the scene changes; viewers use it to find the
+  point to seek to, and applications can query it from their pick
+  callbacks and for rubber band selection instead of applying an
+  SoRayPickAction to the whole scene.
+
+  Returns \c false if the cache is not available, which is the case for
+  GL widgets that are not render areas.
+*/
+bool SoFlGLArea::setPickCache(bool enable) {
+    return widget_p->setPickCache(enable);
+}
+
+SoFlPickCache * SoFlGLArea::getPickCache() const {
+    widget_p->updatePickCache();
+    return widget_p->pickcache;
+}
+
+/*!
+  Makes a viewer keep the bounds of its scene graph between frames,
+  for view all and for the automatic near and far clipping planes,
+  instead of traversing the whole scene each time. The bounds are only
+  computed again after the scene has changed, and then only the
+  changed parts are traversed.
+
+  The cache does the viewer's automatic clipping while it is on, as
+  long as SoFlViewer::isAutoClipping() is \c TRUE. The viewer does not
+  report its clipping strategy, so set it with setAutoClippingStrategy()
+  for the cache to follow it.
+
+  Returns \c false if the cache is not available, which is the case for
+  GL widgets that are not viewers.
+*/
+bool SoFlGLArea::setBoundingBoxCache(bool enable) {
+    return widget_p->setBoundingBoxCache(enable);
+}
+
+bool SoFlGLArea::isBoundingBoxCache() const {
+    return widget_p->bboxcache != nullptr;
+}
+
+/*!
+  Sets the viewer's automatic clipping strategy, as
+  SoFlViewer::setAutoClippingStrategy() does, and has the bounding box
+  cache clip the same way. Returns \c false if the GL widget is not a
+  viewer.
+*/
+bool SoFlGLArea::setAutoClippingStrategy(AutoClippingStrategy strategy, float value,
+                                         SoFlAutoClippingCB * cb, void * userdata) {
+    return widget_p->setAutoClippingStrategy(strategy, value, cb, userdata);
+}
+
+/*!
+  Frames the whole scene from the cached bounds, as
+  SoFlViewer::viewAll() does. Returns \c false, without moving the
+  camera, if the bounding box cache is off.
+*/
+bool SoFlGLArea::viewAll() {
+    if (!widget_p->bboxcache) return false;
+    widget_p->bboxcache->viewAll();
+    return true;
+}
+
+/*!
+  Runs a viewer's spin and seek animations on one timer ticking \a rate
+  times per second. Each tick moves the camera by the real time that
+  has passed, so animations keep their speed however long a frame takes
+  to render, and ticks missed during a slow frame are skipped instead
+  of being caught up on. 0 hands the animations back to the viewer.
+
+  Examiner viewers spin at the speed the camera was turning when the
+  left button was let go, as long as
+  SoFlExaminerViewer::isAnimationEnabled() is \c TRUE; turning the
+  animation off stops the spin. Seeks follow the viewer's seek time,
+  distance and detail seek setting, and end when seek mode is turned
+  off.
+
+  Returns \c false if the clock is not available, which is the case for
+  GL widgets that are not viewers.
+*/
+bool SoFlGLArea::setAnimationRate(float rate) {
+    return widget_p->setAnimationRate(rate);
+}
+
+/*!
+  Returns the animation clock's ticks per second, or 0 if it is off.
+*/
+float SoFlGLArea::getAnimationRate() const {
+    return widget_p->animationclock ? widget_p->animationclock->getRate() : 0.0f;
+}
+
+/*!
+  Shows a viewer in stereo without a quad buffered visual. Both eyes
+  are rendered into the back buffer of every frame: side by side or one
+  above the other, each in half of the window, as a red/cyan anaglyph,
+  or in alternating rows with the left eye on the even rows of the
+  screen.
+  The eyes are set apart by SoFlViewer::getStereoOffset().
+
+  The eyes are rendered in place of the viewer's monoscopic pass, so a
+  frame traverses the scene twice, not three times, and the second eye
+  reuses the render caches the first one has built. The viewer's GL
+  render action's abort callback is taken for this while stereo is on;
+  a callback set before is still called, and is put back afterwards.
+  Superimpositions are rendered once, over both eyes. Frames are always
+  redrawn in full while stereo is on, whatever setPartialRedraw() says.
+  Quad buffer stereo through SoFlViewer::setStereoViewing() takes
+  precedence.
+
+  Returns \c false if software stereo is not available, which is the
+  case for GL widgets that are not viewers.
+*/
+bool SoFlGLArea::setStereoMode(StereoMode mode) {
+    // The enumerations are kept in step.
+    return widget_p->setStereoMode(static_cast<int>(mode));
+}
+
+SoFlGLArea::StereoMode SoFlGLArea::getStereoMode() const {
+    return widget_p->stereo ? static_cast<StereoMode>(widget_p->stereo->getMode()) : STEREO_NONE;
+}
+
+/*!
+  Returns how long the last stereo frame took to traverse each eye, in
+  milliseconds of wall clock time. GL work still queued when the
+  traversal returns is not waited for, and the composite that
+  interlaces the eyes is not counted. The second figure is what stereo
+  adds to a monoscopic frame, usually a fraction of the first once
+  render caches are in place. Both are 0 when stereo is off.
+*/
+void SoFlGLArea::getStereoFrameTimes(float & firsteye, float & secondeye) const {
+    firsteye = widget_p->stereo ? widget_p->stereo->getFirstEyeTime() : 0.0f;
+    secondeye = widget_p->stereo ? widget_p->stereo->getSecondEyeTime() : 0.0f;
+}
+
+/*!
+  Reverses the direction of the mouse wheel, both ways, for systems
+  where FLTK does not follow the "natural scrolling" setting. Wheel
+  motion reaches the scene once per frame, summed up over the frame.
+  Defaults to on if the SOFL_INVERT_WHEEL environment variable is set
+  to a positive number.
+*/
+void SoFlGLArea::setWheelInverted(bool inverted) {
+    widget_p->wheelinverted = inverted;
+}
+
+bool SoFlGLArea::isWheelInverted() const {
+    return widget_p->wheelinverted;
+}
+
+// Picks the visual. Multisampled visuals fall back to fewer samples
+// before giving up on multisampling altogether.
+void SoFlGLArea::applyMode() {
+#if defined(HAVE_GLX) && defined(GLX_SAMPLES)
+    for (int samples = requested_samples; samples > 1; samples /= 2) {
+        buildGLXAttributes(gl_format, samples, glx_attributes);
+        if (Fl_Gl_Window::can_do(glx_attributes.data())) {
+            mode(glx_attributes.data());
+            return;
+        }
+    }
+    glx_attributes.clear();
+#endif // HAVE_GLX
+    mode(gl_format);
+}
+
+// Must be called with this context current.
+void SoFlGLArea::applySwapInterval() {
+    const int interval = widget_p->swapinterval;
+    widget_p->appliedswapinterval = interval;
+    widget_p->swapcontrol = false;
+
+#ifdef HAVE_GLX
+    Display *display = glXGetCurrentDisplay();
+    GLXDrawable drawable = glXGetCurrentDrawable();
+    if (!display || !drawable) return;
+
+    if (hasGLXExtension(display, "GLX_EXT_swap_control")) {
+        const bool tear = hasGLXExtension(display, "GLX_EXT_swap_control_tear");
+        auto swapIntervalEXT = getGLXProcAddress<PFNGLXSWAPINTERVALEXTPROC>("glXSwapIntervalEXT");
+        if (swapIntervalEXT && (interval >= 0 || tear)) {
+            swapIntervalEXT(display, drawable, interval);
+            unsigned int value = 0;
+            glXQueryDrawable(display, drawable, GLX_SWAP_INTERVAL_EXT, &value);
+            // Adaptive sync is reported back through a separate attribute.
+            int applied = static_cast<int>(value);
+            if (tear && interval < 0) {
+                unsigned int late = 0;
+                glXQueryDrawable(display, drawable, GLX_LATE_SWAPS_TEAR_EXT, &late);
+                if (late) applied = -applied;
+            }
+            widget_p->appliedswapinterval = applied;
+            widget_p->swapcontrol = true;
+        }
+    } else if (hasGLXExtension(display, "GLX_MESA_swap_control") && interval >= 0) {
+        auto swapIntervalMESA = getGLXProcAddress<PFNGLXSWAPINTERVALMESAPROC>("glXSwapIntervalMESA");
+        auto getSwapIntervalMESA = getGLXProcAddress<PFNGLXGETSWAPINTERVALMESAPROC>("glXGetSwapIntervalMESA");
+        if (swapIntervalMESA && swapIntervalMESA(static_cast<unsigned int>(interval)) == 0) {
+            widget_p->appliedswapinterval = getSwapIntervalMESA ? getSwapIntervalMESA() : interval;
+            widget_p->swapcontrol = true;
+        }
+    }
+#endif // HAVE_GLX
+
+#if SOFL_DEBUG
+    if (!widget_p->swapcontrol) {
+        SoDebugError::postWarning("SoFlGLArea::applySwapInterval",
+                                  "swap interval %d requested, but the driver "
+                                  "offers no swap control", interval);
+    }
+#endif
+}
@@ -36,10 +36,37 @@
 #include <FL/Fl_Gl_Window.H>
 #include <FL/Enumerations.H>
 
+#include "Inventor/Fl/SoFlBasic.h"
+
+#include <vector>
+
+class SbBox2s;
+class SbVec2f;
+class SbVec2s;
+class SbVec3f;
 class SoFlGLWidgetP;
+class SoFlPickCache;
+class SoPath;
+class SoPathList;
 
-class SoFlGLArea : public Fl_Gl_Window {
+// The same as in SoFlViewer.h.
+typedef SbVec2f SoFlAutoClippingCB(void * data, const SbVec2f & nearfar);
+
+class SOFL_DLL_API SoFlGLArea : public Fl_Gl_Window {
 public:
+    // In step with SoFlViewer::AutoClippingStrategy.
+    enum AutoClippingStrategy {
+        CLIPPING_VARIABLE_NEAR_PLANE,
+        CLIPPING_CONSTANT_NEAR_PLANE
+    };
+
+    enum StereoMode {
+        STEREO_NONE,
+        STEREO_SIDE_BY_SIDE,
+        STEREO_TOP_BOTTOM,
+        STEREO_ANAGLYPH,
+        STEREO_INTERLACED
+    };
 
     SoFlGLArea(Fl_Window *parent,
                SoFlGLWidgetP *parentWidget,
@@ -55,6 +82,50 @@ public:
     static bool areEqual(Fl_Mode &format1,
                          Fl_Mode &format2);
 
+    bool setSwapInterval(int interval);
+    int getSwapInterval() const;
+    bool isSwapControlSupported() const;
+
+    void setFrameRateLimit(float fps);
+    float getFrameRateLimit() const;
+
+    Fl_Mode getGLFormat() const;
+    int getRequestedSamples() const;
+    int getGrantedSamples() const;
+
+    void setInteractiveMultisample(bool enable);
+    bool isInteractiveMultisample() const;
+
+    void setAccumulationPasses(int passes);
+    int getAccumulationPasses() const;
+
+    bool setPartialRedraw(bool enable);
+    bool isPartialRedraw() const;
+
+    bool setIDBufferPicking(bool enable);
+    bool isIDBufferPicking() const;
+    SoPath * pick(const SbVec2s & pos, SbVec3f * point = nullptr);
+    int pick(const SbBox2s & rect, SoPathList & paths);
+
+    bool setPickCache(bool enable);
+    SoFlPickCache * getPickCache() const;
+
+    bool setBoundingBoxCache(bool enable);
+    bool isBoundingBoxCache() const;
+    bool setAutoClippingStrategy(AutoClippingStrategy strategy, float value = 0.6f,
+                                 SoFlAutoClippingCB * cb = nullptr, void * userdata = nullptr);
+    bool viewAll();
+
+    bool setAnimationRate(float rate);
+    float getAnimationRate() const;
+
+    bool setStereoMode(StereoMode mode);
+    StereoMode getStereoMode() const;
+    void getStereoFrameTimes(float & firsteye, float & secondeye) const;
+
+    void setWheelInverted(bool inverted);
+    bool isWheelInverted() const;
+
 protected:
     int handle(int event) override;
 
@@ -62,11 +133,18 @@ protected:
 
 private:
     void InitGL();
+    void applySwapInterval();
+    void applyMode();
 
     SoFlGLWidgetP* widget_p;
     GLContext gl_real_context;
     bool is_gl_initialized;
     Fl_Mode gl_format;
+    int requested_samples;
+    int granted_samples;
+    // Fl_Gl_Window::mode(const int *) keeps the pointer, so the list
+    // has to live as long as the window.
+    std::vector<int> glx_attributes;
 };
 
 
@@ -0,0 +1,290 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/widgets/SoFlGraphView.h"
+#include "Inventor/Fl/SoFlGraphEditorModel.h"
+
+#include <FL/Fl.H>
+#include <FL/Fl_Scrollbar.H>
+#include <FL/fl_draw.H>
+
+#include <algorithm>
+
+namespace {
+
+    // Horizontal space per nesting level, and for the expander box.
+    const int INDENT = 16;
+    const int EXPANDER_SIZE = 9;
+
+    // Rows scrolled per mouse wheel step.
+    const int WHEEL_ROWS = 3;
+
+} // namespace
+
+SoFlGraphView::SoFlGraphView(int x, int y, int w, int h, const char * label)
+    : Fl_Group(x, y, w, h, label)
+{
+    this->box(FL_DOWN_BOX);
+    this->color(FL_BACKGROUND2_COLOR);
+    this->selection_color(FL_SELECTION_COLOR);
+
+    const int sw = Fl::scrollbar_size();
+    this->scrollbar = new Fl_Scrollbar(x + w - Fl::box_dx(this->box()) - sw,
+                                       y + Fl::box_dy(this->box()),
+                                       sw, h - Fl::box_dh(this->box()));
+    this->scrollbar->type(FL_VERTICAL);
+    this->scrollbar->callback(&SoFlGraphView::scrollCB, this);
+    this->end();
+    this->updateScrollbar();
+}
+
+SoFlGraphView::~SoFlGraphView()
+{
+}
+
+void
+SoFlGraphView::setModel(SoFlGraphEditorModel * m)
+{
+    this->model = m;
+    this->rowsChanged();
+}
+
+SoFlGraphEditorModel *
+SoFlGraphView::getModel() const
+{
+    return this->model;
+}
+
+void
+SoFlGraphView::rowsChanged()
+{
+    if (!this->model || !this->model->isAlive(this->selected))
+        this->selected = -1;
+    this->scrollTo(this->top);
+}
+
+int
+SoFlGraphView::getSelectedItem() const
+{
+    return this->selected;
+}
+
+void
+SoFlGraphView::select(int item)
+{
+    this->selected = item;
+    if (item >= 0) this->showItem(item);
+    this->redraw();
+}
+
+void
+SoFlGraphView::showItem(int item)
+{
+    if (!this->model) return;
+    const int row = this->model->getRowOfItem(item);
+    if (row < 0) return;
+    if (row < this->top) this->scrollTo(row);
+    else if (row >= this->top + this->pageRows()) this->scrollTo(row - this->pageRows() + 1);
+}
+
+int
+SoFlGraphView::rowHeight() const
+{
+    fl_font(this->labelfont(), this->labelsize());
+    return fl_height() + 2;
+}
+
+int
+SoFlGraphView::pageRows() const
+{
+    return std::max(1, (this->h() - Fl::box_dh(this->box())) / this->rowHeight());
+}
+
+void
+SoFlGraphView::scrollTo(int row)
+{
+    const int rows = this->model ? this->model->getNumRows() : 0;
+    this->top = std::max(0, std::min(row, rows - this->pageRows()));
+    this->updateScrollbar();
+    this->redraw();
+}
+
+void
+SoFlGraphView::updateScrollbar()
+{
+    const int rows = this->model ? this->model->getNumRows() : 0;
+    this->scrollbar->value(this->top, this->pageRows(), 0, std::max(rows, 1));
+}
+
+void
+SoFlGraphView::scrollCB(Fl_Widget *, void * closure)
+{
+    auto * view = static_cast<SoFlGraphView *>(closure);
+    view->top = view->scrollbar->value();
+    view->redraw();
+}
+
+void
+SoFlGraphView::userSelect(int item)
+{
+    if (item < 0 || item == this->selected) return;
+    this->select(item);
+    this->do_callback();
+}
+
+void
+SoFlGraphView::resize(int x, int y, int w, int h)
+{
+    Fl_Widget::resize(x, y, w, h);
+    const int sw = Fl::scrollbar_size();
+    this->scrollbar->resize(x + w - Fl::box_dx(this->box()) - sw,
+                            y + Fl::box_dy(this->box()),
+                            sw, h - Fl::box_dh(this->box()));
+    this->scrollTo(this->top);
+}
+
+void
+SoFlGraphView::draw()
+{
+    const int bx = this->x() + Fl::box_dx(this->box());
+    const int by = this->y() + Fl::box_dy(this->box());
+    const int bw = this->w() - Fl::box_dw(this->box()) - this->scrollbar->w();
+    const int bh = this->h() - Fl::box_dh(this->box());
+
+    this->draw_box();
+    this->draw_child(*this->scrollbar);
+    if (!this->model) return;
+
+    fl_push_clip(bx, by, bw, bh);
+    const int rh = this->rowHeight();
+    const int last = std::min(this->model->getNumRows(), this->top + bh / rh + 1);
+    for (int row = this->top; row < last; row++) {
+        const int item = this->model->getItemAtRow(row);
+        const SoFlGraphEditorModel::Item & i = this->model->getItem(item);
+        const int ry = by + (row - this->top) * rh;
+        const int rx = bx + 2 + i.depth * INDENT;
+
+        Fl_Color text = this->labelcolor();
+        if (item == this->selected) {
+            fl_color(this->selection_color());
+            fl_rectf(bx, ry, bw, rh);
+            text = fl_contrast(text, this->selection_color());
+        }
+        fl_color(text);
+
+        if (this->model->isExpandable(item)) {
+            const int ey = ry + (rh - EXPANDER_SIZE) / 2;
+            const int mid = EXPANDER_SIZE / 2;
+            fl_rect(rx, ey, EXPANDER_SIZE, EXPANDER_SIZE);
+            fl_xyline(rx + 2, ey + mid, rx + EXPANDER_SIZE - 3);
+            if (!i.expanded)
+                fl_yxline(rx + mid, ey + 2, ey + EXPANDER_SIZE - 3);
+        }
+        fl_draw(this->model->getLabel(item).getString(),
+                rx + INDENT, ry, bw, rh, FL_ALIGN_LEFT);
+    }
+    fl_pop_clip();
+}
+
+int
+SoFlGraphView::handle(int event)
+{
+    switch (event) {
+    case FL_PUSH: {
+        if (Fl::event_inside(this->scrollbar) || !this->model)
+            break;
+        this->take_focus();
+        const int by = this->y() + Fl::box_dy(this->box());
+        const int row = this->top + (Fl::event_y() - by) / this->rowHeight();
+        const int item = this->model->getItemAtRow(row);
+        if (item < 0) return 1;
+
+        const int rx = this->x() + Fl::box_dx(this->box()) + 2 +
+            this->model->getItem(item).depth * INDENT;
+        const bool onexpander = Fl::event_x() >= rx && Fl::event_x() < rx + INDENT;
+        if (onexpander || Fl::event_clicks()) {
+            this->model->toggle(item);
+            this->rowsChanged();
+        }
+        this->userSelect(item);
+        return 1;
+    }
+    case FL_MOUSEWHEEL:
+        this->scrollTo(this->top + Fl::event_dy() * WHEEL_ROWS);
+        return 1;
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+        return 1;
+    case FL_KEYBOARD: {
+        if (!this->model || this->model->getNumRows() == 0) break;
+        const int row = std::max(0, this->model->getRowOfItem(this->selected));
+        const int page = this->pageRows();
+        int target = -1;
+        switch (Fl::event_key()) {
+        case FL_Up: target = row - 1; break;
+        case FL_Down: target = row + 1; break;
+        case FL_Page_Up: target = row - page; break;
+        case FL_Page_Down: target = row + page; break;
+        case FL_Home: target = 0; break;
+        case FL_End: target = this->model->getNumRows() - 1; break;
+        case FL_Left:
+            if (this->selected < 0) return 1;
+            if (this->model->getItem(this->selected).expanded) {
+                this->model->collapse(this->selected);
+                this->rowsChanged();
+            }
+            else {
+                this->userSelect(this->model->getItem(this->selected).parent);
+            }
+            return 1;
+        case FL_Right:
+            if (this->selected < 0) return 1;
+            this->model->expand(this->selected);
+            this->rowsChanged();
+            return 1;
+        default:
+            return Fl_Group::handle(event);
+        }
+        target = std::max(0, std::min(target, this->model->getNumRows() - 1));
+        this->userSelect(this->model->getItemAtRow(target));
+        return 1;
+    }
+    default:
+        break;
+    }
+    return Fl_Group::handle(event);
+}
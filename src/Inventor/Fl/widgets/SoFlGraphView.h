@@ -0,0 +1,91 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLGRAPHVIEW_H
+#define SOFL_SOFLGRAPHVIEW_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <FL/Fl_Group.H>
+
+class Fl_Scrollbar;
+class SoFlGraphEditorModel;
+
+// Tree view over an SoFlGraphEditorModel. Rows are painted straight
+// from the model's list of visible rows; no widget is created per row,
+// and only the rows inside the viewport are touched when drawing, so
+// the cost of a redraw does not depend on the size of the graph.
+//
+// The widget callback is invoked when the user selects a row.
+class SoFlGraphView : public Fl_Group {
+public:
+    SoFlGraphView(int x, int y, int w, int h, const char * label = nullptr);
+    ~SoFlGraphView() override;
+
+    void setModel(SoFlGraphEditorModel * model);
+    SoFlGraphEditorModel * getModel() const;
+
+    // To be called when the model's rows changed other than through
+    // the view.
+    void rowsChanged();
+
+    int getSelectedItem() const;
+    // Selects 'item' without invoking the callback; -1 clears.
+    void select(int item);
+    // Scrolls so that the row of 'item' is inside the viewport.
+    void showItem(int item);
+
+    int handle(int event) override;
+    void resize(int x, int y, int w, int h) override;
+
+protected:
+    void draw() override;
+
+private:
+    static void scrollCB(Fl_Widget * w, void * closure);
+
+    int rowHeight() const;
+    int pageRows() const;
+    void scrollTo(int row);
+    void updateScrollbar();
+    void userSelect(int item);
+
+    SoFlGraphEditorModel * model{};
+    Fl_Scrollbar * scrollbar{};
+    int top{};
+    int selected{-1};
+};
+
+#endif // !SOFL_SOFLGRAPHVIEW_H
@@ -0,0 +1,205 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/widgets/SoFlMaterialPalette.h"
+#include "Inventor/Fl/widgets/SoFlMaterialPreviewCache.h"
+
+#include <Inventor/nodes/SoMaterial.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+#include <FL/Fl.H>
+#include <FL/fl_draw.H>
+
+#include <algorithm>
+
+namespace {
+
+    // Gap around each swatch, used for the selection frame.
+    const int SWATCH_MARGIN = 3;
+
+} // namespace
+
+SoFlMaterialPalette::SoFlMaterialPalette(int x, int y, int w, int h, const char * label)
+    : Fl_Widget(x, y, w, h, label)
+{
+    this->box(FL_DOWN_BOX);
+    this->color(FL_BACKGROUND2_COLOR);
+    this->selection_color(FL_SELECTION_COLOR);
+}
+
+SoFlMaterialPalette::~SoFlMaterialPalette()
+{
+    this->removeAllMaterials();
+}
+
+void
+SoFlMaterialPalette::addMaterial(SoMaterial * material)
+{
+    if (!material) return;
+    this->materials.append(material);
+    // Delayed, so that a burst of edits repaints once.
+    auto * sensor = new SoNodeSensor(SoFlMaterialPalette::materialChangedCB, this);
+    sensor->attach(material);
+    this->sensors.push_back(sensor);
+    this->redraw();
+}
+
+void
+SoFlMaterialPalette::removeAllMaterials()
+{
+    for (SoNodeSensor * sensor : this->sensors) delete sensor;
+    this->sensors.clear();
+    this->materials.truncate(0);
+    this->selected = -1;
+    this->redraw();
+}
+
+int
+SoFlMaterialPalette::getNumMaterials() const
+{
+    return this->materials.getLength();
+}
+
+SoMaterial *
+SoFlMaterialPalette::getMaterial(int index) const
+{
+    if (index < 0 || index >= this->materials.getLength()) return nullptr;
+    return static_cast<SoMaterial *>(this->materials[index]);
+}
+
+void
+SoFlMaterialPalette::setSwatchSize(int pixels)
+{
+    this->swatchsize = std::max(8, pixels);
+    this->redraw();
+}
+
+int
+SoFlMaterialPalette::getSwatchSize() const
+{
+    return this->swatchsize;
+}
+
+int
+SoFlMaterialPalette::getSelected() const
+{
+    return this->selected;
+}
+
+void
+SoFlMaterialPalette::select(int index)
+{
+    this->selected = (index >= 0 && index < this->getNumMaterials()) ? index : -1;
+    this->redraw();
+}
+
+int
+SoFlMaterialPalette::columns() const
+{
+    const int cell = this->swatchsize + 2 * SWATCH_MARGIN;
+    return std::max(1, (this->w() - Fl::box_dw(this->box())) / cell);
+}
+
+int
+SoFlMaterialPalette::swatchAt(int ex, int ey) const
+{
+    const int cell = this->swatchsize + 2 * SWATCH_MARGIN;
+    const int col = (ex - this->x() - Fl::box_dx(this->box())) / cell;
+    const int row = (ey - this->y() - Fl::box_dy(this->box())) / cell;
+    if (col < 0 || row < 0 || col >= this->columns()) return -1;
+    const int index = row * this->columns() + col;
+    return index < this->getNumMaterials() ? index : -1;
+}
+
+void
+SoFlMaterialPalette::draw()
+{
+    this->draw_box();
+    const int bx = this->x() + Fl::box_dx(this->box());
+    const int by = this->y() + Fl::box_dy(this->box());
+    const int cell = this->swatchsize + 2 * SWATCH_MARGIN;
+    const int cols = this->columns();
+
+    fl_push_clip(bx, by, this->w() - Fl::box_dw(this->box()),
+                 this->h() - Fl::box_dh(this->box()));
+    for (int i = 0; i < this->getNumMaterials(); i++) {
+        const int cx = bx + (i % cols) * cell;
+        const int cy = by + (i / cols) * cell;
+        // Swatches outside the damaged area are neither looked up nor
+        // rendered.
+        if (!fl_not_clipped(cx, cy, cell, cell)) continue;
+
+        if (i == this->selected) {
+            fl_color(this->selection_color());
+            fl_rectf(cx, cy, cell, cell);
+        }
+        Fl_RGB_Image * preview =
+            SoFlMaterialPreviewCache::get(this->getMaterial(i), this->swatchsize);
+        if (preview) {
+            preview->draw(cx + SWATCH_MARGIN, cy + SWATCH_MARGIN);
+        }
+        else {
+            fl_color(FL_DARK3);
+            fl_rect(cx + SWATCH_MARGIN, cy + SWATCH_MARGIN,
+                    this->swatchsize, this->swatchsize);
+        }
+    }
+    fl_pop_clip();
+}
+
+int
+SoFlMaterialPalette::handle(int event)
+{
+    switch (event) {
+    case FL_PUSH: {
+        const int index = this->swatchAt(Fl::event_x(), Fl::event_y());
+        if (index < 0) return 1;
+        this->select(index);
+        this->do_callback();
+        return 1;
+    }
+    default:
+        return Fl_Widget::handle(event);
+    }
+}
+
+void
+SoFlMaterialPalette::materialChangedCB(void * closure, SoSensor *)
+{
+    // The cache notices the new values; this only asks for a repaint.
+    static_cast<SoFlMaterialPalette *>(closure)->redraw();
+}
@@ -0,0 +1,88 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLMATERIALPALETTE_H
+#define SOFL_SOFLMATERIALPALETTE_H
+
+#include <FL/Fl_Widget.H>
+
+#include "Inventor/Fl/SoFlBasic.h"
+
+#include <Inventor/lists/SoNodeList.h>
+
+#include <vector>
+
+class SoMaterial;
+class SoNodeSensor;
+class SoSensor;
+
+// A grid of material swatches, each showing its material on a lit
+// sphere. The previews come from a shared offscreen-rendered cache
+// keyed on the material values: a swatch is only rendered again when
+// its material changes, and a material shown before costs nothing.
+//
+// The widget callback is invoked when the user picks a swatch.
+class SOFL_DLL_API SoFlMaterialPalette : public Fl_Widget {
+public:
+    SoFlMaterialPalette(int x, int y, int w, int h, const char * label = nullptr);
+    ~SoFlMaterialPalette() override;
+
+    void addMaterial(SoMaterial * material);
+    void removeAllMaterials();
+    int getNumMaterials() const;
+    SoMaterial * getMaterial(int index) const;
+
+    void setSwatchSize(int pixels);
+    int getSwatchSize() const;
+
+    // -1 when nothing is selected.
+    int getSelected() const;
+    void select(int index);
+
+    int handle(int event) override;
+
+protected:
+    void draw() override;
+
+private:
+    static void materialChangedCB(void * closure, SoSensor * sensor);
+    int swatchAt(int x, int y) const;
+    int columns() const;
+
+    SoNodeList materials;
+    std::vector<SoNodeSensor *> sensors;
+    int swatchsize{48};
+    int selected{-1};
+};
+
+#endif //SOFL_SOFLMATERIALPALETTE_H
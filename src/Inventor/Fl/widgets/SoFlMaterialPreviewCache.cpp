@@ -0,0 +1,252 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#include "Inventor/Fl/widgets/SoFlMaterialPreviewCache.h"
+#include "Inventor/Fl/SoAny.h"
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoOffscreenRenderer.h>
+#include <Inventor/errors/SoDebugError.h>
+#include <Inventor/nodes/SoDirectionalLight.h>
+#include <Inventor/nodes/SoMaterial.h>
+#include <Inventor/nodes/SoPerspectiveCamera.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoSphere.h>
+
+#include <cstring>
+#include <list>
+#include <map>
+#include <utility>
+
+#include "sofldefs.h"
+
+namespace {
+
+    typedef std::pair<uint64_t, int> PreviewKey;
+
+    struct Preview {
+        Fl_RGB_Image * image;
+        // The values it was rendered with, to tell hash collisions apart.
+        SoMaterial * values;
+        std::list<PreviewKey>::iterator used;
+    };
+
+    // Only touched from the FLTK thread.
+    struct Store {
+        std::map<PreviewKey, Preview> entries;
+        std::list<PreviewKey> lru;    // most recently used first
+        size_t maxentries = 256;
+        int renders = 0;
+        SoSeparator * scene = nullptr;
+        SoPerspectiveCamera * camera = nullptr;
+        SoMaterial * material = nullptr;
+        SoOffscreenRenderer * renderer = nullptr;
+    };
+
+    Store & store() {
+        static Store s;
+        return s;
+    }
+
+    // FNV-1a.
+    uint64_t mix(uint64_t h, const void * data, size_t bytes) {
+        const unsigned char * p = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < bytes; i++) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    template <class Field>
+    uint64_t mixField(uint64_t h, const Field & field) {
+        const int num = field.getNum();
+        h = mix(h, &num, sizeof(num));
+        return mix(h, field.getValues(0), num * sizeof(*field.getValues(0)));
+    }
+
+    void release(Preview & preview) {
+        delete preview.image;
+        preview.values->unref();
+    }
+
+    void evict(Store & s) {
+        while (s.entries.size() > s.maxentries) {
+            auto entry = s.entries.find(s.lru.back());
+            release(entry->second);
+            s.entries.erase(entry);
+            s.lru.pop_back();
+        }
+    }
+
+    void cleanup() {
+        Store & s = store();
+        SoFlMaterialPreviewCache::clear();
+        delete s.renderer;
+        s.renderer = nullptr;
+        if (s.scene) s.scene->unref();
+        s.scene = nullptr;
+        s.camera = nullptr;
+        s.material = nullptr;
+    }
+
+    SoSeparator * previewScene(Store & s) {
+        if (s.scene) return s.scene;
+        s.scene = new SoSeparator;
+        s.scene->ref();
+        s.camera = new SoPerspectiveCamera;
+        s.camera->position.setValue(0.0f, 0.0f, 3.2f);
+        s.camera->nearDistance = 1.0f;
+        s.camera->farDistance = 5.0f;
+        s.scene->addChild(s.camera);
+        auto * light = new SoDirectionalLight;
+        light->direction.setValue(-0.5f, -0.5f, -1.0f);
+        s.scene->addChild(light);
+        s.material = new SoMaterial;
+        s.scene->addChild(s.material);
+        s.scene->addChild(new SoSphere);
+        // One renderer for all previews: its GL context and buffers
+        // are only set up again when the size changes.
+        s.renderer = new SoOffscreenRenderer(SbViewportRegion(1, 1));
+        s.renderer->setComponents(SoOffscreenRenderer::RGB);
+        s.renderer->setBackgroundColor(SbColor(0.25f, 0.25f, 0.25f));
+        SoAny::atexit(cleanup, 0);
+        return s.scene;
+    }
+
+    Fl_RGB_Image * render(Store & s, const SoMaterial * material, int size) {
+        SoSeparator * scene = previewScene(s);
+        s.material->copyFieldValues(material);
+
+        SoOffscreenRenderer * renderer = s.renderer;
+        if (renderer->getViewportRegion().getWindowSize() != SbVec2s(size, size)) {
+            renderer->setViewportRegion(SbViewportRegion(size, size));
+        }
+        if (!renderer->render(scene)) {
+#if SOFL_DEBUG
+            SoDebugError::postWarning("SoFlMaterialPreviewCache::get",
+                                      "offscreen rendering failed");
+#endif
+            return nullptr;
+        }
+        s.renders++;
+
+        // GL rows run bottom to top.
+        const int stride = size * 3;
+        const unsigned char * pixels = renderer->getBuffer();
+        auto * buffer = new uchar[size * stride];
+        for (int y = 0; y < size; y++)
+            std::memcpy(buffer + y * stride, pixels + (size - 1 - y) * stride, stride);
+        auto * image = new Fl_RGB_Image(buffer, size, size, 3);
+        image->alloc_array = 1;
+        return image;
+    }
+
+} // namespace
+
+uint64_t
+SoFlMaterialPreviewCache::hash(const SoMaterial * material)
+{
+    uint64_t h = 14695981039346656037ull;
+    h = mixField(h, material->ambientColor);
+    h = mixField(h, material->diffuseColor);
+    h = mixField(h, material->specularColor);
+    h = mixField(h, material->emissiveColor);
+    h = mixField(h, material->shininess);
+    h = mixField(h, material->transparency);
+    return h;
+}
+
+Fl_RGB_Image *
+SoFlMaterialPreviewCache::get(const SoMaterial * material, int size)
+{
+    if (!material || size <= 0) return nullptr;
+    Store & s = store();
+    const PreviewKey key(SoFlMaterialPreviewCache::hash(material), size);
+
+    auto it = s.entries.find(key);
+    if (it != s.entries.end() && it->second.values->fieldsAreEqual(material)) {
+        s.lru.splice(s.lru.begin(), s.lru, it->second.used);
+        return it->second.image;
+    }
+
+    Fl_RGB_Image * image = render(s, material, size);
+    if (!image) return nullptr;
+    auto * values = new SoMaterial;
+    values->ref();
+    values->copyFieldValues(material);
+    if (it != s.entries.end()) {
+        // Another material with the same hash: the newer one wins.
+        release(it->second);
+        it->second.image = image;
+        it->second.values = values;
+        s.lru.splice(s.lru.begin(), s.lru, it->second.used);
+        return image;
+    }
+    s.lru.push_front(key);
+    s.entries[key] = Preview{image, values, s.lru.begin()};
+    evict(s);
+    return image;
+}
+
+void
+SoFlMaterialPreviewCache::setMaxEntries(int entries)
+{
+    store().maxentries = entries > 0 ? entries : 1;
+    evict(store());
+}
+
+int
+SoFlMaterialPreviewCache::getNumEntries()
+{
+    return static_cast<int>(store().entries.size());
+}
+
+int
+SoFlMaterialPreviewCache::getNumRenders()
+{
+    return store().renders;
+}
+
+void
+SoFlMaterialPreviewCache::clear()
+{
+    Store & s = store();
+    for (auto & entry : s.entries) release(entry.second);
+    s.entries.clear();
+    s.lru.clear();
+}
@@ -0,0 +1,69 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLMATERIALPREVIEWCACHE_H
+#define SOFL_SOFLMATERIALPREVIEWCACHE_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <FL/Fl_RGB_Image.H>
+
+#include <cstdint>
+
+class SoMaterial;
+
+// Process-wide store of material preview images: a lit sphere per
+// material, rendered offscreen. Entries are keyed on a hash of the
+// material's values and the image size, and keep a copy of the values
+// to check hits against, so a material is only rendered again when its
+// values change, and equal materials share one image.
+// The least recently used entries are dropped past a size limit.
+class SoFlMaterialPreviewCache {
+public:
+    static uint64_t hash(const SoMaterial * material);
+
+    // Returns the size x size preview of 'material', rendering it on a
+    // miss. The image belongs to the cache; do not keep it across
+    // calls.
+    static Fl_RGB_Image * get(const SoMaterial * material, int size);
+
+    static void setMaxEntries(int entries);
+    static int getNumEntries();
+    // Number of previews rendered so far.
+    static int getNumRenders();
+    static void clear();
+};
+
+#endif //SOFL_SOFLMATERIALPREVIEWCACHE_H
@@ -41,9 +41,11 @@
 
 
 #include "SoFlThumbWheel.h"
+#include "SoFlThumbWheelCache.h"
 
 #include <Inventor/Fl/widgets/SoAnyThumbWheel.h>
 #include <Inventor/errors/SoDebugError.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
 
 #include <cassert>
 #include <FL/fl_draw.H>
@@ -98,6 +100,7 @@ SoFlThumbWheel::SoFlThumbWheel(Orientation orientation,
 
 SoFlThumbWheel::~SoFlThumbWheel()
 {
+    delete this->motionSensor;
     delete this->wheel;
     this->cleanPixmaps();
 }
@@ -105,7 +108,10 @@ SoFlThumbWheel::~SoFlThumbWheel()
 void
 SoFlThumbWheel::setOrientation(Orientation orientation)
 {
+    if (orientation == this->orient) return;
     this->orient = orientation;
+    // The frames are rendered for one orientation.
+    this->cleanPixmaps();
     this->redraw();
 }
 
@@ -121,10 +127,9 @@ SoFlThumbWheel::constructor(Orientation orientation)
     this->wheel = new SoAnyThumbWheel;
     this->wheel->setMovement(SoAnyThumbWheel::UNIFORM);
     this->wheel->setGraphicsByteOrder(SoAnyThumbWheel::RGBA);
-    this->pixmaps = nullptr;
-    this->fl_images = nullptr;
-    this->numPixmaps = 0;
+    this->frames = nullptr;
     this->currentPixmap = -1;
+    this->motionSensor = new SoOneShotSensor(SoFlThumbWheel::motionSensorCB, this);
 }
 
 /*!
@@ -157,6 +162,7 @@ SoFlThumbWheel::mousePressEvent(int event)
                            state, mouseDownPos, mouseLastPos);
 #endif
 
+    this->notify(Started);
     redraw();
 }
 
@@ -198,6 +204,14 @@ SoFlThumbWheel::mouseMoveEvent(int event)
                            this->mouseDownPos);
 #endif
     redraw();
+
+    // Drag events come in faster than a heavy scene renders; report
+    // only the latest value, once per round of sensor processing, which
+    // is where the scene redraw happens too.
+    if (!this->batchMotion)
+        this->notify(Moved);
+    else if (!this->motionSensor->isScheduled())
+        this->motionSensor->schedule();
 }
 
 /*!
@@ -215,12 +229,79 @@ SoFlThumbWheel::mouseReleaseEvent(int event)
     if (this->state != Dragging)
         return;
 
+    // Deliver the last batched motion before the interaction ends.
+    if (this->motionSensor->isScheduled()) {
+        this->motionSensor->unschedule();
+        this->notify(Moved);
+    }
+
     this->wheelValue = this->tempWheelValue;
     this->mouseLastPos = this->mouseDownPos;
     this->state = Idle;
+    this->notify(Finished);
     redraw();
 }
 
+/*!
+  \internal
+*/
+void
+SoFlThumbWheel::motionSensorCB(void *closure, SoSensor *)
+{
+    auto *thisp = static_cast<SoFlThumbWheel *>(closure);
+    if (thisp->state == Dragging)
+        thisp->notify(Moved);
+}
+
+/*!
+  \internal
+*/
+void
+SoFlThumbWheel::notify(Interaction what)
+{
+    this->lastInteraction = what;
+    this->do_callback();
+}
+
+/*!
+  Returns why the widget callback is being invoked: a drag has
+  \c Started, the wheel has \c Moved to currentValue(), or the drag has
+  \c Finished.
+*/
+SoFlThumbWheel::Interaction
+SoFlThumbWheel::interaction() const
+{
+    return this->lastInteraction;
+}
+
+/*!
+  Returns the value the wheel shows, which differs from value() while
+  the wheel is being dragged.
+*/
+float
+SoFlThumbWheel::currentValue() const
+{
+    return this->tempWheelValue;
+}
+
+/*!
+  With motion batching on (the default), drag events are coalesced and
+  the callback sees at most one \c Moved per round of Coin sensor
+  processing, carrying the latest value. Turn it off to get a callback
+  for every drag event.
+*/
+void
+SoFlThumbWheel::setMotionBatching(bool enable)
+{
+    this->batchMotion = enable;
+}
+
+bool
+SoFlThumbWheel::isMotionBatching() const
+{
+    return this->batchMotion;
+}
+
 SbVec2s
 SoFlThumbWheel::sizeHint() const
 {
@@ -266,12 +347,12 @@ SoFlThumbWheel::draw()
                                                     ? SoAnyThumbWheel::DISABLED
                                                     : SoAnyThumbWheel::ENABLED);
 
-    if (pixmap >= numPixmaps)
+    Fl_RGB_Image *image = this->frames->get(pixmap, this->wheel);
+    if (!image)
         return;
-    assert(pixmap < numPixmaps);
 
-    const auto position = this->getPosition(fl_images[pixmap]);
-    this->fl_images[pixmap]->draw(position[0], position[1]);
+    const auto position = this->getPosition(image);
+    image->draw(position[0], position[1]);
     this->currentPixmap = pixmap;
 }
 
@@ -320,55 +401,35 @@ SoFlThumbWheel::value() const
     return this->wheelValue;
 }
 
+/*!
+  \internal
+
+  Picks up the shared frames for this wheel's geometry. Frames are
+  only rendered when a value first needs them, and wheels of the same
+  size and orientation share them.
+*/
 void
 SoFlThumbWheel::initWheel(int diameter, int width)
 {
     if (diameter <= 0 || width <= 0) return;
-    int dval, w;
-    this->wheel->getSize(dval, w);
-    if (dval == diameter && w == width) return;
+    const bool vertical = (this->orient == Vertical);
+    if (this->frames &&
+        this->frames->getDiameter() == diameter &&
+        this->frames->getWidth() == width &&
+        this->frames->isVertical() == vertical) return;
 
     this->wheel->setSize(diameter, width);
 
-    int pwidth = width;
-    int pheight = diameter;
-    if (this->orient == Horizontal)
-    {
-        pwidth = diameter;
-        pheight = width;
-    }
-
     this->cleanPixmaps();
-
-    this->numPixmaps = this->wheel->getNumBitmaps();
-    this->pixmaps = new uint8_t*[this->numPixmaps];
-    this->fl_images = new Fl_RGB_Image*[this->numPixmaps];
-
-    for (int i = 0; i < this->numPixmaps; i++)
-    {
-        auto buffer = new uint8_t [pwidth * pheight *4];
-        this->wheel->drawBitmap(i,
-                                buffer,
-                                (this->orient == Vertical) ?
-                                SoAnyThumbWheel::VERTICAL : SoAnyThumbWheel::HORIZONTAL);
-        this->pixmaps[i] = buffer;
-        this->fl_images[i] = new Fl_RGB_Image(buffer, pwidth, pheight, 4);
-    }
+    this->frames = SoFlThumbWheelCache::acquire(this->wheel, vertical);
 }
 
 void
 SoFlThumbWheel::cleanPixmaps()
 {
-    for (int i = 0; i < this->numPixmaps; i++)
-    {
-        delete this->fl_images[i];
-        delete this->pixmaps[i];
-    }
-    delete [] this->fl_images;
-    delete [] this->pixmaps;
-    this->numPixmaps = 0;
-    this->fl_images = nullptr;
-    this->pixmaps = nullptr;
+    SoFlThumbWheelCache::release(this->frames);
+    this->frames = nullptr;
+    this->currentPixmap = -1;
 }
 
 void
@@ -41,6 +41,10 @@
 
 #include <Inventor/SbVec2s.h>
 
+class SoFlThumbWheelFrames;
+class SoOneShotSensor;
+class SoSensor;
+
 class SOFL_DLL_API SoFlThumbWheel : public Fl_Window {
 public:
     enum Orientation { Horizontal, Vertical };
@@ -72,6 +76,14 @@ public:
 
     SbVec2s sizeHint() const;
 
+    // What the widget callback is being invoked for.
+    enum Interaction { Started, Moved, Finished };
+    Interaction interaction() const;
+    float currentValue() const;
+
+    void setMotionBatching(bool enable);
+    bool isMotionBatching() const;
+
 private:
 
     enum State { Idle, Dragging, Disabled } state {Disabled};
@@ -80,11 +92,15 @@ private:
     float wheelValue{}, tempWheelValue{};
     int mouseDownPos{}, mouseLastPos{};
     SoAnyThumbWheel * wheel{};
-    uint8_t** pixmaps{};
-    Fl_RGB_Image** fl_images{};
-    int numPixmaps{};
+    SoFlThumbWheelFrames * frames{};
     int currentPixmap{};
     SbVec2s th_position;
+    Interaction lastInteraction{Finished};
+    bool batchMotion{true};
+    SoOneShotSensor * motionSensor{};
+
+    static void motionSensorCB(void * closure, SoSensor * sensor);
+    void notify(Interaction);
 
     void constructor(Orientation);
     void initWheel(int diameter, int width);
@@ -0,0 +1,116 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#include "Inventor/Fl/widgets/SoFlThumbWheelCache.h"
+
+#include <Inventor/Fl/widgets/SoAnyThumbWheel.h>
+
+#include <cassert>
+#include <map>
+#include <tuple>
+
+namespace {
+
+    typedef std::tuple<int, int, bool> FramesKey;
+
+    // Only touched from the FLTK thread.
+    std::map<FramesKey, SoFlThumbWheelFrames *> &entries() {
+        static std::map<FramesKey, SoFlThumbWheelFrames *> map;
+        return map;
+    }
+
+} // namespace
+
+SoFlThumbWheelFrames::SoFlThumbWheelFrames(int d, int w, bool v, int n)
+    : diameter(d),
+      width(w),
+      vertical(v),
+      refcount(0),
+      buffers(n),
+      images(n, nullptr) {
+}
+
+SoFlThumbWheelFrames::~SoFlThumbWheelFrames() {
+    for (Fl_RGB_Image *image : this->images) delete image;
+}
+
+bool
+SoFlThumbWheelFrames::isGenerated(int index) const {
+    return index >= 0 && index < this->count() && this->images[index] != nullptr;
+}
+
+Fl_RGB_Image *
+SoFlThumbWheelFrames::get(int index, SoAnyThumbWheel *renderer) {
+    if (index < 0 || index >= this->count()) return nullptr;
+    if (this->images[index]) return this->images[index];
+
+    const int pwidth = this->vertical ? this->width : this->diameter;
+    const int pheight = this->vertical ? this->diameter : this->width;
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[pwidth * pheight * 4]);
+    renderer->drawBitmap(index,
+                         buffer.get(),
+                         this->vertical ? SoAnyThumbWheel::VERTICAL : SoAnyThumbWheel::HORIZONTAL);
+    this->images[index] = new Fl_RGB_Image(buffer.get(), pwidth, pheight, 4);
+    this->buffers[index] = std::move(buffer);
+    return this->images[index];
+}
+
+SoFlThumbWheelFrames *
+SoFlThumbWheelCache::acquire(SoAnyThumbWheel *renderer, bool vertical) {
+    int diameter, width;
+    renderer->getSize(diameter, width);
+    const FramesKey key(diameter, width, vertical);
+
+    SoFlThumbWheelFrames *&frames = entries()[key];
+    if (!frames) {
+        frames = new SoFlThumbWheelFrames(diameter, width, vertical,
+                                          renderer->getNumBitmaps());
+    }
+    frames->refcount++;
+    return frames;
+}
+
+void
+SoFlThumbWheelCache::release(SoFlThumbWheelFrames *frames) {
+    if (!frames) return;
+    assert(frames->refcount > 0);
+    if (--frames->refcount > 0) return;
+
+    entries().erase(FramesKey(frames->diameter, frames->width, frames->vertical));
+    delete frames;
+}
+
+int
+SoFlThumbWheelCache::getNumEntries() {
+    return static_cast<int>(entries().size());
+}
@@ -0,0 +1,90 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#ifndef SOFL_SOFLTHUMBWHEELCACHE_H
+#define SOFL_SOFLTHUMBWHEELCACHE_H
+
+#ifndef SOFL_INTERNAL
+#error this is a private header file
+#endif /* !SOFL_INTERNAL */
+
+#include <FL/Fl_RGB_Image.H>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SoAnyThumbWheel;
+
+// The rendered frames for one wheel geometry, shared by every
+// thumbwheel of that geometry. Frames are rendered the first time they
+// are asked for.
+class SoFlThumbWheelFrames {
+public:
+    int getDiameter() const { return this->diameter; }
+    int getWidth() const { return this->width; }
+    bool isVertical() const { return this->vertical; }
+
+    int count() const { return static_cast<int>(this->images.size()); }
+    bool isGenerated(int index) const;
+
+    // 'renderer' must be set up for this geometry; it is only used if
+    // the frame has not been rendered yet.
+    Fl_RGB_Image * get(int index, SoAnyThumbWheel * renderer);
+
+private:
+    friend class SoFlThumbWheelCache;
+    SoFlThumbWheelFrames(int diameter, int width, bool vertical, int count);
+    ~SoFlThumbWheelFrames();
+
+    int diameter;
+    int width;
+    bool vertical;
+    int refcount;
+    std::vector<std::unique_ptr<uint8_t[]>> buffers;
+    std::vector<Fl_RGB_Image *> images;
+};
+
+// Process-wide, reference counted store of thumbwheel frames, keyed on
+// wheel geometry.
+class SoFlThumbWheelCache {
+public:
+    // Returns the frames for the geometry 'renderer' is set to,
+    // creating them if no other wheel holds them.
+    static SoFlThumbWheelFrames * acquire(SoAnyThumbWheel * renderer, bool vertical);
+    static void release(SoFlThumbWheelFrames * frames);
+
+    static int getNumEntries();
+};
+
+#endif //SOFL_SOFLTHUMBWHEELCACHE_H
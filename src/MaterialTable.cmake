@@ -0,0 +1,107 @@
+# Generates the material library table from the material definitions in
+# the data submodule. Run in script mode:
+#
+#   cmake -DMATERIALS_DIR=<data/materials> -DOUTPUT=<file.cpp> -P MaterialTable.cmake
+#
+# Each subdirectory of MATERIALS_DIR is a group, and each file in it an
+# Inventor file with one Material node. The values are extracted here,
+# once, and written out as constant tables, so that the library never
+# parses material files at run time.
+
+# Writes the first value of a field as a comma separated list of
+# 'count' numbers to 'result', or 'default' if the field is not there.
+# Multiple-value fields ([ ... ]) are accepted; only their first value
+# is used. A field that is there but cannot be read stops the build.
+function(material_value _file _content _field _count _default _result)
+  set(_number "[-+]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][-+]?[0-9]+)?")
+  set(_pattern "${_field}[ \t\r\n]*\\[?[ \t\r\n]*(${_number})")
+  if(_count GREATER 1)
+    foreach(_i RANGE 2 ${_count})
+      string(APPEND _pattern "[ \t\r\n,]+(${_number})")
+    endforeach()
+  endif()
+  if(NOT _content MATCHES "${_field}[ \t\r\n[]")
+    set(${_result} "${_default}" PARENT_SCOPE)
+    return()
+  endif()
+  string(REGEX MATCH "${_pattern}" _match "${_content}")
+  if(NOT _match)
+    message(FATAL_ERROR "${_file}: cannot read ${_count} number(s) for ${_field}")
+  endif()
+  string(REGEX REPLACE "^${_field}[ \t\r\n]*\\[?[ \t\r\n]*" "" _match "${_match}")
+  string(REGEX REPLACE "[ \t\r\n,]+" ", " _match "${_match}")
+  set(${_result} "${_match}" PARENT_SCOPE)
+endfunction()
+
+set(_groups "")
+set(_materials "")
+set(_numgroups 0)
+set(_nummaterials 0)
+
+if(EXISTS "${MATERIALS_DIR}")
+  file(GLOB _groupdirs LIST_DIRECTORIES true "${MATERIALS_DIR}/*")
+  list(SORT _groupdirs)
+  foreach(_groupdir ${_groupdirs})
+    if(NOT IS_DIRECTORY "${_groupdir}")
+      continue()
+    endif()
+    get_filename_component(_groupname "${_groupdir}" NAME)
+    file(GLOB _files LIST_DIRECTORIES false "${_groupdir}/*")
+    list(SORT _files)
+    set(_first ${_nummaterials})
+    foreach(_file ${_files})
+      file(READ "${_file}" _content)
+      if(NOT _content MATCHES "Material[ \t\r\n]*{")
+        continue()
+      endif()
+      get_filename_component(_name "${_file}" NAME)
+      string(REPLACE "\\" "\\\\" _name "${_name}")
+      string(REPLACE "\"" "\\\"" _name "${_name}")
+      material_value("${_file}" "${_content}" ambientColor 3 "0.2, 0.2, 0.2" _ambient)
+      material_value("${_file}" "${_content}" diffuseColor 3 "0.8, 0.8, 0.8" _diffuse)
+      material_value("${_file}" "${_content}" specularColor 3 "0, 0, 0" _specular)
+      material_value("${_file}" "${_content}" emissiveColor 3 "0, 0, 0" _emissive)
+      material_value("${_file}" "${_content}" shininess 1 "0.2" _shininess)
+      material_value("${_file}" "${_content}" transparency 1 "0" _transparency)
+      string(APPEND _materials
+        "  { \"${_name}\", { ${_ambient} }, { ${_diffuse} }, { ${_specular} }, { ${_emissive} }, ${_shininess}, ${_transparency} },\n")
+      math(EXPR _nummaterials "${_nummaterials} + 1")
+    endforeach()
+    math(EXPR _count "${_nummaterials} - ${_first}")
+    if(_count GREATER 0)
+      string(APPEND _groups "  { \"${_groupname}\", ${_first}, ${_count} },\n")
+      math(EXPR _numgroups "${_numgroups} + 1")
+    endif()
+  endforeach()
+else()
+  message(WARNING "No material definitions in ${MATERIALS_DIR}; the material library will be empty.")
+endif()
+
+# Arrays cannot be empty; the counts tell how much is real.
+if(_numgroups EQUAL 0)
+  set(_groups "  { \"\", 0, 0 },\n")
+  set(_materials "  { \"\", { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, 0, 0 },\n")
+endif()
+
+set(_source "// Generated by MaterialTable.cmake from ${MATERIALS_DIR}. Do not edit.
+
+#include \"Inventor/Fl/SoFlMaterialTable.h\"
+
+const SoFlMaterialGroupRecord SOFL_MATERIAL_GROUPS[] = {
+${_groups}};
+
+const SoFlMaterialRecord SOFL_MATERIALS[] = {
+${_materials}};
+
+const int SOFL_NUM_MATERIAL_GROUPS = ${_numgroups};
+const int SOFL_NUM_MATERIALS = ${_nummaterials};
+")
+
+# Leave the file alone when nothing changed, to spare a rebuild.
+if(EXISTS "${OUTPUT}")
+  file(READ "${OUTPUT}" _old)
+  if(_old STREQUAL _source)
+    return()
+  endif()
+endif()
+file(WRITE "${OUTPUT}" "${_source}")
@@ -50,7 +50,9 @@
 #include <Inventor/SoInput.h>
 #include <Inventor/SoPickedPoint.h>
 #include <Inventor/Fl/SoFl.h>
+#include <Inventor/Fl/SoFlPickCache.h>
 #include <Inventor/Fl/viewers/SoFlExaminerViewer.h>
+#include <Inventor/Fl/widgets/SoFlGLArea.h>
 #include <Inventor/actions/SoRayPickAction.h>
 #include <Inventor/actions/SoWriteAction.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
@@ -92,6 +94,23 @@ writePickedPath (SoNode *root,
 // CODE FOR The Inventor Mentor ENDS HERE
 ///////////////////////////////////////////////////////////////
 
+// The viewer's index of the scene. Once it is built, picks go through
+// it instead of traversing the whole scene graph.
+static SoFlPickCache *pickCache = NULL;
+
+SbBool
+writeCachedPickedPath(const SbViewportRegion &viewport,
+                      const SbVec2s &cursorPosition)
+{
+    SoPath *path = pickCache->pick(viewport, cursorPosition);
+    if (path == NULL) return FALSE;
+
+    SoWriteAction myWriteAction;
+    myWriteAction.apply(path);
+
+    return TRUE;
+}
+
 // This routine is called for every mouse button event.
 void
 myMousePressCB(void *userData, SoEventCallback *eventCB)
@@ -103,8 +122,11 @@ myMousePressCB(void *userData, SoEventCallback *eventCB)
     if (SO_MOUSE_PRESS_EVENT(event, ANY)) {
         const SbViewportRegion &myRegion =
                 eventCB->getAction()->getViewportRegion();
-        writePickedPath(root, myRegion,
-                        event->getPosition(myRegion));
+        if (pickCache != NULL && pickCache->isReady())
+            writeCachedPickedPath(myRegion, event->getPosition(myRegion));
+        else
+            writePickedPath(root, myRegion,
+                            event->getPosition(myRegion));
         eventCB->setHandled();
     }
 }
@@ -162,6 +184,10 @@ main(int, char **argv)
     myViewer->setTitle("Pick Actions & Paths");
     myViewer->show();
 
+    SoFlGLArea *myGLArea = (SoFlGLArea *) myViewer->getGLWidget();
+    if (myGLArea->setPickCache(TRUE))
+        pickCache = myGLArea->getPickCache();
+
     // Set up the event callback. We want to pass the root of the
     // entire scene graph (including the camera) as the userData,
     // so we get the scene manager's version of the scene graph
@@ -31,29 +31,22 @@
 \**************************************************************************/
 
 /*
-  This is just a simple test application to check that we can have
-  SoFlComponent derived objects within other widgets.
+  This is just a simple test application showing multiple views on a
+  scene.
 
-  It also demonstrates having multiple views on a scene from multiple
-  SoFlRenderArea instances.
-
-  Note that this example doesn't work correctly with SoFl + TGS'
-  Inventor for some reason. Looks like a TGS' Inventor bug to me. See
-  also Bugzilla #20.
-
-  mortene@sim.no
+  The three views share one SoFlMultiViewRenderArea, and with it one
+  GL context and one set of render caches, instead of being three
+  separate SoFlRenderArea instances.
 */
 
 /***********************************************************************/
 
 #include <Inventor/Fl/SoFl.h>
-#include <Inventor/Fl/SoFlRenderArea.h>
-#include <Inventor/Fl/viewers/SoFlExaminerViewer.h>
+#include <Inventor/Fl/SoFlMultiViewRenderArea.h>
 #include <Inventor/SoDB.h>
-#include <Inventor/nodes/SoCone.h>
+#include <Inventor/SoInput.h>
 #include <Inventor/nodes/SoCube.h>
 #include <Inventor/nodes/SoDirectionalLight.h>
-#include <Inventor/nodes/SoGroup.h>
 #include <Inventor/nodes/SoMaterial.h>
 #include <Inventor/nodes/SoPerspectiveCamera.h>
 #include <Inventor/nodes/SoRotation.h>
@@ -61,12 +54,9 @@
 #include <Inventor/nodes/SoSphere.h>
 #include <Inventor/nodes/SoTranslation.h>
 #include <Inventor/sensors/SoTimerSensor.h>
-#include <Inventor/actions/SoGLRenderAction.h>
-#include <FL/gbsizer.h>
-
-#include <FL/Fl.H>
 
-#include "Inventor/Fl/SoFlInternal.h"
+#include <cmath>
+#include <cstdlib>
 
 /***********************************************************************/
 
@@ -85,142 +75,92 @@ timer_callback(void * data, SoSensor * sensor)
     scenerotate->rotation.setValue(rotx * roty * rotz);
 }
 
-// Make a Fl renderarea as a child widget of viewparent, adding the
-// scene under common and a camera with the given orientation.
-void
-add_view(Fl_Window * viewparent, SoGroup * common, SbRotation cameraorientation)
+// Add a view onto the common scene with a camera of the given
+// orientation.
+static void
+add_view(SoFlMultiViewRenderArea * area, SoNode * common,
+         const SbVec2f & origin, const SbVec2f & size,
+         SbRotation cameraorientation)
 {
-    SoSeparator * root = new SoSeparator;
-
     SoPerspectiveCamera * camera = new SoPerspectiveCamera;
     camera->orientation = cameraorientation;
-    root->addChild(camera);
-
-    root->addChild(common);
-
-    std::cerr<<"-----------------------------------\n";
-    std::cerr<<dumpWindowData(viewparent)<<std::endl;
-    std::cerr<<"-----------------------------------\n";
-
-    SoFlRenderArea * area = new SoFlRenderArea(viewparent);
-    // SoFlExaminerViewer * area = new SoFlExaminerViewer(viewparent);
-    area->setSceneGraph(root);
-    std::cerr<<"-------AFTER-----------------\n";
-    std::cerr<<dumpWindowData(viewparent)<<std::endl;
-    std::cerr<<"-----------------------------------\n";
-
-#ifndef __COIN__
-    // IMPORTANT: make sure each GL context has a unique cache context
-  // id.  this is needed for TGS/SGI Inventor. Coin handles this
-  // automatically.
-  static uint32_t contextcnt = 0;
-  area->getGLRenderAction()->setCacheContext(contextcnt++);
-#endif // !__COIN__
-
-    camera->viewAll(root, area->getViewportRegion());
+    int view = area->addView(origin, size, camera);
+    camera->viewAll(common, area->getViewportRegion(view));
 }
 
 /***********************************************************************/
 
-// Define a new application type
-class MyApp : public wxApp
+int
+main(int argc, char ** argv)
 {
-public:
-
-    virtual bool OnInit()  {
-        if ( !wxApp::OnInit() )
-            return false;
-
-        // Initialize system.
-
-        Fl_Window * parent = new wxFrame(0,wxID_ANY, "");
-        SoFl::init(parent);
-
-        wxPanel* view0;
-        wxPanel* view1;
-        wxPanel* view2;
-
-        wxGridBagSizer* gbSizer2;
-        gbSizer2 = new wxGridBagSizer( 0, 0 );
-        gbSizer2->SetFlexibleDirection( wxBOTH );
-        gbSizer2->SetNonFlexibleGrowMode( wxFLEX_GROWMODE_SPECIFIED );
-
-        const int border_size = 5;
-        view0 = new wxPanel(parent);
-        gbSizer2->Add( view0, wxGBPosition( 0, 0 ), wxGBSpan( 2, 1 ), wxEXPAND | wxALL, border_size );
-
-        view1 = new wxPanel( parent);
-        wxBoxSizer* b_s = new wxBoxSizer(wxHORIZONTAL);
-        b_s->Add(view1, 1,wxALL | wxEXPAND,0);
-        gbSizer2->Add( b_s, wxGBPosition( 0, 1 ), wxGBSpan( 1, 1 ), wxEXPAND | wxALL, border_size );
-
-        view2 = new wxPanel( parent);
-        wxBoxSizer* b_s1 = new wxBoxSizer(wxHORIZONTAL);
-        b_s1->Add(view2, 1,wxALL | wxEXPAND,0);
-        gbSizer2->Add( b_s1, wxGBPosition( 1, 1 ), wxGBSpan( 1, 1 ), wxEXPAND | wxALL, border_size );
-
-        gbSizer2->AddGrowableRow(0);
-        gbSizer2->AddGrowableCol(0);
-        gbSizer2->AddGrowableCol(1);
-        gbSizer2->AddGrowableRow(1);
-
-        // Construct the common part of the scenegraph.
-
-        SoGroup * commonroot = new SoGroup;
-        SoDirectionalLight * light = new SoDirectionalLight;
-        light->direction.setValue(-0.5f, -0.5f, -0.8f);
-        commonroot->addChild(light);
-        SoRotation * scenerotate = new SoRotation;
-        commonroot->addChild(scenerotate);
-
-        if (argc == 2) {
-            SoInput in;
-            in.openFile(argv[1]);
-            SoSeparator * fileroot = SoDB::readAll(&in);
-            if (!fileroot) exit(1);
-            commonroot->addChild(fileroot);
-        }
-        else {
-            SoMaterial * mat = new SoMaterial;
-            mat->diffuseColor.setValue(1, 1, 0);
-            commonroot->addChild(mat);
-
-            SoCube * cube = new SoCube;
-            commonroot->addChild(cube);
-
-            mat = new SoMaterial;
-            mat->diffuseColor.setValue(0, 0, 1);
-            commonroot->addChild(mat);
-
-            SoTranslation * trans = new SoTranslation;
-            trans->translation.setValue(0, 0, 1);
-            commonroot->addChild(trans);
-
-            SoSphere * sphere = new SoSphere;
-            sphere->radius = 0.5;
-            commonroot->addChild(sphere);
-        }
-
-        // Add the 3 renderareas.
-        add_view(view0, commonroot, SbRotation(SbVec3f(0, 0, 1), 0));
-        add_view(view1, commonroot, SbRotation(SbVec3f(0, 1, 0), float(M_PI / 2.0)));
-        add_view(view2, commonroot, SbRotation(SbVec3f(1, 0, 0), float(-M_PI / 2.0)));
-
-        // Set up a timer callback to do a simple animation.
-
-        SoTimerSensor ts(timer_callback, scenerotate);
-        ts.setInterval(0.02f); // max 50 fps
-        ts.schedule();
-
-        // Map window and start event loop.
-        parent->SetSizer( gbSizer2 );
-        parent->Layout();
-
-        SoFl::show(parent);
-        SoFl::mainLoop();
-        exit(0);  // TODO: check error on exit!
-        return true;
+    // Initialize system.
+
+    Fl_Window * window = SoFl::init("tripleview");
+
+    // Construct the common part of the scenegraph.
+
+    SoSeparator * commonroot = new SoSeparator;
+    commonroot->ref();
+    SoDirectionalLight * light = new SoDirectionalLight;
+    light->direction.setValue(-0.5f, -0.5f, -0.8f);
+    commonroot->addChild(light);
+    SoRotation * scenerotate = new SoRotation;
+    commonroot->addChild(scenerotate);
+
+    if (argc == 2) {
+        SoInput in;
+        if (!in.openFile(argv[1])) exit(1);
+        SoSeparator * fileroot = SoDB::readAll(&in);
+        if (!fileroot) exit(1);
+        commonroot->addChild(fileroot);
     }
-};
+    else {
+        SoMaterial * mat = new SoMaterial;
+        mat->diffuseColor.setValue(1, 1, 0);
+        commonroot->addChild(mat);
 
-wxIMPLEMENT_APP(MyApp);
+        SoCube * cube = new SoCube;
+        commonroot->addChild(cube);
+
+        mat = new SoMaterial;
+        mat->diffuseColor.setValue(0, 0, 1);
+        commonroot->addChild(mat);
+
+        SoTranslation * trans = new SoTranslation;
+        trans->translation.setValue(0, 0, 1);
+        commonroot->addChild(trans);
+
+        SoSphere * sphere = new SoSphere;
+        sphere->radius = 0.5;
+        commonroot->addChild(sphere);
+    }
+
+    // One tall view on the left, two stacked on the right.
+
+    SoFlMultiViewRenderArea * area = new SoFlMultiViewRenderArea(window);
+    area->setSceneGraph(commonroot);
+    add_view(area, commonroot, SbVec2f(0.0f, 0.0f), SbVec2f(0.5f, 1.0f),
+             SbRotation(SbVec3f(0, 0, 1), 0));
+    add_view(area, commonroot, SbVec2f(0.5f, 0.5f), SbVec2f(0.5f, 0.5f),
+             SbRotation(SbVec3f(0, 1, 0), float(M_PI / 2.0)));
+    add_view(area, commonroot, SbVec2f(0.5f, 0.0f), SbVec2f(0.5f, 0.5f),
+             SbRotation(SbVec3f(1, 0, 0), float(-M_PI / 2.0)));
+    area->show();
+
+    // Set up a timer callback to do a simple animation.
+
+    SoTimerSensor ts(timer_callback, scenerotate);
+    ts.setInterval(0.02f); // max 50 fps
+    ts.schedule();
+
+    // Map window and start event loop.
+
+    SoFl::show(window);
+    SoFl::mainLoop();
+
+    ts.unschedule();
+    delete area;
+    commonroot->unref();
+    SoFl::done();
+    return 0;
+}
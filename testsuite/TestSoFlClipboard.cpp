@@ -0,0 +1,190 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFlClipboard.h>
+#include <Inventor/SoOutput.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/actions/SoWriteAction.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoMaterial.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+    struct Pasted {
+        int calls{0};
+        SoNodeList nodes;
+    };
+
+    void * growBuffer(void * buffer, size_t size)
+    {
+        return std::realloc(buffer, size);
+    }
+
+    std::string writeScene(SoNode * root, bool binary)
+    {
+        void * buffer = std::malloc(1024);
+        SoOutput out;
+        out.setBinary(binary);
+        out.setBuffer(buffer, 1024, growBuffer);
+        SoWriteAction wa(&out);
+        wa.apply(root);
+        size_t size = 0;
+        out.getBuffer(buffer, size);
+        std::string text(static_cast<const char *>(buffer), size);
+        std::free(buffer);
+        return text;
+    }
+
+    void pasteCB(void * data, SoPathList * pathlist)
+    {
+        auto pasted = static_cast<Pasted *>(data);
+        pasted->calls++;
+        for (int i = 0; i < pathlist->getLength(); i++) {
+            pasted->nodes.append((*pathlist)[i]->getTail());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlClipboard)
+
+BOOST_AUTO_TEST_CASE(test_paste_in_process) {
+    auto cube = new SoCube;
+    cube->ref();
+    cube->width.setValue(4.0f);
+
+    SoFlClipboard clipboard;
+    clipboard.copy(cube);
+    // Until the worker has published the copy, a paste is served from
+    // the graph kept at copy time, without waiting. Pastes share that
+    // graph unless they ask for a copy of their own.
+    Pasted first, second, own;
+    clipboard.paste(pasteCB, &first);
+    clipboard.paste(pasteCB, &second);
+    clipboard.paste(pasteCB, &own, true);
+
+    BOOST_REQUIRE_EQUAL(first.calls, 1);
+    BOOST_REQUIRE_EQUAL(first.nodes.getLength(), 1);
+    BOOST_REQUIRE_EQUAL(second.nodes.getLength(), 1);
+    BOOST_REQUIRE_EQUAL(own.nodes.getLength(), 1);
+    BOOST_CHECK(first.nodes[0]->isOfType(SoCube::getClassTypeId()));
+    BOOST_CHECK(first.nodes[0] != cube);
+    BOOST_CHECK(first.nodes[0] == second.nodes[0]);
+    BOOST_CHECK(own.nodes[0] != first.nodes[0]);
+    BOOST_CHECK_EQUAL(static_cast<SoCube *>(own.nodes[0])->width.getValue(), 4.0f);
+    BOOST_CHECK_EQUAL(static_cast<SoCube *>(first.nodes[0])->width.getValue(), 4.0f);
+
+    // Later edits to the source do not leak into the clipboard.
+    cube->width.setValue(1.0f);
+    Pasted third;
+    clipboard.paste(pasteCB, &third);
+    BOOST_REQUIRE_EQUAL(third.nodes.getLength(), 1);
+    BOOST_CHECK_EQUAL(static_cast<SoCube *>(third.nodes[0])->width.getValue(), 4.0f);
+    BOOST_CHECK(!clipboard.isPasting());
+
+    cube->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_copy_paths) {
+    auto root = new SoSeparator;
+    root->ref();
+    auto cube = new SoCube;
+    root->addChild(new SoSeparator);
+    root->addChild(cube);
+
+    SoPathList paths;
+    auto path = new SoPath(root);
+    path->append(cube);
+    paths.append(path);
+
+    SoFlClipboard clipboard;
+    clipboard.copy(&paths);
+    Pasted pasted;
+    clipboard.paste(pasteCB, &pasted);
+
+    BOOST_REQUIRE_EQUAL(pasted.nodes.getLength(), 1);
+    BOOST_CHECK(pasted.nodes[0]->isOfType(SoCube::getClassTypeId()));
+
+    root->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_paste_text) {
+    auto root = new SoSeparator;
+    root->ref();
+    auto material = new SoMaterial;
+    material->diffuseColor.setValue(0.2f, 0.4f, 0.6f);
+    auto cube = new SoCube;
+    cube->height.setValue(3.0f);
+    root->addChild(material);
+    root->addChild(cube);
+
+    SoFlClipboard clipboard;
+    clipboard.copy(root);
+    Pasted shared;
+    clipboard.paste(pasteCB, &shared);
+    BOOST_REQUIRE_EQUAL(shared.nodes.getLength(), 1);
+
+    // The text another application would paste: what the clipboard
+    // writes, a group of the copied roots.
+    auto group = new SoGroup;
+    group->ref();
+    group->setName("SoFlClipboard");
+    group->addChild(shared.nodes[0]);
+    const std::string text = writeScene(group, false);
+    group->unref();
+
+    Pasted pasted;
+    clipboard.pasteText(text.data(), static_cast<int>(text.size()), pasteCB, &pasted);
+    BOOST_REQUIRE_EQUAL(pasted.calls, 1);
+    BOOST_REQUIRE_EQUAL(pasted.nodes.getLength(), 1);
+    BOOST_CHECK(pasted.nodes[0] != shared.nodes[0]);
+    BOOST_CHECK(pasted.nodes[0]->isOfType(SoSeparator::getClassTypeId()));
+    BOOST_CHECK_EQUAL(writeScene(pasted.nodes[0], false), writeScene(root, false));
+    BOOST_CHECK(!clipboard.isPasting());
+
+    // Text that is not a scene pastes nothing.
+    Pasted nothing;
+    clipboard.pasteText("hello", 5, pasteCB, &nothing);
+    BOOST_CHECK_EQUAL(nothing.calls, 1);
+    BOOST_CHECK_EQUAL(nothing.nodes.getLength(), 0);
+
+    root->unref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFlMaterialLibrary.h>
+#include <Inventor/nodes/SoMaterial.h>
+
+namespace
+{
+    // The table is generated from the data submodule, which may not be
+    // checked out. Tests that need materials are skipped then.
+    boost::test_tools::assertion_result haveMaterials(boost::unit_test::test_unit_id)
+    {
+        boost::test_tools::assertion_result result(SoFlMaterialLibrary::getNumGroups() > 0);
+        result.message() << "no material definitions in data/materials";
+        return result;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlMaterialLibrary)
+
+BOOST_AUTO_TEST_CASE(test_groups_are_consistent,
+                     *boost::unit_test::precondition(haveMaterials)) {
+    for (int g = 0; g < SoFlMaterialLibrary::getNumGroups(); g++) {
+        const char * group = SoFlMaterialLibrary::getGroupName(g);
+        BOOST_REQUIRE(group != nullptr);
+        BOOST_CHECK_EQUAL(SoFlMaterialLibrary::findGroup(group), g);
+        BOOST_CHECK_GT(SoFlMaterialLibrary::getNumMaterials(g), 0);
+        for (int m = 0; m < SoFlMaterialLibrary::getNumMaterials(g); m++) {
+            const char * name = SoFlMaterialLibrary::getMaterialName(g, m);
+            BOOST_REQUIRE(name != nullptr);
+            BOOST_CHECK_EQUAL(SoFlMaterialLibrary::findMaterial(g, name), m);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_materials_are_created_on_demand,
+                     *boost::unit_test::precondition(haveMaterials)) {
+    SoMaterial * a = SoFlMaterialLibrary::createMaterial(0, 0);
+    SoMaterial * b = SoFlMaterialLibrary::createMaterial(0, 0);
+    BOOST_REQUIRE(a != nullptr);
+    BOOST_REQUIRE(b != nullptr);
+    a->ref();
+    b->ref();
+
+    BOOST_CHECK(a != b);
+    BOOST_CHECK(a->diffuseColor[0] == b->diffuseColor[0]);
+    BOOST_CHECK_EQUAL(a->shininess[0], b->shininess[0]);
+    BOOST_CHECK_EQUAL(a->transparency[0], b->transparency[0]);
+
+    a->unref();
+    b->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_indices) {
+    const int groups = SoFlMaterialLibrary::getNumGroups();
+    BOOST_CHECK(SoFlMaterialLibrary::getGroupName(-1) == nullptr);
+    BOOST_CHECK(SoFlMaterialLibrary::getGroupName(groups) == nullptr);
+    BOOST_CHECK_EQUAL(SoFlMaterialLibrary::getNumMaterials(groups), 0);
+    BOOST_CHECK(SoFlMaterialLibrary::createMaterial(groups, 0) == nullptr);
+    BOOST_CHECK_EQUAL(SoFlMaterialLibrary::findGroup("no such group"), -1);
+
+    auto node = new SoMaterial;
+    node->ref();
+    node->shininess.setValue(0.5f);
+    BOOST_CHECK(!SoFlMaterialLibrary::getMaterial(groups, 0, node));
+    BOOST_CHECK_EQUAL(node->shininess[0], 0.5f);
+    node->unref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFlPickCache.h>
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoSwitch.h>
+#include <Inventor/nodes/SoTranslation.h>
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <FL/Fl.H>
+
+namespace
+{
+    // A camera looking down -z at two 2x2x2 cubes, at x=0 and x=5.
+    struct Scene {
+        SoSeparator * root;
+        SoCube * near;
+        SoCube * far;
+        SoTranslation * move;
+
+        Scene()
+        {
+            root = new SoSeparator;
+            root->ref();
+            auto camera = new SoOrthographicCamera;
+            camera->position.setValue(0.0f, 0.0f, 10.0f);
+            camera->height.setValue(10.0f);
+            root->addChild(camera);
+            near = new SoCube;
+            root->addChild(near);
+            auto group = new SoSeparator;
+            move = new SoTranslation;
+            move->translation.setValue(5.0f, 0.0f, 0.0f);
+            far = new SoCube;
+            group->addChild(move);
+            group->addChild(far);
+            root->addChild(group);
+        }
+        ~Scene() { root->unref(); }
+    };
+
+    // Runs the delay queue and the FLTK loop until the worker is done.
+    bool waitUntilReady(SoFlPickCache & cache)
+    {
+        for (int i = 0; i < 100 && !cache.isReady(); i++) {
+            SoDB::getSensorManager()->processDelayQueue(TRUE);
+            Fl::wait(0.05);
+        }
+        return cache.isReady();
+    }
+
+    SoNode * pickAt(const SoFlPickCache & cache, float x, float y, SbVec3f * point = nullptr)
+    {
+        SoPath * path = cache.pick(SbLine(SbVec3f(x, y, 10.0f), SbVec3f(x, y, 0.0f)), point);
+        return path ? path->getTail() : nullptr;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlPickCache)
+
+BOOST_AUTO_TEST_CASE(test_ray_pick) {
+    Scene scene;
+    SoFlPickCache cache;
+    BOOST_CHECK(!cache.isReady());
+    cache.setSceneGraph(scene.root);
+    BOOST_REQUIRE(waitUntilReady(cache));
+
+    SbVec3f point;
+    BOOST_CHECK_EQUAL(pickAt(cache, 0.0f, 0.0f, &point), scene.near);
+    BOOST_CHECK_CLOSE(point[2], 1.0f, 0.01f);
+    BOOST_CHECK_EQUAL(pickAt(cache, 5.5f, 0.5f), scene.far);
+    BOOST_CHECK(pickAt(cache, 2.5f, 0.0f) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_refit_and_rebuild) {
+    Scene scene;
+    SoFlPickCache cache;
+    cache.setSceneGraph(scene.root);
+    BOOST_REQUIRE(waitUntilReady(cache));
+
+    // Moving geometry refits in place; picks miss until it has.
+    scene.move->translation.setValue(10.0f, 0.0f, 0.0f);
+    BOOST_CHECK(!cache.isReady());
+    SoDB::getSensorManager()->processDelayQueue(TRUE);
+    BOOST_CHECK(cache.isReady());
+    BOOST_CHECK(pickAt(cache, 5.0f, 0.0f) == nullptr);
+    BOOST_CHECK_EQUAL(pickAt(cache, 10.0f, 0.0f), scene.far);
+
+    // New shapes take a rebuild.
+    auto extra = new SoCube;
+    auto group = new SoSeparator;
+    auto move = new SoTranslation;
+    move->translation.setValue(0.0f, -5.0f, 0.0f);
+    group->addChild(move);
+    group->addChild(extra);
+    scene.root->addChild(group);
+    BOOST_CHECK(!cache.isReady());
+    BOOST_REQUIRE(waitUntilReady(cache));
+    BOOST_CHECK_EQUAL(pickAt(cache, 0.0f, -5.0f), extra);
+}
+
+BOOST_AUTO_TEST_CASE(test_switch_rebuilds) {
+    Scene scene;
+    // Two cubes, with as many triangles, of which one is shown.
+    auto group = new SoSeparator;
+    auto choice = new SoSwitch;
+    auto above = new SoCube;
+    auto below = new SoSeparator;
+    auto down = new SoTranslation;
+    auto other = new SoCube;
+    down->translation.setValue(0.0f, -5.0f, 0.0f);
+    below->addChild(down);
+    below->addChild(other);
+    choice->addChild(above);
+    choice->addChild(below);
+    choice->whichChild.setValue(0);
+    group->addChild(choice);
+    scene.root->addChild(group);
+
+    SoFlPickCache cache;
+    cache.setSceneGraph(scene.root);
+    BOOST_REQUIRE(waitUntilReady(cache));
+    BOOST_CHECK(pickAt(cache, 0.0f, -5.0f) == nullptr);
+
+    // Another shape with the same triangle count is not a refit.
+    choice->whichChild.setValue(1);
+    BOOST_REQUIRE(waitUntilReady(cache));
+    BOOST_CHECK_EQUAL(pickAt(cache, 0.0f, -5.0f), other);
+}
+
+BOOST_AUTO_TEST_CASE(test_screen_picks) {
+    Scene scene;
+    SoFlPickCache cache;
+    cache.setSceneGraph(scene.root);
+    BOOST_REQUIRE(waitUntilReady(cache));
+
+    // The camera sees x and y from -5 to 5 over 100 pixels.
+    const SbViewportRegion viewport(100, 100);
+    SoPath * path = cache.pick(viewport, SbVec2s(50, 50));
+    BOOST_REQUIRE(path != nullptr);
+    BOOST_CHECK_EQUAL(path->getTail(), scene.near);
+    BOOST_CHECK(cache.pick(viewport, SbVec2s(75, 50)) == nullptr);
+
+    SoPathList all;
+    BOOST_CHECK_EQUAL(cache.pick(viewport, SbBox2s(0, 0, 99, 99), all), 2);
+    SoPathList left;
+    BOOST_CHECK_EQUAL(cache.pick(viewport, SbBox2s(0, 0, 49, 99), left), 1);
+    BOOST_REQUIRE_EQUAL(left.getLength(), 1);
+    BOOST_CHECK_EQUAL(left[0]->getTail(), scene.near);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFlTransformSliderSet.h>
+#include <Inventor/nodes/SoTransform.h>
+#include <Inventor/sensors/SoNodeSensor.h>
+
+namespace
+{
+    void countCB(void * data, SoSensor *)
+    {
+        ++*static_cast<int *>(data);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlSliderSet)
+
+BOOST_AUTO_TEST_CASE(test_edits_coalesce_per_node) {
+    auto a = new SoTransform;
+    auto b = new SoTransform;
+    a->ref();
+    b->ref();
+
+    int notifications = 0;
+    SoNodeSensor sa(countCB, &notifications);
+    SoNodeSensor sb(countCB, &notifications);
+    sa.setPriority(0);
+    sb.setPriority(0);
+    sa.attach(a);
+    sb.attach(b);
+
+    SoNodeList selection;
+    selection.append(a);
+    selection.append(b);
+
+    {
+        SoFlTransformSliderSet sliders;
+        sliders.setNodes(selection);
+        for (int i = 1; i <= 100; i++) {
+            sliders.setTranslation(SbVec3f(static_cast<float>(i), 0, 0));
+            sliders.setScaleFactor(SbVec3f(2, 2, 2));
+        }
+        BOOST_CHECK(sliders.hasPendingEdits());
+        BOOST_CHECK_EQUAL(notifications, 0);
+        BOOST_CHECK_EQUAL(a->translation.getValue()[0], 0.0f);
+
+        sliders.flush();
+        BOOST_CHECK(!sliders.hasPendingEdits());
+        BOOST_CHECK_EQUAL(notifications, 2);
+        BOOST_CHECK_EQUAL(a->translation.getValue()[0], 100.0f);
+        BOOST_CHECK_EQUAL(b->translation.getValue()[0], 100.0f);
+        BOOST_CHECK_EQUAL(b->scaleFactor.getValue()[1], 2.0f);
+
+        // Writing what is already there notifies nobody.
+        sliders.setScaleFactor(SbVec3f(2, 2, 2));
+        sliders.flush();
+        BOOST_CHECK_EQUAL(notifications, 2);
+    }
+
+    sa.detach();
+    sb.detach();
+    a->unref();
+    b->unref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+#define BOOST_TEST_NO_LIB 1
+#include <boost/test/unit_test.hpp>
+#include "Inventor/Fl/devices/SoFlEventClock.h"
+
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(TestSoFlEventClock);
+
+BOOST_AUTO_TEST_CASE(monotonic) {
+    SbTime last = SoFlEventClock::now();
+    for (int i = 0; i < 100000; i++) {
+        const SbTime t = SoFlEventClock::now();
+        BOOST_REQUIRE(t >= last);
+        last = t;
+    }
+    // Anchored to the wall clock, give or take a second.
+    const double diff = SoFlEventClock::now().getValue() - SbTime::getTimeOfDay().getValue();
+    BOOST_CHECK(diff < 1.0 && diff > -1.0);
+}
+
+BOOST_AUTO_TEST_CASE(stampedOnDispatch) {
+    SbTime outer, inner;
+    {
+        SoFlEventClock::Dispatch dispatch;
+        outer = SoFlEventClock::eventTime();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        BOOST_CHECK(SoFlEventClock::eventTime() == outer);
+        {
+            SoFlEventClock::Dispatch nested;
+            inner = SoFlEventClock::eventTime();
+            BOOST_CHECK(inner > outer);
+        }
+        BOOST_CHECK(SoFlEventClock::eventTime() == outer);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    BOOST_CHECK(SoFlEventClock::eventTime() > inner);
+}
+
+BOOST_AUTO_TEST_CASE(windowSystemTime) {
+    const SbTime first = SoFlEventClock::fromWindowSystem(5000);
+    BOOST_CHECK((SoFlEventClock::now() - first).getValue() < 0.1);
+
+    // Events read late keep the interval between them.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const SbTime second = SoFlEventClock::fromWindowSystem(5010);
+    BOOST_CHECK_CLOSE((second - first).getValue(), 0.010, 0.1);
+    BOOST_CHECK(second <= SoFlEventClock::now());
+
+    // Across the 32 bit wrap.
+    const SbTime before = SoFlEventClock::fromWindowSystem(0xfffffff0ul);
+    const SbTime after = SoFlEventClock::fromWindowSystem(0x10ul);
+    BOOST_CHECK_CLOSE((after - before).getValue(), 0.032, 0.1);
+
+    // A restarted server clock is picked up again.
+    const SbTime restarted = SoFlEventClock::fromWindowSystem(0x10ul + 3600000ul);
+    BOOST_CHECK((SoFlEventClock::now() - restarted).getValue() < 0.1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
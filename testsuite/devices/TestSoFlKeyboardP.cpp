@@ -32,22 +32,93 @@
 
 #define BOOST_TEST_NO_LIB 1
 #include <boost/test/unit_test.hpp>
+#include "Inventor/Fl/devices/SoFlKeyboard.h"
 #include "Inventor/Fl/devices/SoFlKeyboardP.h"
 
+#include <Inventor/events/SoKeyboardEvent.h>
+
+#include <FL/Enumerations.H>
+#include <FL/Fl.H>
+
+#include <chrono>
+
 BOOST_AUTO_TEST_SUITE(TestSoFlKeyboardP);
 
-static int counter = 0;
-void myData(SbDictKeyType key, void * value) {
-    ++counter ;
-    // std::clog<<"code::"<<(wxKeyCode)(key)<<std::endl;
+BOOST_AUTO_TEST_CASE(keyMapTest) {
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup('a').key, SoKeyboardEvent::A);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup('a').printable, 'a');
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup('z').key, SoKeyboardEvent::Z);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup('5').key, SoKeyboardEvent::NUMBER_5);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(' ').key, SoKeyboardEvent::SPACE);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Escape).key, SoKeyboardEvent::ESCAPE);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Enter).key, SoKeyboardEvent::RETURN);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_KP_Enter).key, SoKeyboardEvent::PAD_ENTER);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Page_Up).key, SoKeyboardEvent::PAGE_UP);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Shift_R).key, SoKeyboardEvent::RIGHT_SHIFT);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Delete).key, SoKeyboardEvent::KEY_DELETE);
+
+    for (int i = 1; i <= 12; i++) {
+        BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_F + i).key, SoKeyboardEvent::F1 + i - 1);
+    }
+    for (int i = 0; i <= 9; i++) {
+        BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_KP + '0' + i).key, SoKeyboardEvent::PAD_0 + i);
+        BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_KP + '0' + i).printable, '0' + i);
+    }
 }
 
-BOOST_AUTO_TEST_CASE(keyMapTest) {
-    BOOST_CHECK_EQUAL(0,counter);
-    SoFlKeyboardP::make_translation_table();
-    SoFlKeyboardP::translatetable->applyToAll(myData);
-    BOOST_CHECK(counter>0);
+BOOST_AUTO_TEST_CASE(unmappedKeys) {
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(0).key, SoKeyboardEvent::ANY);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(-1).key, SoKeyboardEvent::ANY);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(FL_Button + 1).key, SoKeyboardEvent::ANY);
+    BOOST_CHECK_EQUAL(SoFlKeyboardP::lookup(0x10000).key, SoKeyboardEvent::ANY);
+}
+
+BOOST_AUTO_TEST_CASE(lookupBenchmark) {
+    const int keys[] = {'w', 'a', 's', 'd', FL_Up, FL_Down, FL_Left, FL_Right,
+                        FL_Shift_L, FL_Control_L, FL_KP + '8', FL_F + 5};
+    const int numkeys = sizeof(keys) / sizeof(keys[0]);
+    const int iterations = 10000000;
+
+    unsigned long sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sum += SoFlKeyboardP::lookup(keys[i % numkeys]).key;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+
+    // Reported rather than checked; timings vary too much between
+    // builds and machines to fail a test on.
+    BOOST_TEST_MESSAGE("SoFlKeyboardP::lookup: " << ns << " ns per key");
+    BOOST_CHECK(sum > 0);
+}
+
+BOOST_AUTO_TEST_CASE(pressReleasePair) {
+    SoFlKeyboard keyboard;
+    char text[] = "a";
+    Fl::e_keysym = 'a';
+    Fl::e_state = 0;
+    Fl::e_text = text;
+    Fl::e_length = 1;
+
+    const SoEvent * press = keyboard.translateEvent(FL_KEYDOWN);
+    BOOST_REQUIRE(press != nullptr);
+    BOOST_REQUIRE(press->isOfType(SoKeyboardEvent::getClassTypeId()));
+    BOOST_CHECK(SO_KEY_PRESS_EVENT(press, A));
+    BOOST_CHECK_EQUAL(static_cast<const SoKeyboardEvent *>(press)->getPrintableCharacter(), 'a');
+
+    // FLTK sends no text with a release.
+    Fl::e_length = 0;
+    const SoEvent * release = keyboard.translateEvent(FL_KEYUP);
+    BOOST_REQUIRE(release != nullptr);
+    BOOST_CHECK(SO_KEY_RELEASE_EVENT(release, A));
+    BOOST_CHECK(!SO_KEY_PRESS_EVENT(release, A));
 
+    // Keys outside the table give nothing, pressed or released.
+    Fl::e_keysym = FL_Button + 1;
+    BOOST_CHECK(keyboard.translateEvent(FL_KEYDOWN) == nullptr);
+    BOOST_CHECK(keyboard.translateEvent(FL_KEYUP) == nullptr);
+    Fl::e_text = nullptr;
 }
 
 BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,279 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+#define BOOST_TEST_NO_LIB 1
+#include <boost/test/unit_test.hpp>
+#include "Inventor/Fl/devices/SoFlLinuxJoystick.h"
+
+#include <Inventor/SbTime.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/events/SoMotion3Event.h>
+#include <Inventor/events/SoSpaceballButtonEvent.h>
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <FL/Fl.H>
+
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // A js* device directory with FIFOs for joysticks, written to by
+    // the test as the driver would.
+    class FakeJoystickDir {
+    public:
+        FakeJoystickDir()
+        {
+            char dir[] = "/tmp/sofljsXXXXXX";
+            if (mkdtemp(dir)) this->dir = dir;
+        }
+
+        ~FakeJoystickDir()
+        {
+            this->unplug();
+            for (const std::string & path : this->paths) unlink(path.c_str());
+            rmdir(this->dir.c_str());
+        }
+
+        std::string plug(const char * name)
+        {
+            const std::string path = this->dir + "/" + name;
+            mkfifo(path.c_str(), 0600);
+            this->paths.push_back(path);
+            return path;
+        }
+
+        // Only once the device has the FIFO open for reading.
+        bool connect(const std::string & path)
+        {
+            this->writer = open(path.c_str(), O_WRONLY | O_NONBLOCK);
+            return this->writer >= 0;
+        }
+
+        void send(unsigned char type, unsigned char number, short value)
+        {
+            js_event event;
+            event.time = 0;
+            event.type = type;
+            event.number = number;
+            event.value = value;
+            BOOST_REQUIRE_EQUAL(write(this->writer, &event, sizeof(event)), ssize_t(sizeof(event)));
+        }
+
+        void unplug()
+        {
+            if (this->writer >= 0) close(this->writer);
+            this->writer = -1;
+        }
+
+        std::string dir;
+        std::vector<std::string> paths;
+        int writer{-1};
+    };
+
+    struct Received {
+        SoFlLinuxJoystick * device;
+        std::vector<SbVec3f> motions;
+        std::vector<int> buttons; // positive when pressed, negative when released
+        std::vector<char> order;
+    };
+
+    void handler(Fl_Window *, void * closure, int event, bool *)
+    {
+        auto received = static_cast<Received *>(closure);
+        const SoEvent * ev = received->device->translateEvent(event);
+        BOOST_REQUIRE(ev != nullptr);
+        if (ev->isOfType(SoMotion3Event::getClassTypeId())) {
+            received->motions.push_back(static_cast<const SoMotion3Event *>(ev)->getTranslation());
+            received->order.push_back('m');
+        }
+        else if (ev->isOfType(SoSpaceballButtonEvent::getClassTypeId())) {
+            auto button = static_cast<const SoSpaceballButtonEvent *>(ev);
+            const int n = button->getButton() - SoSpaceballButtonEvent::BUTTON1 + 1;
+            received->buttons.push_back(button->getState() == SoButtonEvent::DOWN ? n : -n);
+            received->order.push_back('b');
+        }
+    }
+
+    void processSensors()
+    {
+        SoDB::getSensorManager()->processDelayQueue(TRUE);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlLinuxJoystick);
+
+BOOST_AUTO_TEST_CASE(axesAreCoalescedPerFrame) {
+    FakeJoystickDir input;
+    const std::string path = input.plug("js0");
+    SoFlLinuxJoystick device(input.dir.c_str());
+    // The first motion event counts as a sixtieth of a second.
+    device.setTranslationScaleFactor(60.0f);
+    Received received;
+    received.device = &device;
+
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(device.isOpen());
+    BOOST_CHECK_EQUAL(device.getDevicePath().getString(), path);
+    BOOST_REQUIRE(input.connect(path));
+
+    // Initial state is taken in silently.
+    input.send(JS_EVENT_AXIS | JS_EVENT_INIT, 0, 0);
+    input.send(JS_EVENT_AXIS | JS_EVENT_INIT, 1, 0);
+    BOOST_CHECK(device.processInput());
+    processSensors();
+    BOOST_CHECK(received.motions.empty());
+    BOOST_CHECK_EQUAL(device.getNumAxes(), 2);
+
+    input.send(JS_EVENT_AXIS, 0, 8000);
+    input.send(JS_EVENT_AXIS, 0, 20000);
+    input.send(JS_EVENT_AXIS, 0, 32767);
+    input.send(JS_EVENT_AXIS, 1, -32767);
+    BOOST_CHECK(device.processInput());
+    BOOST_CHECK(received.motions.empty());
+
+    processSensors();
+    BOOST_REQUIRE_EQUAL(received.motions.size(), 1u);
+    BOOST_CHECK_CLOSE(received.motions[0][0], 1.0f, 0.01);
+    BOOST_CHECK_CLOSE(received.motions[0][1], 1.0f, 0.01);
+
+    device.disable(nullptr, handler, &received);
+    BOOST_CHECK(!device.isOpen());
+}
+
+BOOST_AUTO_TEST_CASE(heldStickKeepsMoving) {
+    FakeJoystickDir input;
+    const std::string path = input.plug("js0");
+    SoFlLinuxJoystick device(input.dir.c_str());
+    device.setTranslationScaleFactor(1.0f);
+    Received received;
+    received.device = &device;
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(input.connect(path));
+
+    // One axis event, then the stick is held still.
+    input.send(JS_EVENT_AXIS, 0, 32767);
+    device.processInput();
+    processSensors();
+    BOOST_REQUIRE_EQUAL(received.motions.size(), 1u);
+
+    const SbTime start = SbTime::getTimeOfDay();
+    while ((SbTime::getTimeOfDay() - start).getValue() < 0.3) Fl::wait(0.05);
+    BOOST_REQUIRE_GT(received.motions.size(), 3u);
+
+    // Each event moves by the time it covers, so together they add up
+    // to about the time held, whatever the frame rate.
+    float total = 0.0f;
+    for (const SbVec3f & motion : received.motions) {
+        BOOST_CHECK_GT(motion[0], 0.0f);
+        total += motion[0];
+    }
+    const float held = float((SbTime::getTimeOfDay() - start).getValue());
+    BOOST_CHECK_GT(total, 0.5f * held);
+    BOOST_CHECK_LT(total, 1.5f * held + 0.1f);
+
+    // Letting go stops the motion with one last, still event.
+    input.send(JS_EVENT_AXIS, 0, 0);
+    device.processInput();
+    processSensors();
+    const size_t count = received.motions.size();
+    BOOST_CHECK_EQUAL(received.motions.back()[0], 0.0f);
+    for (int i = 0; i < 4; i++) Fl::wait(0.05);
+    BOOST_CHECK_EQUAL(received.motions.size(), count);
+}
+
+BOOST_AUTO_TEST_CASE(deadZoneAndAxisScale) {
+    FakeJoystickDir input;
+    const std::string path = input.plug("js0");
+    SoFlLinuxJoystick device(input.dir.c_str());
+    device.setDeadZone(0.5f);
+    device.setAxisScale(1, -2.0f);
+    BOOST_REQUIRE(device.rescan());
+    BOOST_REQUIRE(input.connect(path));
+
+    input.send(JS_EVENT_AXIS, 0, 32767 / 4);
+    input.send(JS_EVENT_AXIS, 1, 32767 / 4 * 3);
+    device.processInput();
+
+    BOOST_CHECK_EQUAL(device.getAxisValue(0), 0.0f);
+    BOOST_CHECK_CLOSE(device.getAxisValue(1), -1.0f, 0.1);
+    BOOST_CHECK_EQUAL(device.getAxisValue(7), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(buttonsFollowPendingMotion) {
+    FakeJoystickDir input;
+    const std::string path = input.plug("js0");
+    SoFlLinuxJoystick device(input.dir.c_str());
+    Received received;
+    received.device = &device;
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(input.connect(path));
+
+    input.send(JS_EVENT_AXIS, 2, 20000);
+    input.send(JS_EVENT_BUTTON, 0, 1);
+    input.send(JS_EVENT_BUTTON, 0, 0);
+    input.send(JS_EVENT_BUTTON, 5, 1);
+    device.processInput();
+    processSensors();
+
+    BOOST_REQUIRE_EQUAL(received.order.size(), 4u);
+    BOOST_CHECK_EQUAL(received.order[0], 'm');
+    BOOST_REQUIRE_EQUAL(received.buttons.size(), 3u);
+    BOOST_CHECK_EQUAL(received.buttons[0], 1);
+    BOOST_CHECK_EQUAL(received.buttons[1], -1);
+    BOOST_CHECK_EQUAL(received.buttons[2], 6);
+    BOOST_CHECK(device.getButtonValue(5));
+}
+
+BOOST_AUTO_TEST_CASE(hotplug) {
+    FakeJoystickDir input;
+    SoFlLinuxJoystick device(input.dir.c_str());
+    Received received;
+    received.device = &device;
+    device.enable(nullptr, handler, &received);
+    BOOST_CHECK(!device.isOpen());
+
+    const std::string path = input.plug("js3");
+    for (int i = 0; i < 20 && !device.isOpen(); i++) Fl::wait(0.05);
+    BOOST_REQUIRE(device.isOpen());
+    BOOST_REQUIRE(input.connect(path));
+
+    input.unplug();
+    BOOST_CHECK(!device.processInput());
+    BOOST_CHECK(!device.isOpen());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,162 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+#define BOOST_TEST_NO_LIB 1
+#include <boost/test/unit_test.hpp>
+#include "Inventor/Fl/devices/SoFlMouse.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/events/SoMouseButtonEvent.h>
+#ifdef HAVE_SOMOUSEWHEELEVENT
+#include <Inventor/events/SoMouseWheelEvent.h>
+#endif
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <FL/Fl.H>
+
+#include <cstdlib>
+
+namespace
+{
+    // What reaches the handler, as wheel events or, with a Coin that has
+    // none, as presses and releases of buttons 4 and 5.
+    struct Received {
+        explicit Received(SoFlMouse * m) : mouse(m) {}
+        SoFlMouse * mouse;
+        int events{0};
+        int steps{0}; // positive towards the user, or to the right
+        int shifted{0};
+        bool pressed{false};
+    };
+
+    void handler(Fl_Window *, void * closure, int event, bool *)
+    {
+        auto received = static_cast<Received *>(closure);
+        const SoEvent * ev = received->mouse->translateEvent(event);
+        BOOST_REQUIRE(ev != nullptr);
+        received->events++;
+        if (ev->wasShiftDown()) received->shifted++;
+#ifdef HAVE_SOMOUSEWHEELEVENT
+        BOOST_REQUIRE(ev->isOfType(SoMouseWheelEvent::getClassTypeId()));
+        received->steps -= static_cast<const SoMouseWheelEvent *>(ev)->getDelta() / 120;
+#else
+        BOOST_REQUIRE(ev->isOfType(SoMouseButtonEvent::getClassTypeId()));
+        auto button = static_cast<const SoMouseButtonEvent *>(ev);
+        // Every press is followed by its release.
+        if (button->getState() == SoButtonEvent::DOWN) {
+            BOOST_CHECK(!received->pressed);
+            received->steps += button->getButton() == SoMouseButtonEvent::BUTTON5 ? 1 : -1;
+        }
+        received->pressed = button->getState() == SoButtonEvent::DOWN;
+#endif
+    }
+
+    void wheel(SoFlMouse & mouse, int dy, int dx = 0)
+    {
+        Fl::e_dx = dx;
+        Fl::e_dy = dy;
+        BOOST_CHECK(mouse.translateEvent(FL_MOUSEWHEEL) == nullptr);
+    }
+
+    void processSensors()
+    {
+        SoDB::getSensorManager()->processDelayQueue(TRUE);
+    }
+
+    // How many events 'steps' steps on one axis come out as.
+    int eventsFor(int steps)
+    {
+#ifdef HAVE_SOMOUSEWHEELEVENT
+        return steps != 0 ? 1 : 0;
+#else
+        return 2 * std::abs(steps);
+#endif
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlMouse);
+
+BOOST_AUTO_TEST_CASE(wheelStepsAreCoalescedPerFrame) {
+    SoFlMouse mouse;
+    Received received(&mouse);
+    mouse.enable(nullptr, handler, &received);
+
+    // Three notches in one frame come out together.
+    wheel(mouse, 1);
+    wheel(mouse, 1);
+    wheel(mouse, 1);
+    BOOST_CHECK_EQUAL(received.events, 0);
+    processSensors();
+    BOOST_CHECK_EQUAL(received.steps, 3);
+    BOOST_CHECK_EQUAL(received.events, eventsFor(3));
+
+    // Steps both ways in one frame cancel out.
+    received = Received(&mouse);
+    wheel(mouse, -2);
+    wheel(mouse, 1);
+    wheel(mouse, 1);
+    processSensors();
+    BOOST_CHECK_EQUAL(received.events, 0);
+
+    received = Received(&mouse);
+    wheel(mouse, -3);
+    wheel(mouse, 1);
+    processSensors();
+    BOOST_CHECK_EQUAL(received.steps, -2);
+    BOOST_CHECK_EQUAL(received.events, eventsFor(-2));
+    BOOST_CHECK_EQUAL(received.shifted, 0);
+
+    mouse.disable(nullptr, handler, &received);
+}
+
+BOOST_AUTO_TEST_CASE(horizontalWheelComesWithShift) {
+    SoFlMouse mouse;
+    Received received(&mouse);
+    mouse.enable(nullptr, handler, &received);
+
+    wheel(mouse, 0, 2);
+    wheel(mouse, 0, 1);
+    processSensors();
+    BOOST_CHECK_EQUAL(received.steps, 3);
+    BOOST_CHECK_EQUAL(received.events, eventsFor(3));
+    BOOST_CHECK_EQUAL(received.shifted, received.events);
+
+    // Both axes in one frame are handed on one after the other.
+    received = Received(&mouse);
+    wheel(mouse, 1, -1);
+    processSensors();
+    BOOST_CHECK_EQUAL(received.events, eventsFor(1) + eventsFor(-1));
+    BOOST_CHECK_EQUAL(received.shifted, eventsFor(-1));
+
+    mouse.disable(nullptr, handler, &received);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
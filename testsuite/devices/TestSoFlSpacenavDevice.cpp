@@ -0,0 +1,241 @@
+/**************************************************************************\
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+#define BOOST_TEST_NO_LIB 1
+#include <boost/test/unit_test.hpp>
+#include "Inventor/Fl/devices/SoFlSpacenavDevice.h"
+
+#include <Inventor/SoDB.h>
+#include <Inventor/events/SoMotion3Event.h>
+#include <Inventor/events/SoSpaceballButtonEvent.h>
+#include <Inventor/sensors/SoSensorManager.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Just enough of spacenavd: listens on a socket in a temporary
+    // directory and sends raw packets to the one client.
+    class FakeSpacenavd {
+    public:
+        FakeSpacenavd()
+        {
+            char dir[] = "/tmp/soflspnavXXXXXX";
+            if (!mkdtemp(dir)) return;
+            this->dir = dir;
+            this->path = this->dir + "/spnav.sock";
+
+            sockaddr_un addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            std::strcpy(addr.sun_path, this->path.c_str());
+            this->listener = socket(AF_UNIX, SOCK_STREAM, 0);
+            bind(this->listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            listen(this->listener, 1);
+        }
+
+        ~FakeSpacenavd()
+        {
+            this->hangup();
+            if (this->listener >= 0) close(this->listener);
+            unlink(this->path.c_str());
+            rmdir(this->dir.c_str());
+        }
+
+        bool accept()
+        {
+            this->client = ::accept(this->listener, nullptr, nullptr);
+            return this->client >= 0;
+        }
+
+        void send(int32_t type, int32_t a, int32_t b = 0, int32_t c = 0,
+                  int32_t d = 0, int32_t e = 0, int32_t f = 0, int32_t period = 0)
+        {
+            const int32_t packet[8] = {type, a, b, c, d, e, f, period};
+            this->sendBytes(reinterpret_cast<const char *>(packet), sizeof(packet));
+        }
+
+        void sendBytes(const char * data, size_t size)
+        {
+            BOOST_REQUIRE_EQUAL(write(this->client, data, size), static_cast<ssize_t>(size));
+        }
+
+        void hangup()
+        {
+            if (this->client >= 0) close(this->client);
+            this->client = -1;
+        }
+
+        std::string dir;
+        std::string path;
+        int listener{-1};
+        int client{-1};
+    };
+
+    struct Received {
+        SoFlSpacenavDevice * device;
+        std::vector<SbVec3f> motions;
+        std::vector<int> buttons; // positive when pressed, negative when released
+        std::vector<char> order;
+    };
+
+    void handler(Fl_Window *, void * closure, int event, bool *)
+    {
+        auto received = static_cast<Received *>(closure);
+        const SoEvent * ev = received->device->translateEvent(event);
+        BOOST_REQUIRE(ev != nullptr);
+        if (ev->isOfType(SoMotion3Event::getClassTypeId())) {
+            received->motions.push_back(static_cast<const SoMotion3Event *>(ev)->getTranslation());
+            received->order.push_back('m');
+        }
+        else if (ev->isOfType(SoSpaceballButtonEvent::getClassTypeId())) {
+            auto button = static_cast<const SoSpaceballButtonEvent *>(ev);
+            const int n = button->getButton() - SoSpaceballButtonEvent::BUTTON1 + 1;
+            received->buttons.push_back(button->getState() == SoButtonEvent::DOWN ? n : -n);
+            received->order.push_back('b');
+        }
+    }
+
+    void processSensors()
+    {
+        SoDB::getSensorManager()->processDelayQueue(TRUE);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlSpacenavDevice);
+
+BOOST_AUTO_TEST_CASE(motionIsCoalescedPerFrame) {
+    FakeSpacenavd server;
+    SoFlSpacenavDevice device(server.path.c_str());
+    device.setTranslationScaleFactor(1.0f);
+    Received received;
+    received.device = &device;
+
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(device.isConnected());
+    BOOST_REQUIRE(server.accept());
+
+    for (int i = 0; i < 5; i++) server.send(0, 100, 0, -50, 0, 0, 0, 10);
+    BOOST_CHECK(device.processInput());
+    BOOST_CHECK(received.motions.empty());
+
+    processSensors();
+    BOOST_REQUIRE_EQUAL(received.motions.size(), 1u);
+    // 5 packets of 10 ms each; z flipped to point out of the screen.
+    BOOST_CHECK_CLOSE(received.motions[0][0], 5.0f, 0.01);
+    BOOST_CHECK_CLOSE(received.motions[0][2], 2.5f, 0.01);
+
+    processSensors();
+    BOOST_CHECK_EQUAL(received.motions.size(), 1u);
+
+    device.disable(nullptr, handler, &received);
+    BOOST_CHECK(!device.isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(buttonsFollowPendingMotion) {
+    FakeSpacenavd server;
+    SoFlSpacenavDevice device(server.path.c_str());
+    Received received;
+    received.device = &device;
+
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(server.accept());
+
+    server.send(0, 10, 10, 10, 0, 0, 0, 16);
+    server.send(1, 0);
+    server.send(2, 0);
+    server.send(1, 3);
+    device.processInput();
+    processSensors();
+
+    BOOST_REQUIRE_EQUAL(received.order.size(), 4u);
+    BOOST_CHECK_EQUAL(received.order[0], 'm');
+    BOOST_REQUIRE_EQUAL(received.buttons.size(), 3u);
+    BOOST_CHECK_EQUAL(received.buttons[0], 1);
+    BOOST_CHECK_EQUAL(received.buttons[1], -1);
+    BOOST_CHECK_EQUAL(received.buttons[2], 4);
+}
+
+BOOST_AUTO_TEST_CASE(packetsSplitAcrossReads) {
+    FakeSpacenavd server;
+    SoFlSpacenavDevice device(server.path.c_str());
+    Received received;
+    received.device = &device;
+
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(server.accept());
+
+    const int32_t packet[8] = {1, 2, 0, 0, 0, 0, 0, 0};
+    const char * bytes = reinterpret_cast<const char *>(packet);
+    server.sendBytes(bytes, 5);
+    device.processInput();
+    BOOST_CHECK(received.buttons.empty());
+
+    server.sendBytes(bytes + 5, sizeof(packet) - 5);
+    device.processInput();
+    BOOST_REQUIRE_EQUAL(received.buttons.size(), 1u);
+    BOOST_CHECK_EQUAL(received.buttons[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(daemonGoingAway) {
+    FakeSpacenavd server;
+    SoFlSpacenavDevice device(server.path.c_str());
+    Received received;
+    received.device = &device;
+
+    device.enable(nullptr, handler, &received);
+    BOOST_REQUIRE(server.accept());
+    server.send(0, 10, 0, 0, 0, 0, 0, 16);
+    server.hangup();
+
+    BOOST_CHECK(!device.processInput());
+    BOOST_CHECK(!device.isConnected());
+    // Motion not delivered yet is dropped with the connection.
+    processSensors();
+    BOOST_CHECK(received.motions.empty());
+}
+
+BOOST_AUTO_TEST_CASE(noDaemon) {
+    SoFlSpacenavDevice device("/nonexistent/spnav.sock");
+    BOOST_CHECK(!device.connect());
+    BOOST_CHECK(!device.isConnected());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,88 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include "Inventor/Fl/viewers/SoFlAnimationClock.h"
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoTranslation.h>
+
+BOOST_AUTO_TEST_SUITE(TestSoFlAnimationClock)
+
+BOOST_AUTO_TEST_CASE(test_seek_target) {
+    auto root = new SoSeparator;
+    root->ref();
+    auto move = new SoTranslation;
+    move->translation.setValue(5.0f, 0.0f, 0.0f);
+    auto cube = new SoCube;
+    root->addChild(move);
+    root->addChild(cube);
+    auto path = new SoPath(root);
+    path->ref();
+    path->append(cube);
+
+    const SbViewportRegion viewport(100, 100);
+    const SbVec3f hit(4.0f, 0.5f, 1.0f);
+
+    // A detail seek goes where the click hit the cube.
+    SbVec3f target = SoFlAnimationClock::seekTarget(hit, path, true, viewport);
+    BOOST_CHECK(target.equals(hit, 1e-5f));
+
+    // Otherwise it goes to the cube's centre.
+    target = SoFlAnimationClock::seekTarget(hit, path, false, viewport);
+    BOOST_CHECK(target.equals(SbVec3f(5.0f, 0.0f, 0.0f), 1e-5f));
+
+    BOOST_CHECK(SoFlAnimationClock::seekTarget(hit, nullptr, false, viewport).equals(hit, 1e-5f));
+
+    path->unref();
+    root->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_missed_ticks_are_skipped) {
+    const double period = 0.01;
+
+    // On time: the next tick is one period on.
+    BOOST_CHECK_CLOSE(SoFlAnimationClock::nextTick(1.0, 1.005, period), 1.01, 1e-6);
+
+    // A frame that took 35 ms skips the ticks it ran over, rather than
+    // having them run back to back.
+    const double next = SoFlAnimationClock::nextTick(1.0, 1.035, period);
+    BOOST_CHECK_CLOSE(next, 1.04, 1e-6);
+    BOOST_CHECK_GT(next, 1.035);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include "Inventor/Fl/viewers/SoFlBoundingBoxCache.h"
+
+#include <Inventor/SbBox3f.h>
+
+namespace
+{
+    // A scene from 1 to 100 units in front of the camera.
+    const SbBox3f EYEBOX(-1.0f, -1.0f, -100.0f, 1.0f, 1.0f, -1.0f);
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlBoundingBoxCache)
+
+BOOST_AUTO_TEST_CASE(test_variable_near_plane) {
+    SbVec2f nearfar;
+    BOOST_REQUIRE(SoFlBoundingBoxCache::clippingPlanes(EYEBOX, true, 24,
+                                                       SoFlGLArea::CLIPPING_VARIABLE_NEAR_PLANE,
+                                                       0.6f, nearfar));
+    // 24 * 0.4 bits give a near limit of 100 / 512, well inside.
+    BOOST_CHECK_CLOSE(nearfar[0], 1.0f, 0.2f);
+    BOOST_CHECK_CLOSE(nearfar[1], 100.0f, 0.2f);
+    BOOST_CHECK_LT(nearfar[0], 1.0f);
+    BOOST_CHECK_GT(nearfar[1], 100.0f);
+
+    // Fewer depth bits to spare push the near plane out.
+    BOOST_REQUIRE(SoFlBoundingBoxCache::clippingPlanes(EYEBOX, true, 8,
+                                                       SoFlGLArea::CLIPPING_VARIABLE_NEAR_PLANE,
+                                                       0.75f, nearfar));
+    BOOST_CHECK_CLOSE(nearfar[0], 25.0f, 0.2f);
+}
+
+BOOST_AUTO_TEST_CASE(test_constant_near_plane) {
+    SbVec2f nearfar;
+    BOOST_REQUIRE(SoFlBoundingBoxCache::clippingPlanes(EYEBOX, true, 24,
+                                                       SoFlGLArea::CLIPPING_CONSTANT_NEAR_PLANE,
+                                                       5.0f, nearfar));
+    BOOST_CHECK_CLOSE(nearfar[0], 5.0f, 0.2f);
+
+    // A limit beyond the far plane is not taken literally.
+    BOOST_REQUIRE(SoFlBoundingBoxCache::clippingPlanes(EYEBOX, true, 24,
+                                                       SoFlGLArea::CLIPPING_CONSTANT_NEAR_PLANE,
+                                                       500.0f, nearfar));
+    BOOST_CHECK_CLOSE(nearfar[0], 1.0f, 0.2f);
+}
+
+BOOST_AUTO_TEST_CASE(test_orthographic_and_behind) {
+    SbVec2f nearfar;
+    // No near limit for orthographic cameras, whatever the strategy.
+    BOOST_REQUIRE(SoFlBoundingBoxCache::clippingPlanes(EYEBOX, false, 24,
+                                                       SoFlGLArea::CLIPPING_CONSTANT_NEAR_PLANE,
+                                                       5.0f, nearfar));
+    BOOST_CHECK_CLOSE(nearfar[0], 1.0f, 0.2f);
+
+    const SbBox3f behind(-1.0f, -1.0f, 1.0f, 1.0f, 1.0f, 10.0f);
+    BOOST_CHECK(!SoFlBoundingBoxCache::clippingPlanes(behind, true, 24,
+                                                      SoFlGLArea::CLIPPING_VARIABLE_NEAR_PLANE,
+                                                      0.6f, nearfar));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFl.h>
+#include <Inventor/Fl/SoFlRenderArea.h>
+#include <Inventor/Fl/widgets/SoFlGLArea.h>
+#include <Inventor/SoPath.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoOrthographicCamera.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoTranslation.h>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Window.H>
+
+BOOST_AUTO_TEST_SUITE(TestSoFlGLPicker)
+
+BOOST_AUTO_TEST_CASE(test_pick_through_own_camera) {
+    // Two 2x2x2 cubes, each under a camera of its own looking down -z:
+    // one at the origin seeing x from -5 to 5, one at x=7 seeing x from
+    // -10 to 10.
+    auto root = new SoSeparator;
+    root->ref();
+    auto near = new SoCube;
+    auto far = new SoCube;
+    auto nearview = new SoSeparator;
+    auto farview = new SoSeparator;
+    auto camera = new SoOrthographicCamera;
+    camera->position.setValue(0.0f, 0.0f, 10.0f);
+    camera->height.setValue(10.0f);
+    nearview->addChild(camera);
+    nearview->addChild(near);
+    camera = new SoOrthographicCamera;
+    camera->position.setValue(0.0f, 0.0f, 10.0f);
+    camera->height.setValue(20.0f);
+    auto move = new SoTranslation;
+    move->translation.setValue(7.0f, 0.0f, 0.0f);
+    farview->addChild(camera);
+    farview->addChild(move);
+    farview->addChild(far);
+    root->addChild(nearview);
+    root->addChild(farview);
+
+    auto window = new Fl_Window(100, 100);
+    auto area = new SoFlRenderArea(window);
+    area->setSceneGraph(root);
+    window->end();
+    window->show();
+    area->show();
+    for (int i = 0; i < 10; i++) Fl::wait(0.05);
+
+    auto glarea = static_cast<SoFlGLArea *>(area->getGLWidget());
+    SbVec3f point;
+    if (!glarea || !glarea->setIDBufferPicking(true) || !glarea->pick(SbVec2s(50, 50), &point)) {
+        BOOST_TEST_MESSAGE("no ID buffer picking available, skipped");
+    }
+    else {
+        BOOST_CHECK(point.equals(SbVec3f(0.0f, 0.0f, 1.0f), 0.2f));
+
+        // Unprojected through the second camera, not the first.
+        SoPath * path = glarea->pick(SbVec2s(85, 50), &point);
+        BOOST_REQUIRE(path != nullptr);
+        BOOST_CHECK_EQUAL(path->getHead(), root);
+        BOOST_CHECK_EQUAL(path->getTail(), far);
+        BOOST_CHECK(point.equals(SbVec3f(7.1f, 0.0f, 1.0f), 0.2f));
+
+        // Built once, and kept while the view is unchanged.
+        BOOST_CHECK(glarea->pick(SbVec2s(85, 50), nullptr) == path);
+        BOOST_CHECK(glarea->pick(SbVec2s(15, 50), nullptr) == nullptr);
+    }
+
+    delete area;
+    delete window;
+    root->unref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
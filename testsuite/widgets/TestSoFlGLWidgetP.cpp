@@ -37,8 +37,13 @@
 
 #include "Inventor/Fl/SoFlGLWidgetP.h"
 #include "Inventor/Fl/SoFlGLWidget.h"
+#include "Inventor/Fl/SoFlGLAccumulator.h"
 #include <FL/Enumerations.H>
 
+#include <chrono>
+#include <set>
+#include <utility>
+
 
 BOOST_AUTO_TEST_SUITE(TestSoFlGLWidgetP)
 
@@ -70,4 +75,60 @@ BOOST_AUTO_TEST_CASE(test_initGLModes_conversion) {
     delete private_impl;
 }
 
+BOOST_AUTO_TEST_CASE(test_initGLModes_multisample) {
+    auto private_impl = new SoFlGLWidgetP (nullptr);
+
+    private_impl->initGLModes(static_cast<GLModes>(SO_GL_RGB | SO_GL_DOUBLE));
+    BOOST_CHECK(!(private_impl->gl_attributes & FL_MULTISAMPLE));
+
+    // A single sample is no multisampling.
+    private_impl->numsamples = 1;
+    private_impl->initGLModes(static_cast<GLModes>(SO_GL_RGB | SO_GL_DOUBLE));
+    BOOST_CHECK(!(private_impl->gl_attributes & FL_MULTISAMPLE));
+
+    private_impl->numsamples = 8;
+    private_impl->initGLModes(static_cast<GLModes>(SO_GL_RGB | SO_GL_DOUBLE));
+    BOOST_CHECK(private_impl->gl_attributes & FL_MULTISAMPLE);
+    BOOST_CHECK(private_impl->gl_attributes & FL_DOUBLE);
+
+    delete private_impl;
+}
+
+BOOST_AUTO_TEST_CASE(test_paceFrame_limits_frame_rate) {
+    auto private_impl = new SoFlGLWidgetP (nullptr);
+    typedef std::chrono::steady_clock clock;
+
+    // Disabled limiter never waits.
+    clock::time_point start = clock::now();
+    for (int i = 0; i < 10; ++i) private_impl->paceFrame();
+    BOOST_CHECK(clock::now() - start < std::chrono::milliseconds(5));
+
+    // 50 fps: the first frame starts the schedule, the next two wait
+    // one 20 ms period each.
+    private_impl->maxframerate = 50.0f;
+    start = clock::now();
+    for (int i = 0; i < 3; ++i) private_impl->paceFrame();
+    BOOST_CHECK(clock::now() - start >= std::chrono::milliseconds(38));
+
+    delete private_impl;
+}
+
+BOOST_AUTO_TEST_CASE(test_accumulator_jitter) {
+    float dx, dy;
+
+    // First pass is the unjittered frame.
+    SoFlGLAccumulator::jitter(0, dx, dy);
+    BOOST_CHECK_EQUAL(dx, 0.0f);
+    BOOST_CHECK_EQUAL(dy, 0.0f);
+
+    // Following passes stay within the pixel and never repeat.
+    std::set<std::pair<float, float>> seen;
+    for (int pass = 1; pass < 16; ++pass) {
+        SoFlGLAccumulator::jitter(pass, dx, dy);
+        BOOST_CHECK(dx >= -0.5f && dx < 0.5f);
+        BOOST_CHECK(dy >= -0.5f && dy < 0.5f);
+        BOOST_CHECK(seen.insert(std::make_pair(dx, dy)).second);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFl.h>
+#include <Inventor/Fl/SoFlGraphEditorIndex.h>
+#include <Inventor/Fl/SoFlGraphEditorModel.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoSphere.h>
+
+namespace
+{
+    // root -> 'count' separators named "part<i>", each with a cube of
+    // width i and one sphere shared by all of them.
+    SoSeparator * buildGraph(int count)
+    {
+        auto root = new SoSeparator;
+        auto sphere = new SoSphere;
+        for (int i = 0; i < count; i++) {
+            auto part = new SoSeparator;
+            SbString name;
+            name.sprintf("part%d", i);
+            part->setName(name.getString());
+            auto cube = new SoCube;
+            cube->width = static_cast<float>(i);
+            part->addChild(cube);
+            part->addChild(sphere);
+            root->addChild(part);
+        }
+        return root;
+    }
+
+    int count(SoFlGraphEditorIndex & index, const char * text)
+    {
+        std::vector<SoNode *> found;
+        return index.find(SoFlGraphEditorIndex::Query::parse(text), found, 1000000);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlGraphEditorIndex)
+
+BOOST_AUTO_TEST_CASE(test_queries) {
+    SoFlGraphEditorIndex index;
+    index.setRoot(buildGraph(20));
+    BOOST_CHECK(!index.isBuilt());
+
+    BOOST_CHECK_EQUAL(count(index, "Cube"), 20);
+    BOOST_CHECK(index.isBuilt());
+    // Root, parts, cubes and the shared sphere once.
+    BOOST_CHECK_EQUAL(index.getNumNodes(), 1 + 20 + 20 + 1);
+
+    BOOST_CHECK_EQUAL(count(index, "SoCube"), 20);
+    BOOST_CHECK_EQUAL(count(index, "Shape"), 21);
+    BOOST_CHECK_EQUAL(count(index, "part1"), 11);
+    BOOST_CHECK_EQUAL(count(index, "part15"), 1);
+    BOOST_CHECK_EQUAL(count(index, "nothing"), 0);
+    BOOST_CHECK_EQUAL(count(index, "Cube width=3"), 1);
+    BOOST_CHECK_EQUAL(count(index, "Separator renderCaching=AUTO"), 21);
+}
+
+BOOST_AUTO_TEST_CASE(test_follows_graph_changes) {
+    SoFlGraphEditorIndex index;
+    auto root = buildGraph(4);
+    index.setRoot(root);
+    BOOST_CHECK_EQUAL(count(index, "Sphere"), 1);
+
+    root->removeChild(0);
+    BOOST_CHECK_EQUAL(count(index, "Cube"), 3);
+    BOOST_CHECK_EQUAL(count(index, "Sphere"), 1);
+    BOOST_CHECK_EQUAL(count(index, "part0"), 0);
+
+    auto group = new SoGroup;
+    group->setName("added");
+    group->addChild(new SoCube);
+    root->insertChild(group, 1);
+    BOOST_CHECK_EQUAL(count(index, "Cube"), 4);
+    BOOST_CHECK_EQUAL(count(index, "added"), 1);
+
+    root->removeAllChildren();
+    BOOST_CHECK_EQUAL(index.getNumNodes(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_path_expands_tree) {
+    SoFlGraphEditorIndex index;
+    SoFlGraphEditorModel model;
+    auto root = buildGraph(3);
+    index.setRoot(root);
+    model.setRoot(root);
+
+    std::vector<SoNode *> found;
+    index.find(SoFlGraphEditorIndex::Query::parse("Cube width=2"), found, 10);
+    BOOST_REQUIRE_EQUAL(found.size(), 1u);
+
+    const std::vector<SoNode *> path = index.getPath(found[0]);
+    BOOST_REQUIRE_EQUAL(path.size(), 3u);
+    BOOST_CHECK_EQUAL(path.front(), root);
+
+    const int item = model.expandPath(path);
+    BOOST_REQUIRE_GE(item, 0);
+    BOOST_CHECK_EQUAL(model.getItem(item).node, found[0]);
+    BOOST_CHECK_GE(model.getRowOfItem(item), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,191 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFl.h>
+#include <Inventor/Fl/SoFlGraphEditorModel.h>
+#include <Inventor/nodes/SoCube.h>
+#include <Inventor/nodes/SoGroup.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // A root with 'count' groups, each holding the same shared cube.
+    SoSeparator * buildSharedGraph(int count)
+    {
+        auto root = new SoSeparator;
+        auto cube = new SoCube;
+        for (int i = 0; i < count; i++) {
+            auto group = new SoGroup;
+            group->addChild(cube);
+            root->addChild(group);
+        }
+        return root;
+    }
+
+    int findRow(const SoFlGraphEditorModel & model, SoFlGraphEditorModel::Kind kind)
+    {
+        for (int row = 0; row < model.getNumRows(); row++)
+            if (model.getItem(model.getItemAtRow(row)).kind == kind)
+                return row;
+        return -1;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(TestSoFlGraphEditorModel)
+
+BOOST_AUTO_TEST_CASE(test_root_is_lazy) {
+    SoFlGraphEditorModel model;
+    model.setRoot(buildSharedGraph(1000));
+
+    BOOST_CHECK_EQUAL(model.getNumItems(), 1);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 1);
+    BOOST_CHECK(model.isExpandable(0));
+
+    model.expand(0);
+    // The root's [fields] group plus its direct children, nothing deeper.
+    BOOST_CHECK_EQUAL(model.getNumItems(), 1 + 1 + 1000);
+    BOOST_CHECK_EQUAL(model.getNumRows(), model.getNumItems());
+}
+
+BOOST_AUTO_TEST_CASE(test_collapse_restores_rows) {
+    SoFlGraphEditorModel model;
+    model.setRoot(buildSharedGraph(3));
+    model.expand(0);
+    const int rows = model.getNumRows();
+
+    const int group = model.getItemAtRow(2);
+    model.expand(group);
+    BOOST_CHECK_GT(model.getNumRows(), rows);
+    BOOST_CHECK_EQUAL(model.getRowOfItem(group), 2);
+
+    model.collapse(0);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 1);
+
+    // Expansion state below a collapsed item is kept.
+    model.expand(0);
+    BOOST_CHECK_GT(model.getNumRows(), rows);
+    BOOST_CHECK(model.getItem(group).expanded);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_nodes_listed_once) {
+    SoFlGraphEditorModel model;
+    model.setRoot(buildSharedGraph(3));
+    model.expand(0);
+    for (int row = model.getNumRows() - 1; row >= 2; row--)
+        model.expand(model.getItemAtRow(row));
+
+    BOOST_REQUIRE_GE(findRow(model, SoFlGraphEditorModel::REFERENCE), 0);
+    int nodes = 0, references = 0;
+    for (int row = 0; row < model.getNumRows(); row++) {
+        const SoFlGraphEditorModel::Item & item = model.getItem(model.getItemAtRow(row));
+        if (!item.node->isOfType(SoCube::getClassTypeId())) continue;
+        if (item.kind == SoFlGraphEditorModel::NODE) nodes++;
+        if (item.kind == SoFlGraphEditorModel::REFERENCE) {
+            references++;
+            BOOST_CHECK(!model.isExpandable(model.getItemAtRow(row)));
+            BOOST_CHECK_EQUAL(model.getItem(item.original).node, item.node);
+        }
+    }
+    BOOST_CHECK_EQUAL(nodes, 1);
+    BOOST_CHECK_EQUAL(references, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_child_changes_are_patched) {
+    SoFlGraphEditorModel model;
+    auto root = buildSharedGraph(3);
+    model.setRoot(root);
+    model.expand(0);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 5);
+
+    auto cube = new SoCube;
+    cube->ref();
+    root->insertChild(cube, 1);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 6);
+    BOOST_CHECK_EQUAL(model.getItem(model.getItemAtRow(3)).node, cube);
+
+    root->removeChild(0);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 5);
+    BOOST_CHECK_EQUAL(model.getItem(model.getItemAtRow(2)).node, cube);
+
+    root->replaceChild(0, new SoGroup);
+    BOOST_CHECK_EQUAL(model.findItem(cube), -1);
+
+    root->removeAllChildren();
+    BOOST_CHECK_EQUAL(model.getNumRows(), 2);
+    cube->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_expand_with_stale_rows) {
+    SoFlGraphEditorModel model;
+    auto root = buildSharedGraph(2);
+    model.setRoot(root);
+    model.expand(0);
+    const int group = model.getItemAtRow(2);
+
+    // Leaves the rows to be rebuilt, and expanding must not add the
+    // group's children on top of the rebuilt ones.
+    root->addChild(new SoGroup);
+    model.expand(group);
+    BOOST_CHECK_EQUAL(model.getNumRows(), 6);
+    std::vector<int> rows;
+    for (int row = 0; row < model.getNumRows(); row++)
+        rows.push_back(model.getItemAtRow(row));
+    std::sort(rows.begin(), rows.end());
+    BOOST_CHECK(std::adjacent_find(rows.begin(), rows.end()) == rows.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_node_survives_owner_removal) {
+    SoFlGraphEditorModel model;
+    auto root = buildSharedGraph(2);
+    model.setRoot(root);
+    model.expand(0);
+    model.expand(model.getItemAtRow(2));
+    model.expand(model.getItemAtRow(4));
+
+    SoNode * cube = static_cast<SoGroup *>(root->getChild(0))->getChild(0);
+    const int owner = model.findItem(cube);
+    BOOST_REQUIRE_GE(owner, 0);
+
+    root->removeChild(0);
+    const int heir = model.findItem(cube);
+    BOOST_REQUIRE_GE(heir, 0);
+    BOOST_CHECK(heir != owner);
+    BOOST_CHECK(model.getItem(heir).kind == SoFlGraphEditorModel::NODE);
+    BOOST_CHECK(model.isExpandable(heir));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/**************************************************************************\
+* BSD 3-Clause License
+ *
+ * Copyright (c) 2025, Fabrizio Morciano
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+\**************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <Inventor/Fl/SoFl.h>
+#include <Inventor/Fl/widgets/SoFlMaterialPreviewCache.h>
+#include <Inventor/nodes/SoMaterial.h>
+
+BOOST_AUTO_TEST_SUITE(TestSoFlMaterialPreviewCache)
+
+BOOST_AUTO_TEST_CASE(test_hash_follows_values) {
+    auto a = new SoMaterial;
+    auto b = new SoMaterial;
+    a->ref();
+    b->ref();
+
+    BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::hash(a), SoFlMaterialPreviewCache::hash(b));
+
+    b->setName("named");
+    BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::hash(a), SoFlMaterialPreviewCache::hash(b));
+
+    b->diffuseColor.setValue(1.0f, 0.0f, 0.0f);
+    BOOST_CHECK_NE(SoFlMaterialPreviewCache::hash(a), SoFlMaterialPreviewCache::hash(b));
+
+    a->diffuseColor.setValue(1.0f, 0.0f, 0.0f);
+    BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::hash(a), SoFlMaterialPreviewCache::hash(b));
+
+    a->transparency.setValue(0.5f);
+    BOOST_CHECK_NE(SoFlMaterialPreviewCache::hash(a), SoFlMaterialPreviewCache::hash(b));
+
+    a->unref();
+    b->unref();
+}
+
+BOOST_AUTO_TEST_CASE(test_previews_rendered_once) {
+    SoFlMaterialPreviewCache::clear();
+    auto a = new SoMaterial;
+    auto b = new SoMaterial;
+    a->ref();
+    b->ref();
+
+    const int renders = SoFlMaterialPreviewCache::getNumRenders();
+    if (!SoFlMaterialPreviewCache::get(a, 32)) {
+        BOOST_TEST_MESSAGE("no offscreen rendering available, skipped");
+    }
+    else {
+        BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::getNumRenders(), renders + 1);
+        // Same values, same image.
+        BOOST_CHECK(SoFlMaterialPreviewCache::get(b, 32) == SoFlMaterialPreviewCache::get(a, 32));
+        BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::getNumRenders(), renders + 1);
+
+        b->shininess.setValue(0.9f);
+        SoFlMaterialPreviewCache::get(b, 32);
+        BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::getNumRenders(), renders + 2);
+        BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::getNumEntries(), 2);
+
+        SoFlMaterialPreviewCache::setMaxEntries(1);
+        BOOST_CHECK_EQUAL(SoFlMaterialPreviewCache::getNumEntries(), 1);
+        SoFlMaterialPreviewCache::setMaxEntries(256);
+    }
+
+    SoFlMaterialPreviewCache::clear();
+    a->unref();
+    b->unref();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -39,6 +39,7 @@
 #include <Inventor/Fl/widgets/SoFlThumbWheel.h>
 #undef protected
 #undef private
+#include <Inventor/Fl/widgets/SoFlThumbWheelCache.h>
 #include <FL/Fl_Window.H>
 
 namespace
@@ -128,10 +129,9 @@ BOOST_AUTO_TEST_CASE(test_wheels_getPosition_vertical)
     auto window = new Fl_Window(THUMBWHEEL_WIDTH, THUMBWHEEL_HEIGHT, "test_wheels_size");
     auto wheel = new SoFlThumbWheel(SoFlThumbWheel::Vertical, SbVec2s(10,10));
     wheel->initWheel(THUMBWHEEL_PIXMAP_WIDTH,THUMBWHEEL_PIXMAP_HEIGHT);
-    BOOST_CHECK(wheel->numPixmaps > 0);
-    BOOST_CHECK(wheel->pixmaps != nullptr);
-    BOOST_CHECK(wheel->fl_images != nullptr);
-    auto rgb_image = wheel->fl_images[0];
+    BOOST_CHECK(wheel->frames != nullptr);
+    BOOST_CHECK(wheel->frames->count() > 0);
+    auto rgb_image = wheel->frames->get(0, wheel->wheel);
     BOOST_CHECK(rgb_image != nullptr);
     auto position = wheel->getPosition(rgb_image);
     BOOST_TEST_MESSAGE("wheel->getPosition: " << position[0]<<','<<position[1]);
@@ -145,11 +145,10 @@ BOOST_AUTO_TEST_CASE(test_wheels_getPosition_horizontal)
     auto window = new Fl_Window(THUMBWHEEL_WIDTH, THUMBWHEEL_HEIGHT, "test_wheels_size");
     auto wheel = new SoFlThumbWheel(SoFlThumbWheel::Horizontal, SbVec2s(10,10));
     wheel->initWheel(THUMBWHEEL_PIXMAP_WIDTH,THUMBWHEEL_PIXMAP_HEIGHT);
-    BOOST_CHECK(wheel->numPixmaps > 0);
-    BOOST_CHECK(wheel->pixmaps != nullptr);
-    BOOST_CHECK(wheel->fl_images != nullptr);
+    BOOST_CHECK(wheel->frames != nullptr);
+    BOOST_CHECK(wheel->frames->count() > 0);
     int a_pixmap = 0;
-    auto rgb_image = wheel->fl_images[0];
+    auto rgb_image = wheel->frames->get(a_pixmap, wheel->wheel);
     BOOST_CHECK(rgb_image != nullptr);
     auto position = wheel->getPosition(rgb_image);
     BOOST_TEST_MESSAGE("wheel->getPosition: " << position[0]<<','<<position[1]);
@@ -158,6 +157,34 @@ BOOST_AUTO_TEST_CASE(test_wheels_getPosition_horizontal)
     delete window;
 }
 
-
+BOOST_AUTO_TEST_CASE(test_wheels_share_frames)
+{
+    auto window = new Fl_Window(THUMBWHEEL_WIDTH, THUMBWHEEL_HEIGHT, "test_wheels_share_frames");
+    const int entries = SoFlThumbWheelCache::getNumEntries();
+    auto first = new SoFlThumbWheel(SoFlThumbWheel::Vertical, SbVec2s(10,10));
+    auto second = new SoFlThumbWheel(SoFlThumbWheel::Vertical, SbVec2s(10,10));
+    auto other = new SoFlThumbWheel(SoFlThumbWheel::Horizontal, SbVec2s(10,10));
+    first->initWheel(THUMBWHEEL_PIXMAP_WIDTH,THUMBWHEEL_PIXMAP_HEIGHT);
+    second->initWheel(THUMBWHEEL_PIXMAP_WIDTH,THUMBWHEEL_PIXMAP_HEIGHT);
+    other->initWheel(THUMBWHEEL_PIXMAP_WIDTH,THUMBWHEEL_PIXMAP_HEIGHT);
+
+    // Same geometry shares, another orientation does not.
+    BOOST_CHECK(first->frames == second->frames);
+    BOOST_CHECK(first->frames != other->frames);
+    BOOST_CHECK_EQUAL(SoFlThumbWheelCache::getNumEntries(), entries + 2);
+
+    // Frames are only rendered on demand.
+    BOOST_CHECK(!first->frames->isGenerated(1));
+    BOOST_CHECK(first->frames->get(1, first->wheel) != nullptr);
+    BOOST_CHECK(second->frames->isGenerated(1));
+    BOOST_CHECK(!second->frames->isGenerated(0));
+
+    delete first;
+    BOOST_CHECK_EQUAL(SoFlThumbWheelCache::getNumEntries(), entries + 2);
+    delete second;
+    delete other;
+    BOOST_CHECK_EQUAL(SoFlThumbWheelCache::getNumEntries(), entries);
+    delete window;
+}
 
 BOOST_AUTO_TEST_SUITE_END()